@@ -3,6 +3,8 @@
 #include "exception.hpp"
 #include "vector.hpp"
 
+#include <utilities/swizzle.hpp>
+
 #include <compare>
 #include <stdint.h>
 
@@ -138,21 +140,9 @@ struct Color
   private:
     static unsigned indexOfTile(const unsigned width, const unsigned x, const unsigned y)
     {
-        const love::Vector2 tile(x / 8, y / 8);
-        const love::Vector2 sub(x % 8, y % 8);
-
-        if ((sub.y * 8 + sub.x) > coordsTable.size())
-            throw love::Exception("Out of bounds tile position: %dx%d", sub.x, sub.y);
-
-        return ((width / 8) * tile.y + tile.x) * 64 + coordsTable[sub.y * 8 + sub.x];
+        return love::Swizzle::TileIndex(width, x, y);
     }
 
-    static const inline std::array<unsigned, 0x40> coordsTable = {
-        0,  1,  4,  5,  16, 17, 20, 21, 2,  3,  6,  7,  18, 19, 22, 23, 8,  9,  12, 13, 24, 25,
-        28, 29, 10, 11, 14, 15, 26, 27, 30, 31, 32, 33, 36, 37, 48, 49, 52, 53, 34, 35, 38, 39,
-        50, 51, 54, 55, 40, 41, 44, 45, 56, 57, 60, 61, 42, 43, 46, 47, 58, 59, 62, 63,
-    };
-
     /* https://github.com/devkitPro/citro2d/blob/master/include/c2d/base.h#L86*/
     static uint8_t to_uint8_t(const float& in)
     {
@@ -17,10 +17,14 @@ extern "C"
     extern int luaopen_bit(lua_State*);
 }
 
+#include <algorithm>
+#include <array>
 #include <numeric>
 #include <ranges>
 #include <set>
 #include <span>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace love
@@ -64,6 +68,9 @@ namespace luax
 {
     /* ----- main stuff ----- */
 
+    /* like luaL_newstate, but counts the heap under MemoryStats::CATEGORY_LUA */
+    lua_State* NewState();
+
     int Preload(lua_State* L, lua_CFunction function, const char* name);
 
     int Require(lua_State* L, const char* name);
@@ -171,7 +178,8 @@ namespace luax
         love::Proxy* proxy = (love::Proxy*)lua_touserdata(L, index);
 
         // Check that it has a type and matches input
-        if (proxy->type == nullptr || !proxy->type->IsA(type))
+        // exact matches are the common case, so avoid the bitset test for those
+        if (proxy->type == nullptr || (proxy->type != &type && !proxy->type->IsA(type)))
         {
             const char* name = type.GetName();
             luax::TypeError(L, index, name);
@@ -289,6 +297,70 @@ namespace luax
         return std::string(string, length);
     }
 
+    /* ----- argument decoding ----- */
+
+    template<typename T>
+    inline T CheckArgument(lua_State* L, int index)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return luax::CheckBoolean(L, index);
+        else if constexpr (std::is_integral_v<T>)
+            return static_cast<T>(luaL_checkinteger(L, index));
+        else if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(luaL_checknumber(L, index));
+        else if constexpr (std::is_same_v<T, const char*>)
+            return luaL_checkstring(L, index);
+        else
+            static_assert(sizeof(T) == 0, "Unsupported argument type.");
+    }
+
+    /*
+    ** Decodes consecutive arguments starting at @start into a tuple.
+    ** The reads are expanded at compile time and evaluated left-to-right,
+    ** so errors still point at the first bad argument. This makes the same
+    ** checks as reading each argument by hand; it saves typing, not time.
+    */
+    template<typename... T>
+    inline std::tuple<T...> CheckArguments(lua_State* L, int start)
+    {
+        return [&]<int... I>(std::integer_sequence<int, I...>) {
+            return std::tuple<T...> { luax::CheckArgument<T>(L, start + I)... };
+        }(std::make_integer_sequence<int, sizeof...(T)> {});
+    }
+
+    /*
+    ** Reads up to N optional numbers starting at @start into @values, which
+    ** hold the defaults on entry. The stack top is only checked once, so
+    ** trailing arguments that were never passed are not touched.
+    ** Returns how many stack slots were inspected.
+    */
+    template<size_t N>
+    inline int OptNumbers(lua_State* L, int start, std::array<float, N>& values)
+    {
+        const int count = std::clamp<int>(lua_gettop(L) - start + 1, 0, N);
+
+        for (int index = 0; index < count; index++)
+            values[index] = luaL_optnumber(L, start + index, values[index]);
+
+        return count;
+    }
+
+    /*
+    ** Reads the optional x, y, angle, sx, sy, ox, oy, kx and ky arguments of a transform
+    ** starting at @start, where sy defaults to sx. Calls that only pass a position (most
+    ** draws) skip the other seven.
+    */
+    inline std::array<float, 9> OptTransform(lua_State* L, int start)
+    {
+        std::array<float, 9> args { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        const int count = luax::OptNumbers(L, start, args);
+
+        if (count < 5 || lua_isnil(L, start + 4))
+            args[4] = args[3];
+
+        return args;
+    }
+
     void GetTypeMetaTable(lua_State* L, const love::Type& type);
 
     void WrapObject(lua_State* L, const char* filedata, size_t length, const char* filename,
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <utilities/bidirectionalmap/bidirectionalmap.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** Running tally of the bytes held by each kind of resource, along with the most each one
+** has ever held at once. Counters are atomic: audio buffers and Lua states on other threads
+** report into the same tallies as the graphics module.
+*/
+namespace love::MemoryStats
+{
+    enum Category
+    {
+        CATEGORY_TEXTURE,
+        CATEGORY_RENDER_TARGET,
+        CATEGORY_FONT,
+        CATEGORY_VERTEX,
+        CATEGORY_STAGING,
+        CATEGORY_AUDIO,
+        CATEGORY_LUA,
+        CATEGORY_MAX_ENUM
+    };
+
+    struct Usage
+    {
+        int64_t current;
+        int64_t peak;
+    };
+
+    // clang-format off
+    static constexpr BidirectionalMap categories = {
+        "textures",      CATEGORY_TEXTURE,
+        "rendertargets", CATEGORY_RENDER_TARGET,
+        "fonts",         CATEGORY_FONT,
+        "vertices",      CATEGORY_VERTEX,
+        "staging",       CATEGORY_STAGING,
+        "audio",         CATEGORY_AUDIO,
+        "lua",           CATEGORY_LUA
+    };
+    // clang-format on
+
+    inline std::atomic<int64_t> current[CATEGORY_MAX_ENUM] {};
+    inline std::atomic<int64_t> peak[CATEGORY_MAX_ENUM] {};
+
+    inline void Add(Category category, int64_t bytes)
+    {
+        const int64_t total = current[category].fetch_add(bytes) + bytes;
+        int64_t highest     = peak[category].load();
+
+        while (total > highest && !peak[category].compare_exchange_weak(highest, total))
+            ;
+    }
+
+    inline void Remove(Category category, int64_t bytes)
+    {
+        current[category].fetch_sub(bytes);
+    }
+
+    inline Usage Get(Category category)
+    {
+        return Usage { current[category].load(), peak[category].load() };
+    }
+
+    /* restarts the high-water marks from what is held right now */
+    inline void ResetPeaks()
+    {
+        for (int category = 0; category < CATEGORY_MAX_ENUM; category++)
+            peak[category].store(current[category].load());
+    }
+} // namespace love::MemoryStats
@@ -11,14 +11,22 @@ namespace love
     class Message : public Object
     {
       public:
-        Message(const std::string& name, const std::vector<Variant>& args = {}) :
+        Message(const std::string& name, std::vector<Variant> args = {}) :
             name(name),
-            args(args)
+            args(std::move(args))
         {}
 
         ~Message()
         {}
 
+        /*
+        ** Input events create a Message every frame, so released messages
+        ** are kept on a small free list instead of going back to the heap.
+        */
+        static void* operator new(size_t size);
+
+        static void operator delete(void* memory);
+
         const std::string name;
         const std::vector<Variant> args;
     };
@@ -25,6 +25,7 @@ namespace love
             M_KEYBOARD,
             M_MATH,
             M_PHYSICS,
+            M_PROFILER,
             M_SYSTEM,
             M_SENSOR,
             M_SOUND,
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <new>
 #include <set>
 #include <vector>
 
@@ -18,24 +19,39 @@ namespace love
 
         static constexpr int MAX_SMALL_STRING_LENGTH = 0x0F;
 
+        /*
+        ** Immutable, refcounted string storage for long strings.
+        ** The characters live in the same allocation as the object itself,
+        ** so sharing a string across threads costs a single allocation.
+        */
         class SharedString : public Object
         {
           public:
-            SharedString(const char* string, size_t length) : length(length)
+            static SharedString* Create(const char* string, size_t length)
             {
-                this->string         = new char[length + 1];
-                this->string[length] = '\0';
-
-                std::memcpy(this->string, string, length);
+                void* memory = ::operator new(sizeof(SharedString) + length + 1);
+                return new (memory) SharedString(string, length);
             }
 
-            virtual ~SharedString()
+            static void operator delete(void* memory)
             {
-                delete[] this->string;
+                ::operator delete(memory);
             }
 
+            virtual ~SharedString()
+            {}
+
             char* string;
             size_t length;
+
+          private:
+            SharedString(const char* string, size_t length) :
+                string(reinterpret_cast<char*>(this + 1)),
+                length(length)
+            {
+                std::memcpy(this->string, string, length);
+                this->string[length] = '\0';
+            }
         };
 
         class SharedTable : public Object
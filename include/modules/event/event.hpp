@@ -4,6 +4,8 @@
 #include <common/message.hpp>
 #include <common/module.hpp>
 
+#include <modules/event/replay.hpp>
+
 #include <utilities/driver/events.hpp>
 #include <utilities/threads/threads.hpp>
 
@@ -48,7 +50,22 @@ namespace love
 
         Message* ConvertKeyboardEvent(const LOVE_Event& event, std::vector<Variant>& args);
 
+        /*
+        ** Ends a frame for the replay, returning the delta the game should see. Pushes
+        ** "replayfinished" once a replay runs out of frames.
+        */
+        double Step(double delta);
+
+        Replay& GetReplay()
+        {
+            return this->replay;
+        }
+
       protected:
+        void Dispatch(const LOVE_Event& event);
+
+        Replay replay;
+
         std::queue<Message*> queue;
         LOVE_Event event;
         love::mutex mutex;
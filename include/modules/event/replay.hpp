@@ -0,0 +1,136 @@
+#pragma once
+
+#include <utilities/driver/events.hpp>
+
+#include <set>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace love
+{
+    /*
+    ** Records the input events love.event pumps and the delta of every love.timer.step, and
+    ** plays them back in place of live input so a game can be benchmarked the same way on
+    ** every build.
+    **
+    ** A recording is "LRPL", a version, and then a stream of records: a frame record holds
+    ** the delta that ended a frame, and an event record holds one input event. Events belong
+    ** to the frame that the next frame record ends. All fields are little-endian.
+    **
+    ** Only input is recorded. While replaying, live quit, low memory, focus and resize events
+    ** still get through, and every step hands back the recorded delta. The real time each
+    ** replayed frame took is kept for GetStats, both as a whole and without the time spent
+    ** presenting it.
+    */
+    class Replay
+    {
+      public:
+        enum State
+        {
+            STATE_IDLE,
+            STATE_RECORDING,
+            STATE_REPLAYING
+        };
+
+        /* real frame times, in seconds */
+        struct Timing
+        {
+            double mean;
+            double p95;
+            double p99;
+            double max;
+        };
+
+        struct Stats
+        {
+            int64_t frames;
+
+            /* from the start of a frame until it is presented */
+            Timing cpu;
+
+            /* from one step to the next, including the present and its vsync wait */
+            Timing wall;
+        };
+
+        static constexpr uint32_t VERSION = 1;
+
+        Replay();
+
+        void StartRecording();
+
+        /* ends the recording and hands back its contents */
+        std::vector<uint8_t> StopRecording();
+
+        /* throws if @data isn't a recording this version can play */
+        void StartReplay(const void* data, size_t size);
+
+        void StopReplay();
+
+        void Record(const LOVE_Event& event);
+
+        /* the next recorded event of the frame being replayed */
+        bool Next(LOVE_Event& event);
+
+        /*
+        ** Ends a frame. @delta is what the timer measured: while recording it is written out,
+        ** while replaying it is kept as the frame's wall time and swapped for the recorded
+        ** delta. @presentTime is the part of @delta spent presenting, which the frame's CPU
+        ** time leaves out. Returns true on the step that runs out of frames, which ends the
+        ** replay.
+        */
+        bool Step(double& delta, double presentTime);
+
+        Stats GetStats() const;
+
+        State GetState() const
+        {
+            return this->state;
+        }
+
+        /* the events a recording holds; the rest always come from the system */
+        static bool IsInputEvent(const LOVE_Event& event)
+        {
+            switch (event.type)
+            {
+                case TYPE_TOUCH:
+                case TYPE_GAMEPAD:
+                case TYPE_KEYBOARD:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool IsLiveEvent(const LOVE_Event& event) const
+        {
+            return this->state != STATE_REPLAYING || !Replay::IsInputEvent(event);
+        }
+
+      private:
+        void Decode(const uint8_t* data, size_t size);
+
+        /* keeps @name alive for the replayed events that point to it */
+        const char* Intern(std::string&& name);
+
+        /* drops the decoded replay */
+        void Reset();
+
+        State state;
+
+        std::vector<uint8_t> recording;
+
+        std::vector<LOVE_Event> events;
+        std::vector<size_t> frameEnds;
+        std::vector<double> deltas;
+
+        std::set<std::string> names;
+
+        size_t eventIndex;
+        size_t frameIndex;
+
+        std::vector<double> cpuTimes;
+        std::vector<double> wallTimes;
+    };
+} // namespace love
@@ -16,5 +16,19 @@ namespace Wrap_Event
 
     int Restart(lua_State* L);
 
+    int StartRecording(lua_State* L);
+
+    int StopRecording(lua_State* L);
+
+    int StartReplay(lua_State* L);
+
+    int StopReplay(lua_State* L);
+
+    int GetReplayStats(lua_State* L);
+
+    int IsRecording(lua_State* L);
+
+    int IsReplaying(lua_State* L);
+
     int Register(lua_State* L);
 } // namespace Wrap_Event
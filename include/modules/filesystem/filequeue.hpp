@@ -0,0 +1,83 @@
+#pragma once
+
+#include <common/strongreference.hpp>
+
+#include <objects/filerequest/filerequest.hpp>
+#include <objects/savewriter/savewriter.hpp>
+
+#include <utilities/threads/threadable.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace love
+{
+    class Filesystem;
+
+    /*
+    ** Runs FileRequests on a thread of its own, highest priority first. Requests for the
+    ** same file are served in the order they were made, and each turn takes every queued
+    ** request for the chosen file that can share one operation: consecutive reads share a
+    ** single read, and consecutive writes and appends collapse into one write (or one
+    ** append when there is no write among them).
+    **
+    ** It also polls every open SaveWriter a few times a second, so their buffers are written
+    ** out here rather than on the thread writing to them.
+    */
+    class FileQueue : public Threadable
+    {
+      public:
+        FileQueue(Filesystem* filesystem);
+
+        virtual ~FileQueue();
+
+        /* the returned request is retained for the caller */
+        FileRequest* Read(const std::string& filename, int priority);
+
+        FileRequest* Write(const std::string& filename, const void* contents, size_t size,
+                           int priority, bool append);
+
+        /* retains @writer until it is removed, or flushes it one last time when stopping */
+        void AddWriter(SaveWriter* writer);
+
+        void RemoveWriter(SaveWriter* writer);
+
+        /* wakes the thread to poll the writers now */
+        void Signal();
+
+        void ThreadFunction();
+
+        /* stops after the current turn and cancels whatever is still queued */
+        void SetFinish();
+
+      private:
+        using Batch   = std::vector<StrongReference<FileRequest>>;
+        using Writers = std::vector<StrongReference<SaveWriter>>;
+
+        static constexpr auto WRITER_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+        void Submit(FileRequest* request);
+
+        void Take(Batch& batch);
+
+        void RunRead(Batch& batch);
+
+        void RunWrite(Batch& batch);
+
+        void Notify(FileRequest* request);
+
+        Filesystem* filesystem;
+
+        /* in the order submitted */
+        Batch pending;
+        std::atomic<uint64_t> sequence;
+        bool finish;
+
+        Writers writers;
+        bool signalled;
+
+        love::mutex mutex;
+        love::conditional condition;
+    };
+} // namespace love
@@ -5,14 +5,23 @@
 
 #include <objects/data/filedata/filedata.hpp>
 #include <objects/file/file.hpp>
+#include <objects/filerequest/filerequest.hpp>
+#include <objects/savewriter/savewriter.hpp>
 
 #include <utilities/bidirectionalmap/bidirectionalmap.hpp>
 
+#include <utilities/threads/threads.hpp>
+
+#include <atomic>
 #include <limits.h>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace love
 {
+    class FileQueue;
+
     class Filesystem : public Module
     {
       public:
@@ -50,11 +59,22 @@ namespace love
             bool readOnly;
         };
 
+        struct RequireStats
+        {
+            int64_t lookups;
+            int64_t cacheHits;
+            int64_t stats;
+            int64_t bytesParsed;
+            int64_t bytecodeHits;
+        };
+
+        /* compiled chunks live here, in the save directory or shipped inside the game */
+        static constexpr const char* BYTECODE_DIRECTORY = ".bytecode";
+
         Filesystem()
         {}
 
-        virtual ~Filesystem()
-        {}
+        virtual ~Filesystem();
 
         ModuleType GetModuleType() const override
         {
@@ -129,6 +149,48 @@ namespace love
 
         virtual void Append(const char* filename, const void* data, int64_t size) const = 0;
 
+        /*
+        ** Writes a file that is never required or mounted, such as a bytecode cache entry,
+        ** creating its directory as needed. Only the metadata cached for the file and its
+        ** directory is dropped, rather than invalidating every path cache.
+        */
+        virtual void WriteCache(const char* filename, const void* data, int64_t size) = 0;
+
+        /* removes a file written by WriteCache, dropping only the metadata cached for it */
+        virtual bool RemoveCache(const char* filename) = 0;
+
+        /*
+        ** Called once @filename has been written. Drops the metadata cached for it and its
+        ** directory, and every module lookup, as the file may now shadow or satisfy one.
+        */
+        virtual void InvalidatePath(const char* filename) = 0;
+
+        /*
+        ** Writes @data beside @filename and renames it over the original, so the file holds
+        ** either its old contents or all of the new ones. Where renaming over a file isn't
+        ** supported the original is kept as a backup until the new file is in place, and
+        ** mounting the save directory puts back whichever copy a crash left behind.
+        */
+        virtual void Replace(const char* filename, const void* data, int64_t size) const = 0;
+
+        /*
+        ** Queue @filename to be read (or written) on the I/O thread, which is started the
+        ** first time one is made. The request is retained for the caller.
+        */
+        FileRequest* ReadAsync(const char* filename, int priority);
+
+        FileRequest* WriteAsync(const char* filename, const void* data, int64_t size,
+                                int priority, bool append);
+
+        /* the writer is retained for the caller and polled on the I/O thread until closed */
+        SaveWriter* NewSaveWriter(const char* filename, const SaveWriter::Settings& settings);
+
+        /* wakes the I/O thread to write out whatever the writers have due */
+        void PollSaveWriters();
+
+        /* writes out what @writer still holds on the calling thread, then stops polling it */
+        void CloseSaveWriter(SaveWriter* writer);
+
         virtual bool GetDirectoryItems(const char* directory, std::vector<std::string>& items) = 0;
 
         virtual void SetSymlinksEnabled(bool enable) = 0;
@@ -137,12 +199,61 @@ namespace love
 
         virtual std::vector<std::string>& GetRequirePath() = 0;
 
+        /* held while the require path is read or replaced, as FindModule searches it */
+        std::unique_lock<love::mutex> LockRequirePath()
+        {
+            return std::unique_lock(this->modulePathsMutex);
+        }
+
         // virtual std::vector<std::string>& GetCRequirePath() = 0;
 
         virtual void AllowMountingForPath(const std::string& path) = 0;
 
         virtual bool SetupWriteDirectory() = 0;
 
+        /*
+        ** Resolves @module (with its dots already turned into slashes) against the require
+        ** path. Answers, including failed ones, are remembered until Invalidate is called.
+        */
+        bool FindModule(const std::string& module, std::string& path);
+
+        void CountBytesParsed(size_t bytes)
+        {
+            this->bytesParsed += bytes;
+        }
+
+        void CountBytecodeHit()
+        {
+            this->bytecodeHits++;
+        }
+
+        void SetBytecodeCacheEnabled(bool enable)
+        {
+            this->bytecodeCacheEnabled = enable;
+        }
+
+        bool IsBytecodeCacheEnabled() const
+        {
+            return this->bytecodeCacheEnabled;
+        }
+
+        /*
+        ** Where the compiled form of a source (loaded as @name) is cached, given the FNV-1a
+        ** hash and size of its text. The filename is a key for @name, then a key covering the
+        ** engine version and source text, so edits and upgrades never pick up stale chunks
+        ** and the entries they leave behind can be found by the first key.
+        */
+        static std::string GetBytecodePath(const std::string& name, uint64_t sourceHash,
+                                           size_t sourceSize);
+
+        RequireStats GetRequireStats() const;
+
+        /* called after mounts or the write directory change what files are visible */
+        static void Invalidate()
+        {
+            generation++;
+        }
+
         bool IsRealDirectory(const std::string& path) const;
 
         bool CreateRealDirectory(const std::string& path);
@@ -176,5 +287,37 @@ namespace love
         std::string executablePath;
 
         bool GetRealPathType(const std::string& path, FileType& ftype) const;
+
+        /* bumped by Invalidate; caches compare against it to notice they are stale */
+        static uint64_t GetGeneration()
+        {
+            return generation;
+        }
+
+        /* implementations call this before tearing down, so queued I/O never outlives them */
+        void StopQueue();
+
+        void ClearModulePaths();
+
+      private:
+        FileQueue* GetQueue();
+
+        static inline std::atomic<uint64_t> generation = 0;
+
+        FileQueue* queue = nullptr;
+        love::mutex queueMutex;
+
+        /* module name to resolved path; empty when nothing on the require path matched */
+        std::unordered_map<std::string, std::string> modulePaths;
+        uint64_t modulePathsGeneration = 0;
+        love::mutex modulePathsMutex;
+
+        std::atomic<int64_t> lookups     = 0;
+        std::atomic<int64_t> cacheHits   = 0;
+        std::atomic<int64_t> statCalls   = 0;
+        std::atomic<int64_t> bytesParsed = 0;
+
+        std::atomic<int64_t> bytecodeHits      = 0;
+        std::atomic<bool> bytecodeCacheEnabled = false;
     };
 } // namespace love
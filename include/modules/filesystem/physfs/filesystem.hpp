@@ -7,7 +7,9 @@
 #include <objects/file/physfs/file.hpp>
 
 #include <array>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
 namespace love::physfs
 {
@@ -88,6 +90,14 @@ namespace love::physfs
 
         void Append(const char* filename, const void* data, int64_t size) const override;
 
+        void WriteCache(const char* filename, const void* data, int64_t size) override;
+
+        bool RemoveCache(const char* filename) override;
+
+        void InvalidatePath(const char* filename) override;
+
+        void Replace(const char* filename, const void* data, int64_t size) const override;
+
         bool GetDirectoryItems(const char* directory, std::vector<std::string>& items) override;
 
         void SetSymlinksEnabled(bool enable) override;
@@ -112,6 +122,40 @@ namespace love::physfs
             MountPermissions permissions;
         };
 
+        struct MountedData
+        {
+            StrongReference<Data> data;
+            std::string mountPoint;
+
+            /* zip entries stored without compression: name to offset and size in data */
+            std::unordered_map<std::string, std::pair<size_t, size_t>> storedEntries;
+        };
+
+        /*
+        ** What GetInfo and GetDirectoryItems last answered for each path, failures included.
+        ** Emptied whenever the generation moves on, e.g. on a mount change; writing a file
+        ** only drops the entries for it and its directory.
+        */
+        struct MetadataCache
+        {
+            uint64_t generation = 0;
+
+            std::unordered_map<std::string, std::optional<Info>> infos;
+            std::unordered_map<std::string, std::optional<std::vector<std::string>>> directories;
+        };
+
+        /* each map is emptied rather than grown past this */
+        static constexpr size_t MAX_CACHED_PATHS = 0x1000;
+
+        /* call with metadataMutex held */
+        MetadataCache& GetMetadataCache() const;
+
+        /* drops the metadata cached for @filename and its directory */
+        void ForgetMetadata(const char* filename) const;
+
+        /* a view into a mounted archive for @filename, if PhysFS would read it from one */
+        FileData* ReadStoredEntry(const char* filename) const;
+
         bool MountCommonPathInternal(CommonPath path, const char* mountpoint,
                                      MountPermissions permissions, bool appendToPath,
                                      bool createDirectory);
@@ -133,7 +177,7 @@ namespace love::physfs
 
         std::vector<std::string> allowedMountPaths;
 
-        std::map<std::string, StrongReference<Data>> mountedData;
+        std::map<std::string, MountedData> mountedData;
 
         std::array<std::string, CommonPath::PATH_MAX_ENUM> fullPaths;
         std::array<CommonPathMountInfo, CommonPath::PATH_MAX_ENUM> commonPathMountInfo;
@@ -141,5 +185,14 @@ namespace love::physfs
         bool saveDirectoryNeedsMounting;
 
         std::array<CommonPath, 0x02> appCommonPaths;
+
+        mutable MetadataCache metadata;
+        mutable love::mutex metadataMutex;
+
+        /* guards mountedData, which file queue reads look up */
+        mutable love::mutex mountMutex;
+
+        /* held while the save directory is set up, which the first queued write may do */
+        love::mutex writeDirectoryMutex;
     };
 } // namespace love::physfs
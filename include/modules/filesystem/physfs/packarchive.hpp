@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** A read-only archive format that PhysFS mounts alongside zips (any mounted file starting
+** with the right magic is claimed, whatever its extension). All fields are little-endian.
+**
+** header:  "LPAK", version, entry count, block size, TOC offset (64-bit), names size,
+**          alignment
+** data:    each entry starts on an @alignment boundary. Stored entries are the file as-is;
+**          LZ4 entries begin with a seek table of (blocks + 1) 32-bit offsets, relative to
+**          the entry, followed by the blocks. Every block but the last unpacks to the block
+**          size, and a block whose stored length equals that size is kept uncompressed.
+** TOC:     one record per file, sorted by name so lookups are a binary search, followed by
+**          the names they point into. Directories are implied by the names.
+**
+** Seeking within an LZ4 entry only unpacks the block being read, so decoders can stream
+** and seek compressed audio without inflating it from the start as zips would.
+*/
+namespace love::physfs::PackArchive
+{
+    static constexpr uint32_t VERSION = 1;
+
+    static constexpr uint32_t DEFAULT_BLOCK_SIZE = 0x10000;
+    static constexpr uint32_t DEFAULT_ALIGNMENT  = 0x10;
+
+    static constexpr uint32_t MIN_BLOCK_SIZE = 0x400;
+    static constexpr uint32_t MAX_BLOCK_SIZE = 0x1000000;
+
+    enum Storage
+    {
+        STORAGE_STORED,
+        STORAGE_LZ4
+    };
+
+    struct Settings
+    {
+        uint32_t blockSize = DEFAULT_BLOCK_SIZE;
+        uint32_t alignment = DEFAULT_ALIGNMENT;
+        bool compress      = true;
+
+        /* -1 for LZ4's default; 1 to 8 trade ratio for speed, 9 to 12 use LZ4HC */
+        int level = -1;
+    };
+
+    /* called once PhysFS is initialised */
+    bool Register();
+
+    /*
+    ** Packs every file below @directory in the search path into @filename in the save
+    ** directory, and returns how many were packed. Entries that LZ4 can't shrink are stored.
+    */
+    int Create(const char* directory, const char* filename, const Settings& settings);
+} // namespace love::physfs::PackArchive
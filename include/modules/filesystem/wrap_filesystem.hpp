@@ -6,6 +6,7 @@
 
 #include <objects/data/filedata/filedata.hpp>
 #include <objects/file/file.hpp>
+#include <objects/filerequest/filerequest.hpp>
 
 namespace Wrap_Filesystem
 {
@@ -17,8 +18,12 @@ namespace Wrap_Filesystem
 
     int Append(lua_State* L);
 
+    int AppendAsync(lua_State* L);
+
     int CreateDirectory(lua_State* L);
 
+    int CreatePack(lua_State* L);
+
     int GetDirectoryItems(lua_State* L);
 
     int GetIdentity(lua_State* L);
@@ -43,6 +48,14 @@ namespace Wrap_Filesystem
 
     int GetRequirePath(lua_State* L);
 
+    int GetRequireStats(lua_State* L);
+
+    int SetBytecodeCacheEnabled(lua_State* L);
+
+    int IsBytecodeCacheEnabled(lua_State* L);
+
+    int CompileBytecode(lua_State* L);
+
     int Loader(lua_State* L);
 
     int Load(lua_State* L);
@@ -51,6 +64,8 @@ namespace Wrap_Filesystem
 
     int NewFileData(lua_State* L);
 
+    int NewSaveWriter(lua_State* L);
+
     int SetFused(lua_State* L);
 
     int IsFused(lua_State* L);
@@ -77,6 +92,8 @@ namespace Wrap_Filesystem
 
     int Read(lua_State* L);
 
+    int ReadAsync(lua_State* L);
+
     int Register(lua_State* L);
 
     int Remove(lua_State* L);
@@ -103,6 +120,10 @@ namespace Wrap_Filesystem
 
     int Write(lua_State* L);
 
+    int WriteAsync(lua_State* L);
+
+    int WriteOrAppendAsync(lua_State* L, bool append);
+
     std::string Redirect(const char* path);
 
     bool SetupWriteDirectory();
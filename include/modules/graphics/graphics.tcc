@@ -3,6 +3,7 @@
 #include <common/color.hpp>
 #include <common/console.hpp>
 #include <common/math.hpp>
+#include <common/memorystats.hpp>
 #include <common/module.hpp>
 #include <common/optional.hpp>
 #include <common/strongreference.hpp>
@@ -11,11 +12,13 @@
 
 #include <modules/font/fontmodule.tcc>
 #include <modules/math/math.hpp>
+#include <modules/profiler/profiler.hpp>
 #include <modules/window/window.tcc>
 
 #include <objects/shader/shader.tcc>
 #include <objects/texture/texture.tcc>
 
+#include <objects/atlas/atlas.hpp>
 #include <objects/font/font.hpp>
 #include <objects/mesh/mesh.hpp>
 #include <objects/quad/quad.hpp>
@@ -193,6 +196,13 @@ namespace love
             int fonts;
             int64_t textureMemory;
 
+            /* the parts of textureMemory held by render targets and font glyph pages */
+            int64_t renderTargetMemory;
+            int64_t fontMemory;
+
+            int64_t vertexMemory;
+            int64_t stagingMemory;
+
             float gpuTime;
             float cpuTime;
         };
@@ -350,7 +360,13 @@ namespace love
 
         void Present()
         {
-            Renderer<Console::Which>::Instance().Present();
+            {
+                Profiler::Zone zone("graphics.present");
+
+                const double begin = Profiler::GetTime();
+                Renderer<Console::Which>::Instance().Present();
+                Renderer<>::presentTime = Profiler::GetTime() - begin;
+            }
 
             Renderer<Console::Which>::drawCalls        = 0;
             Renderer<Console::Which>::drawCallsBatched = 0;
@@ -407,6 +423,11 @@ namespace love
             return new SpriteBatch(texture, size);
         }
 
+        Atlas* NewAtlas(const Atlas::Settings& settings) const
+        {
+            return new Atlas(settings);
+        }
+
         TextBatch* NewTextBatch(Font* font, const ColoredStrings& text = {}) const
         {
             return new TextBatch(font, text);
@@ -760,6 +781,13 @@ namespace love
             stats.drawCallsBatched     = Renderer<>::drawCallsBatched;
             stats.renderTargetSwitches = renderTargetSwitchCount;
 
+            using namespace MemoryStats;
+
+            stats.renderTargetMemory = Get(CATEGORY_RENDER_TARGET).current;
+            stats.fontMemory         = Get(CATEGORY_FONT).current;
+            stats.vertexMemory       = Get(CATEGORY_VERTEX).current;
+            stats.stagingMemory      = Get(CATEGORY_STAGING).current;
+
             stats.cpuTime = Renderer<>::cpuTime;
             stats.gpuTime = Renderer<>::gpuTime;
 
@@ -17,16 +17,10 @@ namespace Wrap_Graphics
         }
         else
         {
-            float x  = luaL_optnumber(L, index + 0, 0.0);
-            float y  = luaL_optnumber(L, index + 1, 0.0);
-            float a  = luaL_optnumber(L, index + 2, 0.0);
-            float sx = luaL_optnumber(L, index + 3, 1.0);
-            float sy = luaL_optnumber(L, index + 4, sx);
-            float ox = luaL_optnumber(L, index + 5, 0.0);
-            float oy = luaL_optnumber(L, index + 6, 0.0);
-            float kx = luaL_optnumber(L, index + 7, 0.0);
-            float ky = luaL_optnumber(L, index + 8, 0.0);
-            func(love::Matrix4(x, y, a, sx, sy, ox, oy, kx, ky));
+            const auto args = luax::OptTransform(L, index);
+
+            func(love::Matrix4(args[0], args[1], args[2], args[3], args[4], args[5], args[6],
+                               args[7], args[8]));
         }
     }
 
@@ -158,6 +152,8 @@ namespace Wrap_Graphics
 
     int NewSpriteBatch(lua_State* L);
 
+    int NewAtlas(lua_State* L);
+
     int NewMesh(lua_State* L);
 
     int Print(lua_State* L);
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <common/module.hpp>
+
+#include <utilities/threads/threads.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace love
+{
+    /*
+    ** A zone profiler for frame timing. Engine internals mark their work with a Zone, Lua
+    ** marks its own with love.profiler.push and pop, and the lot can be exported as a Chrome
+    ** trace (chrome://tracing or Perfetto).
+    **
+    ** Each thread writes its zones into a ring of its own without taking a lock, keeping only
+    ** the most recent RING_SIZE of them. While profiling is disabled a zone costs one relaxed
+    ** atomic load, so the zones stay compiled into release builds.
+    **
+    ** A ring outlives its thread so its zones can still be exported, and is handed to the
+    ** next thread that needs one, so short-lived threads don't each leave a ring behind.
+    */
+    class Profiler : public Module
+    {
+      public:
+        static constexpr size_t RING_SIZE = 0x4000;
+
+        /* distinct pushed zone names kept per thread; zones past it share one name */
+        static constexpr size_t MAX_NAMES = 0x400;
+
+        /* times the scope it lives in, if profiling was enabled when it was entered */
+        class Zone
+        {
+          public:
+            Zone(const char* name) : name(nullptr), begin(0)
+            {
+                if (Profiler::IsEnabled())
+                {
+                    this->name  = name;
+                    this->begin = Profiler::GetTime();
+                }
+            }
+
+            ~Zone()
+            {
+                if (this->name != nullptr)
+                    Profiler::Emit(this->name, this->begin, Profiler::GetTime());
+            }
+
+            Zone(const Zone&) = delete;
+
+            Zone& operator=(const Zone&) = delete;
+
+          private:
+            const char* name;
+            double begin;
+        };
+
+        virtual ~Profiler()
+        {}
+
+        const char* GetName() const override
+        {
+            return "love.profiler";
+        }
+
+        ModuleType GetModuleType() const override
+        {
+            return M_PROFILER;
+        }
+
+        static bool IsEnabled()
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        static void SetEnabled(bool enable);
+
+        /* names the calling thread in exported traces */
+        static void SetThreadName(const std::string& name);
+
+        static double GetTime();
+
+        /* records a finished zone on the calling thread; @name must outlive the profiler */
+        static void Emit(const char* name, double begin, double end);
+
+        /* opens a zone on the calling thread; @name is copied */
+        static void Push(const char* name);
+
+        /* closes the calling thread's innermost pushed zone; false if there is none */
+        static bool Pop();
+
+        /* drops every recorded zone */
+        static void Clear();
+
+        /* the recorded zones of every thread, as Chrome trace event JSON */
+        static std::string ExportTrace();
+
+      private:
+        struct Sample
+        {
+            const char* name;
+            double begin;
+            double end;
+        };
+
+        /* written only by its thread; head and tail let ExportTrace read it alongside */
+        struct Ring
+        {
+            std::unique_ptr<Sample[]> samples;
+
+            std::atomic<uint64_t> head;
+            std::atomic<uint64_t> tail;
+
+            uint32_t id;
+            std::string threadName;
+
+            /* names of pushed zones, which the samples point into */
+            std::unordered_set<std::string> names;
+        };
+
+        /* hands the thread's ring back to the pool as the thread exits */
+        struct RingOwner
+        {
+            Ring* ring = nullptr;
+
+            ~RingOwner();
+        };
+
+        static Ring& GetRing();
+
+        static inline std::atomic<bool> enabled = false;
+
+        static thread_local RingOwner threadRing;
+
+        /* guards the rings, their thread names and the pool, never the samples */
+        static inline love::mutex ringsMutex;
+        static inline std::vector<std::unique_ptr<Ring>> rings;
+
+        /* rings whose thread has exited, ready to be reused */
+        static inline std::vector<Ring*> freeRings;
+        static inline uint32_t nextId = 1;
+    };
+} // namespace love
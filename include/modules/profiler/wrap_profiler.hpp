@@ -0,0 +1,21 @@
+#pragma once
+
+#include <common/luax.hpp>
+#include <modules/profiler/profiler.hpp>
+
+namespace Wrap_Profiler
+{
+    int Clear(lua_State* L);
+
+    int ExportTrace(lua_State* L);
+
+    int IsEnabled(lua_State* L);
+
+    int Pop(lua_State* L);
+
+    int Push(lua_State* L);
+
+    int SetEnabled(lua_State* L);
+
+    int Register(lua_State* L);
+} // namespace Wrap_Profiler
@@ -24,6 +24,10 @@ namespace Wrap_System
 
     int GetSystemTheme(lua_State* L);
 
+    int GetMemoryStats(lua_State* L);
+
+    int ResetMemoryPeaks(lua_State* L);
+
     int GetPlayCoins(lua_State* L);
 
     int SetPlayCoins(lua_State* L);
@@ -7,7 +7,11 @@
 #include <objects/channel/channel.hpp>
 #include <objects/thread/luathread.hpp>
 
+#include <deque>
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace love
 {
@@ -33,8 +37,31 @@ namespace love
 
         Channel* GetChannel(const std::string& name);
 
+        /* the compiled form of @code, if a thread has already compiled the same source */
+        std::shared_ptr<const std::string> GetBytecode(const std::string& name, Data* code);
+
+        void SetBytecode(const std::string& name, Data* code, std::string&& bytecode);
+
       protected:
+        static constexpr size_t MAX_CACHED_BYTECODE = 0x40;
+
+        struct CachedBytecode
+        {
+            /* kept to tell apart sources whose hashes collide */
+            std::string name;
+            std::string source;
+
+            std::shared_ptr<const std::string> bytecode;
+        };
+
+        static uint64_t GetBytecodeKey(const std::string& name, Data* code);
+
         std::map<std::string, StrongReference<Channel>> namedChannels;
         love::mutex mutex;
+
+        /* compiled thread code, shared by every thread started from the same source */
+        std::unordered_map<uint64_t, CachedBytecode> bytecodeCache;
+        std::deque<uint64_t> bytecodeOrder;
+        love::mutex bytecodeMutex;
     };
 } // namespace love
@@ -40,6 +40,12 @@ namespace love
             return this->delta;
         }
 
+        /* lets a replay hand the game its recorded delta */
+        void SetDelta(double delta)
+        {
+            this->delta = delta;
+        }
+
         double GetAverageDelta() const
         {
             return this->averageDelta;
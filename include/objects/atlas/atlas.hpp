@@ -0,0 +1,117 @@
+#pragma once
+
+#include <common/console.hpp>
+#include <common/math.hpp>
+#include <common/object.hpp>
+#include <common/pixelformat.hpp>
+#include <common/strongreference.hpp>
+
+#include <objects/imagedata_ext.hpp>
+#include <objects/quad/quad.hpp>
+#include <objects/texture/texture.tcc>
+
+#include <utilities/skylinepacker.hpp>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace love
+{
+    /*
+    ** Packs many images into a few large texture pages so that sprites drawn from it share
+    ** textures (and batch together). Every entry is surrounded by @extrude copies of its
+    ** edge pixels, so filtering at its border doesn't bleed in its neighbours, and
+    ** @padding empty pixels. Entries can be added at any time; a new page is created when
+    ** none of the existing ones has room.
+    */
+    class Atlas : public Object
+    {
+      public:
+        static Type type;
+
+        static constexpr int DEFAULT_SIZE = Console::Is(Console::CTR) ? 0x400 : 0x800;
+
+        struct Settings
+        {
+            int width          = DEFAULT_SIZE;
+            int height         = DEFAULT_SIZE;
+            int padding        = 1;
+            int extrude        = 1;
+            PixelFormat format = PIXELFORMAT_RGBA8_UNORM;
+        };
+
+        struct Entry
+        {
+            StrongReference<Quad> quad;
+            int page;
+            Rect rect;
+        };
+
+        struct Source
+        {
+            std::string name;
+            ImageData<Console::Which>* data;
+        };
+
+        Atlas(const Settings& settings);
+
+        virtual ~Atlas();
+
+        /* packs @data into the first page with room for it and returns the entry index */
+        int Add(ImageData<Console::Which>* data, const std::string& name = "");
+
+        /*
+        ** Packs every source, largest first for a tighter fit. @indices receives the entry
+        ** index of each source, in the order given.
+        */
+        void Add(const std::vector<Source>& sources, std::vector<int>& indices);
+
+        const Entry& GetEntry(int index) const;
+
+        std::optional<int> FindEntry(const std::string& name) const;
+
+        int GetEntryCount() const
+        {
+            return (int)this->entries.size();
+        }
+
+        Texture<Console::Which>* GetTexture(int page) const;
+
+        int GetPageCount() const
+        {
+            return (int)this->pages.size();
+        }
+
+        float GetOccupancy(int page) const;
+
+        const Settings& GetSettings() const
+        {
+            return this->settings;
+        }
+
+      private:
+        struct Page
+        {
+            StrongReference<Texture<Console::Which>> texture;
+            SkylinePacker packer;
+        };
+
+        void Check(ImageData<Console::Which>* data) const;
+
+        void CreatePage();
+
+        Entry Pack(ImageData<Console::Which>* data);
+
+        int Insert(Entry&& entry, const std::string& name);
+
+        void Upload(Page& page, const Rect& cell, ImageData<Console::Which>* data);
+
+        Settings settings;
+
+        std::vector<Page> pages;
+        std::vector<Entry> entries;
+        std::unordered_map<std::string, int> names;
+    };
+} // namespace love
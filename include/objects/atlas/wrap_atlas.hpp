@@ -0,0 +1,34 @@
+#pragma once
+
+#include <common/luax.hpp>
+#include <objects/atlas/atlas.hpp>
+
+namespace Wrap_Atlas
+{
+    love::Atlas* CheckAtlas(lua_State* L, int index);
+
+    /*
+    ** ImageData, or a filename/File/FileData decoded through love.image. @name receives the
+    ** filename when one was given.
+    */
+    love::StrongReference<love::ImageData<love::Console::Which>> CheckImage(lua_State* L, int index,
+                                                                            std::string& name);
+
+    int Add(lua_State* L);
+
+    int GetQuad(lua_State* L);
+
+    int GetIndex(lua_State* L);
+
+    int GetCount(lua_State* L);
+
+    int GetTexture(lua_State* L);
+
+    int GetTextures(lua_State* L);
+
+    int GetPageCount(lua_State* L);
+
+    int GetOccupancy(lua_State* L);
+
+    int Register(lua_State* L);
+} // namespace Wrap_Atlas
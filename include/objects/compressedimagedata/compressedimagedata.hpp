@@ -18,6 +18,10 @@ namespace love
 
         CompressedImageData(const std::list<FormatHandler*>& formats, Data* fileData);
 
+        /* a single mipmap of @format already encoded into @memory */
+        CompressedImageData(PixelFormat format, int width, int height, ByteData* memory,
+                            bool sRGB = false);
+
         CompressedImageData(const CompressedImageData& data);
 
         virtual ~CompressedImageData()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <common/data.hpp>
+#include <common/strongreference.hpp>
 
 #include <memory>
 
@@ -13,6 +14,12 @@ namespace love
 
         FileData(uint64_t size, const std::string& filename);
 
+        /*
+        ** Views @size bytes of @source starting at @offset instead of copying them, e.g. a
+        ** stored entry of an archive mounted from memory. @source is kept alive meanwhile.
+        */
+        FileData(Data* source, size_t offset, size_t size, const std::string& filename);
+
         FileData(const FileData& content);
 
         FileData* Clone() const;
@@ -28,7 +35,11 @@ namespace love
         const std::string& GetName() const;
 
       private:
+        void SetFilename(const std::string& filename);
+
         std::unique_ptr<char[]> data;
+        StrongReference<Data> source;
+        char* pointer;
         uint64_t size;
 
         std::string filename;
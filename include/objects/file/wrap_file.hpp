@@ -25,6 +25,9 @@ namespace Wrap_File
 
     int Lines(lua_State* L);
 
+    /* pushes a lines() iterator over the File at @index, which must be open for reading */
+    void PushLinesIterator(lua_State* L, int index, bool seekBack, bool slices);
+
     int Open(lua_State* L);
 
     int Read(lua_State* L);
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <common/object.hpp>
+#include <common/strongreference.hpp>
+
+#include <objects/data/filedata/filedata.hpp>
+
+#include <utilities/bidirectionalmap/bidirectionalmap.hpp>
+#include <utilities/threads/threads.hpp>
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace love
+{
+    /*
+    ** A read, write or append queued on the filesystem's I/O thread. The game polls it (or
+    ** waits on it) from the main thread while the I/O thread moves it from pending to one of
+    ** the completed states. Only pending requests can be cancelled or re-prioritised.
+    */
+    class FileRequest : public Object
+    {
+      public:
+        static Type type;
+
+        enum Operation
+        {
+            OPERATION_READ,
+            OPERATION_WRITE,
+            OPERATION_APPEND,
+            OPERATION_MAX_ENUM
+        };
+
+        enum Status
+        {
+            STATUS_PENDING,
+            STATUS_RUNNING,
+            STATUS_DONE,
+            STATUS_FAILED,
+            STATUS_CANCELLED,
+            STATUS_MAX_ENUM
+        };
+
+        FileRequest(Operation operation, const std::string& filename, int priority,
+                    uint64_t sequence);
+
+        /* @contents is copied, so the caller's buffer may change once this returns */
+        FileRequest(Operation operation, const std::string& filename, const void* contents,
+                    size_t size, int priority, uint64_t sequence);
+
+        virtual ~FileRequest();
+
+        Operation GetOperation() const
+        {
+            return this->operation;
+        }
+
+        const std::string& GetFilename() const
+        {
+            return this->filename;
+        }
+
+        const std::vector<uint8_t>& GetContents() const
+        {
+            return this->contents;
+        }
+
+        uint64_t GetSequence() const
+        {
+            return this->sequence;
+        }
+
+        int GetPriority() const
+        {
+            return this->priority;
+        }
+
+        void SetPriority(int priority)
+        {
+            this->priority = priority;
+        }
+
+        Status GetStatus() const
+        {
+            return this->status;
+        }
+
+        bool IsComplete() const;
+
+        /* false once the I/O thread has picked the request up */
+        bool Cancel();
+
+        /* blocks until complete, or for at most @timeout seconds when it isn't negative */
+        bool Wait(double timeout);
+
+        /* what was read; null unless a read finished successfully */
+        FileData* GetData() const;
+
+        /* empty unless the request failed */
+        const std::string& GetError() const
+        {
+            return this->error;
+        }
+
+        /* called by the I/O thread: claims a pending request, failing if it was cancelled */
+        bool Begin();
+
+        void Finish(FileData* data);
+
+        void Fail(const std::string& error);
+
+        // clang-format off
+        static constexpr BidirectionalMap operations = {
+            "read",   OPERATION_READ,
+            "write",  OPERATION_WRITE,
+            "append", OPERATION_APPEND
+        };
+
+        static constexpr BidirectionalMap statuses = {
+            "pending",   STATUS_PENDING,
+            "running",   STATUS_RUNNING,
+            "done",      STATUS_DONE,
+            "failed",    STATUS_FAILED,
+            "cancelled", STATUS_CANCELLED
+        };
+        // clang-format on
+
+      private:
+        void Complete(Status status);
+
+        Operation operation;
+        std::string filename;
+        std::vector<uint8_t> contents;
+        uint64_t sequence;
+
+        std::atomic<int> priority;
+        std::atomic<Status> status;
+
+        StrongReference<FileData> data;
+        std::string error;
+
+        love::mutex mutex;
+        love::conditional condition;
+    };
+} // namespace love
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <common/luax.hpp>
+#include <objects/filerequest/filerequest.hpp>
+
+namespace Wrap_FileRequest
+{
+    int Cancel(lua_State* L);
+
+    int GetData(lua_State* L);
+
+    int GetError(lua_State* L);
+
+    int GetFilename(lua_State* L);
+
+    int GetOperation(lua_State* L);
+
+    int GetPriority(lua_State* L);
+
+    int GetStatus(lua_State* L);
+
+    int IsComplete(lua_State* L);
+
+    int SetPriority(lua_State* L);
+
+    int Wait(lua_State* L);
+
+    love::FileRequest* CheckFileRequest(lua_State* L, int index);
+
+    int Register(lua_State* L);
+} // namespace Wrap_FileRequest
@@ -12,7 +12,10 @@
 
 #include <utilities/bidirectionalmap/bidirectionalmap.hpp>
 #include <utilities/formathandler/formathandler.hpp>
+#include <utilities/pixelconverter.hpp>
+#include <utilities/swizzle.hpp>
 
+#include <utilities/threads/parallel.hpp>
 #include <utilities/threads/threads.hpp>
 
 #if defined(__3DS__)
@@ -27,11 +30,16 @@
     #include <utilities/formathandler/types/pnghandler.hpp>
 #endif
 
+#include <array>
+#include <cmath>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace love
 {
+    class CompressedImageData;
+
     template<Console::Platform T = Console::ALL>
     class ImageData : public ImageDataBase
     {
@@ -55,6 +63,16 @@ namespace love
 
         static inline Type type = Type("ImageData", &Object::type);
 
+        enum DownscaleFilter
+        {
+            DOWNSCALE_BOX,
+            DOWNSCALE_GAUSSIAN,
+            DOWNSCALE_MAX_ENUM
+        };
+
+        /* regions with at least this many pixels are split across threads */
+        static constexpr int THREAD_THRESHOLD = 0x100 * 0x100;
+
         typedef void (*PixelSetFunction)(const Color&, Pixel*);
         typedef void (*PixelGetFunction)(const Pixel*, Color&);
 
@@ -92,10 +110,10 @@ namespace love
                 return;
             }
 
-            color.r = pixel->rgba8[0] / 0xFF;
-            color.g = pixel->rgba8[1] / 0xFF;
-            color.b = pixel->rgba8[2] / 0xFF;
-            color.a = pixel->rgba8[3] / 0xFF;
+            color.r = pixel->rgba8[0] / 255.0f;
+            color.g = pixel->rgba8[1] / 255.0f;
+            color.b = pixel->rgba8[2] / 255.0f;
+            color.a = pixel->rgba8[3] / 255.0f;
         }
 
         static void setPixelRGBA16(const Color& color, Pixel* pixel)
@@ -103,19 +121,44 @@ namespace love
             pixel->rgba16[0] =
                 static_cast<uint16_t>(std::clamp<float>(color.r, 0, 1) * 0xFFFF + 0.5f);
             pixel->rgba16[1] =
-                static_cast<uint16_t>(std::clamp<float>(color.b, 0, 1) * 0xFFFF + 0.5f);
-            pixel->rgba16[2] =
                 static_cast<uint16_t>(std::clamp<float>(color.g, 0, 1) * 0xFFFF + 0.5f);
+            pixel->rgba16[2] =
+                static_cast<uint16_t>(std::clamp<float>(color.b, 0, 1) * 0xFFFF + 0.5f);
             pixel->rgba16[3] =
                 static_cast<uint16_t>(std::clamp<float>(color.a, 0, 1) * 0xFFFF + 0.5f);
         }
 
         static void getPixelRGBA16(const Pixel* pixel, Color& color)
         {
-            color.r = pixel->rgba16[0] / 0xFFFF;
-            color.g = pixel->rgba16[1] / 0xFFFF;
-            color.b = pixel->rgba16[2] / 0xFFFF;
-            color.a = pixel->rgba16[3] / 0xFFFF;
+            color.r = pixel->rgba16[0] / 65535.0f;
+            color.g = pixel->rgba16[1] / 65535.0f;
+            color.b = pixel->rgba16[2] / 65535.0f;
+            color.a = pixel->rgba16[3] / 65535.0f;
+        }
+
+        template<PixelFormat F>
+        static void setPixelConverted(const Color& color, Pixel* pixel)
+        {
+            const auto channel = [](float value) {
+                const float clamped = std::clamp<float>(value, 0, 1);
+                return (uint32_t)(clamped * PixelConverter::CHANNEL_MAX + 0.5f);
+            };
+
+            const PixelConverter::Channels channels { channel(color.r), channel(color.g),
+                                                      channel(color.b), channel(color.a) };
+
+            PixelConverter::Store<F>((uint8_t*)pixel, 0, channels);
+        }
+
+        template<PixelFormat F>
+        static void getPixelConverted(const Pixel* pixel, Color& color)
+        {
+            const auto channels = PixelConverter::Load<F>((const uint8_t*)pixel, 0);
+
+            color.r = channels.r / (float)PixelConverter::CHANNEL_MAX;
+            color.g = channels.g / (float)PixelConverter::CHANNEL_MAX;
+            color.b = channels.b / (float)PixelConverter::CHANNEL_MAX;
+            color.a = channels.a / (float)PixelConverter::CHANNEL_MAX;
         }
 
         ImageData(Data* data) : ImageDataBase(PIXELFORMAT_UNKNOWN, 0, 0)
@@ -255,6 +298,8 @@ namespace love
             auto getFunction = source->pixelGetFunction;
             auto setFunction = this->pixelSetFunction;
 
+            auto convertRow = PixelConverter::GetRowFunction(srcFormat, destFormat);
+
             if (srcFormat == destFormat && (sourceRect.w == destWidth && destWidth == srcWidth &&
                                             sourceRect.h == destHeight && destHeight == srcHeight))
             {
@@ -271,6 +316,8 @@ namespace love
 
                     if (srcFormat == destFormat)
                         std::memcpy(rowdst.u8, rowsrc.u8, srcPixelSize * sourceRect.w);
+                    else if (convertRow != nullptr)
+                        convertRow(rowsrc.u8, rowdst.u8, sourceRect.w);
                     else
                     {
                         // Slow path: convert src -> Colorf -> dst.
@@ -298,8 +345,8 @@ namespace love
 
             if (Console::Is(Console::CTR))
             {
-                const auto _width = NextPo2(this->width);
-                pixel = (Pixel*)Color::FromTile(this->data.get(), _width, { (float)x, (float)y });
+                const auto index = Swizzle::TileIndex(NextPo2(this->width), x, y);
+                pixel            = (Pixel*)(this->data.get() + index * size);
             }
             else
                 pixel = (Pixel*)(this->data.get() + (y * this->width + x) * size);
@@ -325,8 +372,8 @@ namespace love
 
             if (Console::Is(Console::CTR))
             {
-                const auto _width = NextPo2(this->width);
-                pixel = (Pixel*)Color::FromTile(this->data.get(), _width, { (float)x, (float)y });
+                const auto index = Swizzle::TileIndex(NextPo2(this->width), x, y);
+                pixel            = (Pixel*)(this->data.get() + index * size);
             }
             else
                 pixel = (Pixel*)(this->data.get() + (y * this->width + x) * size);
@@ -350,8 +397,371 @@ namespace love
             return color;
         }
 
+        /* address of the pixel at @x, @y; no bounds checks and no locking */
+        uint8_t* GetPixelAddress(int x, int y) const
+        {
+            if (Console::Is(Console::CTR))
+            {
+                const auto index = Swizzle::TileIndex(NextPo2(this->width), x, y);
+                return this->data.get() + index * this->GetPixelSize();
+            }
+
+            return this->data.get() + (y * this->width + x) * this->GetPixelSize();
+        }
+
+        void CheckRegion(const Rect& rect, const char* function) const
+        {
+            if (rect.w <= 0 || rect.h <= 0 || !this->Inside(rect.x, rect.y) ||
+                !this->Inside(rect.x + rect.w - 1, rect.y + rect.h - 1))
+            {
+                throw love::Exception("Invalid rectangle dimensions for ImageData:%s.", function);
+            }
+        }
+
+        void CheckColorFunctions(const char* function) const
+        {
+            if (this->pixelGetFunction == nullptr || this->pixelSetFunction == nullptr)
+            {
+                const char* formatName = love::GetPixelFormatName(this->format);
+                throw love::Exception("ImageData:%s does not support the %s pixel format",
+                                      function, formatName);
+            }
+        }
+
+        /*
+        ** Runs @func(first, last) over the rows [first, last) of a region @width pixels wide
+        ** and @height rows high, split across threads once the region is large enough.
+        */
+        template<typename F>
+        static void ForEachRow(int width, int height, const F& func)
+        {
+            love::ParallelFor(height, width * height >= THREAD_THRESHOLD, func);
+        }
+
+        /*
+        ** Runs @func on the color of every pixel in @rect, writing the result back.
+        ** The lock is taken once for the whole region.
+        */
+        template<typename F>
+        void MapColor(const Rect& rect, const char* function, F&& func)
+        {
+            this->CheckRegion(rect, function);
+            this->CheckColorFunctions(function);
+
+            std::unique_lock lock(this->mutex);
+
+            ForEachRow(rect.w, rect.h, [&](int first, int last) {
+                for (int y = rect.y + first; y < rect.y + last; y++)
+                {
+                    for (int x = rect.x; x < rect.x + rect.w; x++)
+                    {
+                        auto* pixel = (Pixel*)this->GetPixelAddress(x, y);
+
+                        Color color {};
+                        this->pixelGetFunction(pixel, color);
+
+                        func(color);
+
+                        this->pixelSetFunction(color, pixel);
+                    }
+                }
+            });
+        }
+
+        void Fill(const Color& color, const Rect& rect)
+        {
+            this->CheckRegion(rect, "fill");
+
+            if (this->pixelSetFunction == nullptr)
+            {
+                const char* formatName = love::GetPixelFormatName(this->format);
+                throw love::Exception("ImageData:fill does not support the %s pixel format",
+                                      formatName);
+            }
+
+            /* encode the color once, then copy the raw pixel */
+            Pixel pixel {};
+            this->pixelSetFunction(color, &pixel);
+
+            const size_t size = this->GetPixelSize();
+            std::unique_lock lock(this->mutex);
+
+            ForEachRow(rect.w, rect.h, [&](int first, int last) {
+                for (int y = rect.y + first; y < rect.y + last; y++)
+                {
+                    for (int x = rect.x; x < rect.x + rect.w; x++)
+                        std::memcpy(this->GetPixelAddress(x, y), &pixel, size);
+                }
+            });
+        }
+
+        void PremultiplyAlpha(const Rect& rect)
+        {
+            this->MapColor(rect, "premultiplyAlpha", [](Color& color) {
+                color.r *= color.a;
+                color.g *= color.a;
+                color.b *= color.a;
+            });
+        }
+
+        void UnpremultiplyAlpha(const Rect& rect)
+        {
+            this->MapColor(rect, "unpremultiplyAlpha", [](Color& color) {
+                if (color.a <= 0.0f)
+                    return;
+
+                color.r /= color.a;
+                color.g /= color.a;
+                color.b /= color.a;
+            });
+        }
+
+        /* @matrix is row-major: each output channel is a row dotted with (r, g, b, a) */
+        void TransformColor(const std::array<float, 16>& matrix, const Rect& rect)
+        {
+            this->MapColor(rect, "transformColor", [&matrix](Color& color) {
+                const std::array<float, 4> in = color.array();
+                std::array<float, 4> out {};
+
+                for (int row = 0; row < 4; row++)
+                {
+                    const float* m = &matrix[row * 4];
+                    out[row]       = m[0] * in[0] + m[1] * in[1] + m[2] * in[2] + m[3] * in[3];
+                }
+
+                color = Color(out[0], out[1], out[2], out[3]);
+            });
+        }
+
+        /* @order holds, for each output channel, the index of the input channel */
+        void SwizzleChannels(const std::array<int, 4>& order, const Rect& rect)
+        {
+            this->MapColor(rect, "swizzle", [&order](Color& color) {
+                const std::array<float, 4> in = color.array();
+                color = Color(in[order[0]], in[order[1]], in[order[2]], in[order[3]]);
+            });
+        }
+
+        void Flip(bool horizontal, bool vertical, const Rect& rect)
+        {
+            this->CheckRegion(rect, "flip");
+
+            const size_t size = this->GetPixelSize();
+
+            const auto swap = [size](uint8_t* first, uint8_t* second) {
+                Pixel temp {};
+
+                std::memcpy(&temp, first, size);
+                std::memcpy(first, second, size);
+                std::memcpy(second, &temp, size);
+            };
+
+            std::unique_lock lock(this->mutex);
+
+            if (vertical)
+            {
+                const int bottom = rect.y + rect.h - 1;
+
+                ForEachRow(rect.w, rect.h / 2, [&](int first, int last) {
+                    /* rows are contiguous unless tiled, so swap them whole */
+                    const size_t pitch = rect.w * size;
+                    std::unique_ptr<uint8_t[]> row;
+
+                    if (!Console::Is(Console::CTR))
+                        row = std::make_unique<uint8_t[]>(pitch);
+
+                    for (int y = rect.y + first; y < rect.y + last; y++)
+                    {
+                        const int other = bottom - (y - rect.y);
+
+                        if (row)
+                        {
+                            uint8_t* top  = this->GetPixelAddress(rect.x, y);
+                            uint8_t* down = this->GetPixelAddress(rect.x, other);
+
+                            std::memcpy(row.get(), top, pitch);
+                            std::memcpy(top, down, pitch);
+                            std::memcpy(down, row.get(), pitch);
+
+                            continue;
+                        }
+
+                        for (int x = rect.x; x < rect.x + rect.w; x++)
+                            swap(this->GetPixelAddress(x, y), this->GetPixelAddress(x, other));
+                    }
+                });
+            }
+
+            if (horizontal)
+            {
+                const int right = rect.x + rect.w - 1;
+
+                ForEachRow(rect.w, rect.h, [&](int first, int last) {
+                    for (int y = rect.y + first; y < rect.y + last; y++)
+                    {
+                        for (int x = rect.x; x < rect.x + rect.w / 2; x++)
+                        {
+                            const int other = right - (x - rect.x);
+                            swap(this->GetPixelAddress(x, y), this->GetPixelAddress(other, y));
+                        }
+                    }
+                });
+            }
+        }
+
+        /*
+        ** Writes the image turned clockwise by @turns quarter turns into @destination, which
+        ** must already have the turned dimensions and the same format.
+        */
+        void Rotate(int turns, ImageData* destination) const
+        {
+            turns = ((turns % 4) + 4) % 4;
+
+            const int width  = destination->GetWidth();
+            const int height = destination->GetHeight();
+
+            const bool sideways = turns % 2 != 0;
+
+            if (destination->GetFormat() != this->format ||
+                width != (sideways ? this->height : this->width) ||
+                height != (sideways ? this->width : this->height))
+            {
+                throw love::Exception("Rotated ImageData has the wrong format or dimensions.");
+            }
+
+            const size_t size = this->GetPixelSize();
+
+            std::unique_lock lock(this->mutex);
+            std::unique_lock other(destination->mutex);
+
+            ForEachRow(width, height, [&](int first, int last) {
+                for (int y = first; y < last; y++)
+                {
+                    for (int x = 0; x < width; x++)
+                    {
+                        int sourceX = x;
+                        int sourceY = y;
+
+                        if (turns == 1)
+                        {
+                            sourceX = y;
+                            sourceY = this->height - 1 - x;
+                        }
+                        else if (turns == 2)
+                        {
+                            sourceX = this->width - 1 - x;
+                            sourceY = this->height - 1 - y;
+                        }
+                        else if (turns == 3)
+                        {
+                            sourceX = this->width - 1 - y;
+                            sourceY = x;
+                        }
+
+                        std::memcpy(destination->GetPixelAddress(x, y),
+                                    this->GetPixelAddress(sourceX, sourceY), size);
+                    }
+                }
+            });
+        }
+
+        /*
+        ** Shrinks the image by @factor into @destination, which must be the image's size
+        ** divided by @factor (at least 1x1) in the same format. The box filter averages each
+        ** factor x factor block; the gaussian filter weighs a block twice as wide around it.
+        */
+        void Downscale(int factor, DownscaleFilter filter, ImageData* destination) const
+        {
+            this->CheckColorFunctions("downscale");
+
+            const int width  = destination->GetWidth();
+            const int height = destination->GetHeight();
+
+            if (factor < 1)
+                throw love::Exception("Downscale factor must be at least 1.");
+
+            if (destination->GetFormat() != this->format ||
+                width != std::max(this->width / factor, 1) ||
+                height != std::max(this->height / factor, 1))
+            {
+                throw love::Exception("Downscaled ImageData has the wrong format or dimensions.");
+            }
+
+            /* the gaussian's sigma is half a block, and its taps reach half a block past it */
+            const int radius = filter == DOWNSCALE_GAUSSIAN ? factor / 2 : 0;
+            const int taps   = factor + radius * 2;
+
+            std::vector<float> weights(taps, 1.0f);
+
+            if (filter == DOWNSCALE_GAUSSIAN)
+            {
+                const float center = (taps - 1) / 2.0f;
+                const float sigma  = std::max(factor / 2.0f, 0.5f);
+
+                for (int tap = 0; tap < taps; tap++)
+                {
+                    const float distance = (tap - center) / sigma;
+                    weights[tap]         = std::exp(-0.5f * distance * distance);
+                }
+            }
+
+            std::unique_lock lock(this->mutex);
+            std::unique_lock other(destination->mutex);
+
+            ForEachRow(width, height, [&](int first, int last) {
+                for (int y = first; y < last; y++)
+                {
+                    for (int x = 0; x < width; x++)
+                    {
+                        std::array<float, 4> sum {};
+                        float total = 0.0f;
+
+                        for (int j = 0; j < taps; j++)
+                        {
+                            const int sourceY = y * factor - radius + j;
+
+                            if (sourceY < 0 || sourceY >= this->height)
+                                continue;
+
+                            for (int i = 0; i < taps; i++)
+                            {
+                                const int sourceX = x * factor - radius + i;
+
+                                if (sourceX < 0 || sourceX >= this->width)
+                                    continue;
+
+                                const auto* pixel =
+                                    (const Pixel*)this->GetPixelAddress(sourceX, sourceY);
+
+                                Color color {};
+                                this->pixelGetFunction(pixel, color);
+
+                                const float weight = weights[i] * weights[j];
+                                const auto values  = color.array();
+
+                                for (size_t channel = 0; channel < sum.size(); channel++)
+                                    sum[channel] += values[channel] * weight;
+
+                                total += weight;
+                            }
+                        }
+
+                        Color color(sum[0] / total, sum[1] / total, sum[2] / total,
+                                    sum[3] / total);
+
+                        destination->pixelSetFunction(color,
+                                                      (Pixel*)destination->GetPixelAddress(x, y));
+                    }
+                }
+            });
+        }
+
         FileData* Encode(FormatHandler::EncodedFormat format, const char* filename,
-                         bool writeFile) const;
+                         bool writeFile,
+                         const FormatHandler::EncodeSettings& settings = {}) const;
+
+        /* block-compresses the pixels to @format; see BlockCompressor::IsSupported */
+        CompressedImageData* Compress(PixelFormat format) const;
 
         bool IsSRGB() const override
         {
@@ -419,6 +829,22 @@ namespace love
                     return getPixelRGBA8;
                 case PIXELFORMAT_RGBA16_UNORM:
                     return getPixelRGBA16;
+                case PIXELFORMAT_R8_UNORM:
+                    return getPixelConverted<PIXELFORMAT_R8_UNORM>;
+                case PIXELFORMAT_R16_UNORM:
+                    return getPixelConverted<PIXELFORMAT_R16_UNORM>;
+                case PIXELFORMAT_RG8_UNORM:
+                    return getPixelConverted<PIXELFORMAT_RG8_UNORM>;
+                case PIXELFORMAT_LA8_UNORM:
+                    return getPixelConverted<PIXELFORMAT_LA8_UNORM>;
+                case PIXELFORMAT_RG16_UNORM:
+                    return getPixelConverted<PIXELFORMAT_RG16_UNORM>;
+                case PIXELFORMAT_RGBA4_UNORM:
+                    return getPixelConverted<PIXELFORMAT_RGBA4_UNORM>;
+                case PIXELFORMAT_RGB5A1_UNORM:
+                    return getPixelConverted<PIXELFORMAT_RGB5A1_UNORM>;
+                case PIXELFORMAT_RGB565_UNORM:
+                    return getPixelConverted<PIXELFORMAT_RGB565_UNORM>;
                 default:
                     return nullptr;
             }
@@ -432,6 +858,22 @@ namespace love
                     return setPixelRGBA8;
                 case PIXELFORMAT_RGBA16_UNORM:
                     return setPixelRGBA16;
+                case PIXELFORMAT_R8_UNORM:
+                    return setPixelConverted<PIXELFORMAT_R8_UNORM>;
+                case PIXELFORMAT_R16_UNORM:
+                    return setPixelConverted<PIXELFORMAT_R16_UNORM>;
+                case PIXELFORMAT_RG8_UNORM:
+                    return setPixelConverted<PIXELFORMAT_RG8_UNORM>;
+                case PIXELFORMAT_LA8_UNORM:
+                    return setPixelConverted<PIXELFORMAT_LA8_UNORM>;
+                case PIXELFORMAT_RG16_UNORM:
+                    return setPixelConverted<PIXELFORMAT_RG16_UNORM>;
+                case PIXELFORMAT_RGBA4_UNORM:
+                    return setPixelConverted<PIXELFORMAT_RGBA4_UNORM>;
+                case PIXELFORMAT_RGB5A1_UNORM:
+                    return setPixelConverted<PIXELFORMAT_RGB5A1_UNORM>;
+                case PIXELFORMAT_RGB565_UNORM:
+                    return setPixelConverted<PIXELFORMAT_RGB565_UNORM>;
                 default:
                     return nullptr;
             }
@@ -447,6 +889,11 @@ namespace love
             "png", FormatHandler::ENCODED_PNG,
             "exr", FormatHandler::ENCODED_EXR
         };
+
+        static constexpr BidirectionalMap downscaleFilters = {
+            "box",      DOWNSCALE_BOX,
+            "gaussian", DOWNSCALE_GAUSSIAN
+        };
         // clang-format on
 
       protected:
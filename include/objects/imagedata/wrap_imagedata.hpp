@@ -27,6 +27,24 @@ namespace Wrap_ImageData
 
     int Encode(lua_State* L);
 
+    int Compress(lua_State* L);
+
+    int Fill(lua_State* L);
+
+    int PremultiplyAlpha(lua_State* L);
+
+    int UnpremultiplyAlpha(lua_State* L);
+
+    int TransformColor(lua_State* L);
+
+    int Swizzle(lua_State* L);
+
+    int Flip(lua_State* L);
+
+    int Rotate(lua_State* L);
+
+    int Downscale(lua_State* L);
+
     int __PerformAtomic(lua_State* L);
 
     int Register(lua_State* L);
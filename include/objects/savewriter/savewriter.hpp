@@ -0,0 +1,129 @@
+#pragma once
+
+#include <common/object.hpp>
+
+#include <utilities/bidirectionalmap/bidirectionalmap.hpp>
+#include <utilities/threads/threads.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace love
+{
+    class Filesystem;
+
+    /*
+    ** Buffers writes to one file in the save directory and leaves the storage writes to the
+    ** filesystem's I/O thread.
+    **
+    ** In append mode, data is appended once @bufferSize bytes are waiting (whole multiples of
+    ** @blockSize at a time, so flash sees few large writes), once the oldest waiting byte is
+    ** @interval seconds old, or when asked to flush. In atomic mode, everything written
+    ** since the last commit becomes the file's new contents on the next flush. The file is
+    ** written beside its destination and renamed over it, so a crash leaves either the old
+    ** save or the new one.
+    */
+    class SaveWriter : public Object
+    {
+      public:
+        static Type type;
+
+        enum Mode
+        {
+            MODE_APPEND,
+            MODE_ATOMIC,
+            MODE_MAX_ENUM
+        };
+
+        struct Settings
+        {
+            Mode mode         = MODE_APPEND;
+            size_t bufferSize = 0x10000;
+            size_t blockSize  = 0x1000;
+            double interval   = 1.0;
+        };
+
+        struct Stats
+        {
+            int64_t buffered;
+            int64_t written;
+            int64_t flushes;
+            int64_t commits;
+        };
+
+        SaveWriter(Filesystem* filesystem, const std::string& filename, const Settings& settings);
+
+        virtual ~SaveWriter();
+
+        /* true when enough is now buffered that the I/O thread should be woken */
+        bool Write(const void* data, size_t size);
+
+        /* the next Poll flushes everything, whatever the policy says */
+        void RequestFlush();
+
+        /* writes out whatever the policy says is due; @force writes out everything */
+        void Poll(bool force);
+
+        Stats GetStats() const;
+
+        /* the last error from writing to storage, if any */
+        std::string GetError() const;
+
+        const std::string& GetFilename() const
+        {
+            return this->filename;
+        }
+
+        Mode GetMode() const
+        {
+            return this->settings.mode;
+        }
+
+        bool IsClosed() const
+        {
+            return this->closed;
+        }
+
+        void SetClosed()
+        {
+            this->closed = true;
+        }
+
+        // clang-format off
+        static constexpr BidirectionalMap modes = {
+            "append", MODE_APPEND,
+            "atomic", MODE_ATOMIC
+        };
+        // clang-format on
+
+      private:
+        using Clock = std::chrono::steady_clock;
+
+        /* how much of the buffer is due to be written, with mutex held */
+        size_t GetDueSize(bool force) const;
+
+        Filesystem* filesystem;
+        std::string filename;
+        Settings settings;
+
+        std::vector<uint8_t> buffer;
+        Clock::time_point bufferedSince;
+
+        bool dirty;
+        bool flushRequested;
+        std::atomic<bool> closed;
+
+        std::string error;
+
+        std::atomic<int64_t> written;
+        std::atomic<int64_t> flushes;
+        std::atomic<int64_t> commits;
+
+        /* guards the buffer; ioMutex keeps flushes in order while writes carry on */
+        mutable love::mutex mutex;
+        love::mutex ioMutex;
+    };
+} // namespace love
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <common/luax.hpp>
+#include <objects/savewriter/savewriter.hpp>
+
+namespace Wrap_SaveWriter
+{
+    int Close(lua_State* L);
+
+    int Flush(lua_State* L);
+
+    int GetError(lua_State* L);
+
+    int GetFilename(lua_State* L);
+
+    int GetMode(lua_State* L);
+
+    int GetStats(lua_State* L);
+
+    int IsClosed(lua_State* L);
+
+    int Write(lua_State* L);
+
+    love::SaveWriter* CheckSaveWriter(lua_State* L, int index);
+
+    int Register(lua_State* L);
+} // namespace Wrap_SaveWriter
@@ -4,6 +4,7 @@
 #include <common/drawable.hpp>
 #include <common/exception.hpp>
 #include <common/math.hpp>
+#include <common/memorystats.hpp>
 #include <common/object.hpp>
 #include <common/strongreference.hpp>
 
@@ -13,6 +14,7 @@
 
 #include <utilities/bidirectionalmap/bidirectionalmap.hpp>
 #include <utilities/driver/renderer/samplerstate.hpp>
+#include <utilities/mipmapper.hpp>
 
 #include <algorithm>
 #include <stddef.h>
@@ -77,6 +79,7 @@ namespace love
             bool renderTarget   = false;
             bool computeWrite   = false;
             int mipmapCount     = 0;
+            bool clear          = true; // false if the creator locks and fills every pixel
             std::optional<bool> readable;
         };
 
@@ -296,6 +299,7 @@ namespace love
             renderTarget(settings.renderTarget),
             readable(true),
             sRGB(false),
+            clearOnCreate(settings.clear),
             width(settings.width),
             height(settings.height),
             depth(settings.type == TEXTURE_VOLUME ? settings.layers : 1),
@@ -307,6 +311,8 @@ namespace love
             actualSamples(1),
             state {},
             graphicsMemorySize(0),
+            memoryCategory(settings.renderTarget ? MemoryStats::CATEGORY_RENDER_TARGET
+                                                 : MemoryStats::CATEGORY_TEXTURE),
             slices(settings.type)
         {
             if (data != nullptr && data->GetMipmapCount() > 0 && data->GetSliceCount() > 0)
@@ -463,6 +469,20 @@ namespace love
             return this->renderTarget;
         }
 
+        /* moves the bytes this texture holds over to @category's tally */
+        void SetMemoryCategory(MemoryStats::Category category)
+        {
+            MemoryStats::Remove(this->memoryCategory, this->graphicsMemorySize);
+            MemoryStats::Add(category, this->graphicsMemorySize);
+
+            this->memoryCategory = category;
+        }
+
+        MemoryStats::Category GetMemoryCategory() const
+        {
+            return this->memoryCategory;
+        }
+
         bool IsValidSlice(int slice, int mipmap) const
         {
             return slice >= 0 && slice < this->GetSliceCount(mipmap);
@@ -554,15 +574,79 @@ namespace love
             this->SetSamplerState(this->state);
         }
 
+        /* levels are generated on the CPU, which needs pixels we can read and filter */
+        bool CanGenerateMipmaps() const
+        {
+            return this->readable && !this->renderTarget && Mipmapper::IsSupported(this->format);
+        }
+
+        /* mipmaps were requested but only the base level was supplied */
+        bool NeedsMipmapGeneration() const
+        {
+            return this->GetMipmapCount() > 1 && this->slices.GetMipmapCount(0) <= 1;
+        }
+
+        void CheckGenerateMipmaps() const
+        {
+            if (this->GetMipmapCount() == 1 || this->mipmapMode == MIPMAPS_NONE)
+            {
+                throw love::Exception("generateMipmaps can only be called on a Texture which "
+                                      "was created with mipmaps enabled.");
+            }
+
+            if (this->IsCompressed())
+                throw love::Exception("generateMipmaps cannot be called on a compressed Texture.");
+
+            if (!this->CanGenerateMipmaps())
+            {
+                const char* name = love::GetPixelFormatName(this->format);
+                throw love::Exception("generateMipmaps is not supported for %s Textures.", name);
+            }
+        }
+
+        /*
+        ** Filters mipmap levels 1 and up from @source, the RGBA8 pixels of a @width x @height
+        ** base level, handing each one to @upload(mipmap, pixels, width, height).
+        */
+        template<typename Upload>
+        void GenerateMipmapLevels(const uint8_t* source, int width, int height, size_t pitch,
+                                  Mipmapper::Filter filter, Upload&& upload) const
+        {
+            const bool sRGB = love::IsPixelFormatSRGB(this->format);
+            std::unique_ptr<uint8_t[]> previous;
+
+            for (int mipmap = 1; mipmap < this->GetMipmapCount(); mipmap++)
+            {
+                const int levelWidth  = Mipmapper::GetLevelSize(width);
+                const int levelHeight = Mipmapper::GetLevelSize(height);
+                const size_t rowSize  = levelWidth * Mipmapper::CHANNELS;
+
+                auto level = std::make_unique<uint8_t[]>(rowSize * levelHeight);
+
+                Mipmapper::Downsample(source, width, height, pitch, level.get(), rowSize, filter,
+                                      sRGB);
+
+                upload(mipmap, level.get(), levelWidth, levelHeight);
+
+                previous = std::move(level);
+                source   = previous.get();
+                pitch    = rowSize;
+                width    = levelWidth;
+                height   = levelHeight;
+            }
+        }
+
         void SetGraphicsMemorySize(int64_t bytes)
         {
             totalGraphicsMemory =
                 std::max<int64_t>(totalGraphicsMemory - this->graphicsMemorySize, 0);
+            MemoryStats::Remove(this->memoryCategory, this->graphicsMemorySize);
 
             bytes                    = std::max<int64_t>(bytes, 0);
             this->graphicsMemorySize = bytes;
 
             totalGraphicsMemory += bytes;
+            MemoryStats::Add(this->memoryCategory, bytes);
         }
 
         TextureType textureType;
@@ -572,6 +656,7 @@ namespace love
         bool renderTarget;
         bool readable;
         bool sRGB;
+        bool clearOnCreate;
 
         int width;
         int height;
@@ -590,6 +675,7 @@ namespace love
 
         StrongReference<Quad> quad;
         int64_t graphicsMemorySize;
+        MemoryStats::Category memoryCategory;
         Slices slices;
     };
 } // namespace love
@@ -34,6 +34,8 @@ namespace love
       private:
         void OnError();
 
+        int Load(lua_State* L);
+
         StrongReference<Data> code;
         std::string name;
         std::string error;
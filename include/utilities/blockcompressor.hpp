@@ -0,0 +1,30 @@
+#pragma once
+
+#include <common/pixelformat.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** Runtime encoder for 4x4 block-compressed formats: ETC1, ETC2 RGB/RGBA (EAC alpha),
+** DXT1 (BC1) and DXT5 (BC3). It is a fast single-pass encoder, not an exhaustive one:
+** endpoints come from subblock averages (ETC) or the principal axis of the block (DXT),
+** and only the per-pixel indices are searched. Large images are split into bands of
+** block rows that are encoded on worker threads.
+*/
+namespace love::BlockCompressor
+{
+    /* images with at least this many pixels are split across threads */
+    static constexpr int THREAD_THRESHOLD = 0x80 * 0x80;
+
+    bool IsSupported(PixelFormat format);
+
+    /*
+    ** Encodes the RGBA8 image @source (@width x @height, @pitch bytes per row) to @format.
+    ** @destination must hold GetPixelFormatSliceSize(format, width, height, false) bytes.
+    ** Edge blocks of images that aren't a multiple of four repeat their last row/column.
+    ** DXT1 output is opaque: alpha is dropped.
+    */
+    void Compress(PixelFormat format, const uint8_t* source, int width, int height, size_t pitch,
+                  uint8_t* destination);
+} // namespace love::BlockCompressor
@@ -21,6 +21,9 @@ namespace love
         static inline float gpuTime = 0.0f;
         static inline float cpuTime = 0.0f;
 
+        /* seconds the last Graphics::Present spent in the driver, vsync wait included */
+        static inline double presentTime = 0.0;
+
         struct Info
         {
             std::string_view name;
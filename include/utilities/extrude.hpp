@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** Writes an image into an atlas cell with @extrude copies of each of its edge pixels all the
+** way around, so filtering at the image border samples the image and not its neighbours.
+*/
+namespace love::Extrude
+{
+    /*
+    ** Fills a (@width + 2 * @extrude) x (@height + 2 * @extrude) cell at @pixels, @pitch bytes
+    ** per row. @getRow(y) returns row y of the image, @width pixels of @pixelSize bytes each
+    ** already in the cell's format; the rows above and below repeat the first and last one.
+    */
+    template<typename F>
+    void WriteCell(uint8_t* pixels, size_t pitch, int width, int height, int extrude,
+                   size_t pixelSize, F getRow)
+    {
+        const int rows = height + extrude * 2;
+
+        for (int row = 0; row < rows; row++)
+        {
+            const uint8_t* source = getRow(std::clamp(row - extrude, 0, height - 1));
+            const uint8_t* last   = source + (width - 1) * pixelSize;
+
+            uint8_t* destination = pixels + row * pitch;
+            std::memcpy(destination + extrude * pixelSize, source, width * pixelSize);
+
+            for (int column = 0; column < extrude; column++)
+            {
+                std::memcpy(destination + column * pixelSize, source, pixelSize);
+                std::memcpy(destination + (extrude + width + column) * pixelSize, last, pixelSize);
+            }
+        }
+    }
+} // namespace love::Extrude
@@ -8,6 +8,11 @@
 
 #include <objects/data/bytedata/bytedata.hpp>
 
+#include <utilities/threads/threads.hpp>
+
+#include <functional>
+#include <list>
+
 namespace love
 {
     class CompressedSlice;
@@ -22,6 +27,19 @@ namespace love
             ENCODED_EXR
         };
 
+        /* container formats that can be told apart by their first few bytes */
+        enum Signature
+        {
+            SIGNATURE_UNKNOWN,
+            SIGNATURE_PNG,
+            SIGNATURE_JPG,
+            SIGNATURE_DDS,
+            SIGNATURE_KTX,
+            SIGNATURE_PKM,
+            SIGNATURE_ASTC,
+            SIGNATURE_MAX_ENUM
+        };
+
         struct DecodedImage
         {
             PixelFormat format = PIXELFORMAT_RGBA8_UNORM;
@@ -29,24 +47,87 @@ namespace love
             int height         = 0;
             size_t size        = 0;
             std::unique_ptr<uint8_t[]> data;
+
+            /* borrowed pixels, used by encoders when @data is not set */
+            const uint8_t* view = nullptr;
+
+            const uint8_t* GetPixels() const
+            {
+                return this->data ? this->data.get() : this->view;
+            }
         };
 
+        /*
+        ** Receives the decoded dimensions and format of an image (with no pixels) and
+        ** returns where its first row should be written, setting @pitch to the row stride
+        ** in bytes if it differs from a tightly packed row.
+        */
+        using DecodeTarget = std::function<uint8_t*(const DecodedImage& info, size_t& pitch)>;
+
         struct EncodedImage
         {
             size_t size                     = 0;
             std::unique_ptr<uint8_t[]> data = nullptr;
+
+            /* bytes allocated for @data, which may run past @size */
+            size_t capacity = 0;
+
+            void Reserve(size_t capacity);
+
+            /* grows @data by half again whenever @bytes don't fit */
+            void Append(const uint8_t* bytes, size_t count);
         };
 
+        /* trades file size for encoding speed; the defaults are the encoder library's own */
+        struct EncodeSettings
+        {
+            int compressionLevel = -1; /* 0 to 9, or -1 for the library default */
+            bool fastFilters     = false; /* Sub and Up row filters only, instead of adaptive */
+        };
+
+        /* receives encoded bytes as they are produced; may throw to abort the encode */
+        using EncodeTarget = std::function<void(const uint8_t* bytes, size_t size)>;
+
         virtual ~FormatHandler()
         {}
 
+        static Signature Sniff(Data* data);
+
+        static const char* GetSignatureName(Signature signature);
+
+        /*
+        ** Picks the handler for @data by its header signature. Handlers without a
+        ** signature (e.g. t3x) are only probed when no signed handler claims the data.
+        */
+        static FormatHandler* Find(const std::list<FormatHandler*>& handlers, Data* data,
+                                   bool compressed);
+
+        virtual Signature GetSignature() const
+        {
+            return SIGNATURE_UNKNOWN;
+        }
+
         virtual bool CanDecode(Data* data);
 
         virtual bool CanEncode(PixelFormat format, EncodedFormat encodedFormat);
 
         virtual DecodedImage Decode(Data* data);
 
-        virtual EncodedImage Encode(const DecodedImage& image, EncodedFormat format);
+        /*
+        ** Decodes @data straight into memory provided by @target, skipping the heap copy
+        ** made by Decode. Returns false, without touching @target, if unsupported.
+        */
+        virtual bool DecodeInto(Data* data, const DecodeTarget& target);
+
+        virtual EncodedImage Encode(const DecodedImage& image, EncodedFormat format,
+                                    const EncodeSettings& settings);
+
+        /*
+        ** Encodes @image in pieces handed to @target as the encoder produces them, so they
+        ** can be written out while the rest is compressed. Returns false if unsupported.
+        */
+        virtual bool EncodeInto(const DecodedImage& image, EncodedFormat format,
+                                const EncodeSettings& settings, const EncodeTarget& target);
 
         virtual bool CanParseCompressed(Data* data);
 
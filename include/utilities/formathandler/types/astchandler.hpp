@@ -19,6 +19,11 @@ namespace love
         virtual ~ASTCHandler()
         {}
 
+        Signature GetSignature() const override
+        {
+            return SIGNATURE_ASTC;
+        }
+
         bool CanParseCompressed(Data* data) override;
 
         StrongReference<ByteData> ParseCompressed(
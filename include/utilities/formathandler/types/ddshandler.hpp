@@ -10,6 +10,11 @@ namespace love
         virtual ~DDSHandler()
         {}
 
+        Signature GetSignature() const override
+        {
+            return SIGNATURE_DDS;
+        }
+
         bool CanDecode(Data* data) override;
 
         DecodedImage Decode(Data* data) override;
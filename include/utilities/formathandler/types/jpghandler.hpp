@@ -7,8 +7,15 @@ namespace love
     class JPGHandler : public FormatHandler
     {
       public:
+        virtual Signature GetSignature() const
+        {
+            return SIGNATURE_JPG;
+        }
+
         virtual bool CanDecode(Data* data);
 
         virtual DecodedImage Decode(Data* data);
+
+        virtual bool DecodeInto(Data* data, const DecodeTarget& target);
     };
 } // namespace love
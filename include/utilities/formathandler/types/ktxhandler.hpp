@@ -67,6 +67,11 @@ namespace love
         virtual ~KTXHandler()
         {}
 
+        Signature GetSignature() const override
+        {
+            return SIGNATURE_KTX;
+        }
+
         bool CanParseCompressed(Data* data) override;
 
         StrongReference<ByteData> ParseCompressed(
@@ -37,6 +37,11 @@ namespace love
         {}
 
         // Implements FormatHandler.
+        Signature GetSignature() const override
+        {
+            return SIGNATURE_PKM;
+        }
+
         bool CanParseCompressed(Data* data) override;
 
         StrongReference<ByteData> ParseCompressed(
@@ -7,12 +7,23 @@ namespace love
     class PNGHandler : public FormatHandler
     {
       public:
+        virtual Signature GetSignature() const
+        {
+            return SIGNATURE_PNG;
+        }
+
         virtual bool CanDecode(Data* data);
 
         virtual DecodedImage Decode(Data* data);
 
+        virtual bool DecodeInto(Data* data, const DecodeTarget& target);
+
         virtual bool CanEncode(PixelFormat rawFormat, EncodedFormat encodedFormat);
 
-        virtual EncodedImage Encode(const DecodedImage& image, EncodedFormat format);
+        virtual EncodedImage Encode(const DecodedImage& image, EncodedFormat format,
+                                    const EncodeSettings& settings);
+
+        virtual bool EncodeInto(const DecodedImage& image, EncodedFormat format,
+                                const EncodeSettings& settings, const EncodeTarget& target);
     };
 } // namespace love
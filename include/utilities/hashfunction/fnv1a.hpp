@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace love
+{
+    /*
+    ** 64-bit FNV-1a. Not cryptographic, but cheap enough to key caches on whole source
+    ** files; chain calls by passing the previous result as @hash.
+    */
+    static constexpr uint64_t FNV1A_OFFSET = 0xCBF29CE484222325ULL;
+    static constexpr uint64_t FNV1A_PRIME  = 0x100000001B3ULL;
+
+    inline uint64_t FNV1a(const void* data, size_t size, uint64_t hash = FNV1A_OFFSET)
+    {
+        const auto* bytes = (const uint8_t*)data;
+
+        for (size_t index = 0; index < size; index++)
+            hash = (hash ^ bytes[index]) * FNV1A_PRIME;
+
+        return hash;
+    }
+} // namespace love
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstring>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace love
+{
+    /*
+    ** The state behind File:lines. Bytes are read into one reusable buffer and lines are
+    ** found with memchr, so nothing is copied until a line is handed out. It knows nothing of
+    ** Lua: what happens to a line that fills the whole buffer is up to the caller, which
+    ** either spills it somewhere else or grows the buffer.
+    */
+    struct LineReader
+    {
+        enum Step
+        {
+            STEP_LINE,   /* a line was found */
+            STEP_REFILL, /* the buffer needs more data */
+            STEP_FULL,   /* the buffer is full and holds no line end */
+            STEP_END     /* every line has been handed out */
+        };
+
+        size_t start;     /* first unread byte in the buffer */
+        size_t end;       /* one past the last buffered byte */
+        int64_t position; /* where reading resumes when the caller's position is restored */
+        bool seekBack;
+        bool slices;
+        bool eof;
+
+        /*
+        ** Looks for the next line in the @size byte buffer at @data. On STEP_LINE, @offset and
+        ** @length locate the line without its \n or \r\n. Before STEP_REFILL, unread bytes are
+        ** moved to the front of the buffer to make room.
+        */
+        Step Next(char* data, size_t size, size_t& offset, size_t& length)
+        {
+            char* begin        = data + this->start;
+            const size_t count = this->end - this->start;
+
+            const auto* newline = (const char*)std::memchr(begin, '\n', count);
+
+            if (newline != nullptr || (this->eof && count > 0))
+            {
+                length = (newline != nullptr) ? newline - begin : count;
+                offset = this->start;
+
+                this->start += (newline != nullptr) ? length + 1 : length;
+
+                if (length > 0 && begin[length - 1] == '\r')
+                    --length;
+
+                return STEP_LINE;
+            }
+
+            if (this->eof)
+                return STEP_END;
+
+            if (this->start == 0 && this->end == size)
+                return STEP_FULL;
+
+            if (this->start > 0)
+            {
+                std::memmove(data, begin, count);
+
+                this->start = 0;
+                this->end   = count;
+            }
+
+            return STEP_REFILL;
+        }
+
+        /* how much of a full buffer can be spilled, holding back a \r the next \n may end */
+        size_t GetSpillSize(const char* data) const
+        {
+            return (data[this->end - 1] == '\r') ? this->end - 1 : this->end;
+        }
+
+        /* drops the first @count bytes of the buffer once they have been spilled */
+        void Discard(char* data, size_t count)
+        {
+            std::memmove(data, data + count, this->end - count);
+            this->end -= count;
+        }
+
+        /* reads from @file into the free end of the buffer; false on a read error */
+        template<typename F>
+        bool Refill(F* file, char* data, size_t size)
+        {
+            int64_t userPosition = -1;
+
+            /* reading must not move the position seen by code that opened the file itself */
+            if (this->seekBack)
+            {
+                userPosition = file->Tell();
+
+                if (userPosition != this->position)
+                    file->Seek(this->position);
+            }
+
+            const int64_t read = file->Read(data + this->end, size - this->end);
+
+            if (read < 0)
+                return false;
+
+            this->end += read;
+            this->eof = read == 0 || file->IsEOF();
+
+            if (this->seekBack)
+            {
+                this->position += read;
+                file->Seek(userPosition);
+            }
+
+            return true;
+        }
+    };
+} // namespace love
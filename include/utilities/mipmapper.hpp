@@ -0,0 +1,303 @@
+#pragma once
+
+#include <common/pixelformat.hpp>
+
+#include <utilities/bidirectionalmap/bidirectionalmap.hpp>
+#include <utilities/threads/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** CPU mipmap generation for RGBA8 textures. Every level is made from the one above it with
+** either a 2x2 box filter or a separable 6-tap Kaiser-windowed sinc. The box filter works
+** on plain bytes with no per-channel branches so the compiler can vectorize it, and sRGB
+** levels are filtered in linear space through lookup tables. Large levels are split into
+** bands of rows that are filtered on worker threads.
+*/
+namespace love::Mipmapper
+{
+    enum Filter
+    {
+        FILTER_BOX,
+        FILTER_KAISER,
+        FILTER_MAX_ENUM
+    };
+
+    // clang-format off
+    static constexpr BidirectionalMap filters = {
+        "box",    FILTER_BOX,
+        "kaiser", FILTER_KAISER
+    };
+    // clang-format on
+
+    /* destination levels with at least this many pixels are split across threads */
+    static constexpr int THREAD_THRESHOLD = 0x100 * 0x100;
+
+    static constexpr int CHANNELS = 0x04;
+    static constexpr int TAPS     = 0x06;
+
+    inline bool IsSupported(PixelFormat format)
+    {
+        return format == PIXELFORMAT_RGBA8_UNORM || format == PIXELFORMAT_RGBA8_UNORM_SRGB;
+    }
+
+    namespace detail
+    {
+        /* 16-bit linear values for each sRGB byte, and sRGB bytes for 12-bit linear values */
+        struct SRGBTables
+        {
+            std::array<uint16_t, 0x100> toLinear;
+            std::array<uint8_t, 0x1000> toSRGB;
+        };
+
+        inline const SRGBTables& GetSRGBTables()
+        {
+            static const SRGBTables tables = []() {
+                SRGBTables result {};
+
+                for (size_t index = 0; index < result.toLinear.size(); index++)
+                {
+                    const float value = index / 255.0f;
+                    const float linear =
+                        value <= 0.04045f ? value / 12.92f
+                                          : std::pow((value + 0.055f) / 1.055f, 2.4f);
+
+                    result.toLinear[index] = (uint16_t)std::lround(linear * 65535.0f);
+                }
+
+                for (size_t index = 0; index < result.toSRGB.size(); index++)
+                {
+                    const float value = index / 4095.0f;
+                    const float srgb  = value <= 0.0031308f
+                                            ? value * 12.92f
+                                            : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+
+                    result.toSRGB[index] = (uint8_t)std::lround(srgb * 255.0f);
+                }
+
+                return result;
+            }();
+
+            return tables;
+        }
+
+        inline double BesselI0(double x)
+        {
+            double sum  = 1.0;
+            double term = 1.0;
+
+            for (int k = 1; k < 0x20; k++)
+            {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        /*
+        ** Weights for the source pixels at -2.5 .. +2.5 around the centre of a destination
+        ** pixel: sinc(d / 2) windowed by a Kaiser window of radius 3 (beta = 4).
+        */
+        inline const std::array<float, TAPS>& GetKaiserWeights()
+        {
+            static const std::array<float, TAPS> weights = []() {
+                constexpr double PI     = 3.14159265358979323846;
+                constexpr double BETA   = 4.0;
+                constexpr double RADIUS = 3.0;
+
+                std::array<float, TAPS> result {};
+                double total = 0.0;
+
+                for (int tap = 0; tap < TAPS; tap++)
+                {
+                    const double distance = tap - 2.5;
+                    const double x        = PI * distance / 2.0;
+                    const double sinc     = std::sin(x) / x;
+
+                    const double ratio  = distance / RADIUS;
+                    const double window = BesselI0(BETA * std::sqrt(1.0 - ratio * ratio));
+
+                    result[tap] = (float)(sinc * window / BesselI0(BETA));
+                    total += result[tap];
+                }
+
+                for (auto& weight : result)
+                    weight = (float)(weight / total);
+
+                return result;
+            }();
+
+            return weights;
+        }
+
+        struct Job
+        {
+            const uint8_t* source;
+            int width;
+            int height;
+            size_t pitch;
+
+            uint8_t* destination;
+            int destinationWidth;
+            size_t destinationPitch;
+
+            bool sRGB;
+        };
+
+        inline void BoxRows(const Job& job, int first, int last)
+        {
+            const auto& tables = GetSRGBTables();
+
+            for (int y = first; y < last; y++)
+            {
+                const uint8_t* top    = job.source + (y * 2) * job.pitch;
+                const int below       = std::min(y * 2 + 1, job.height - 1);
+                const uint8_t* bottom = job.source + below * job.pitch;
+                uint8_t* row          = job.destination + y * job.destinationPitch;
+
+                /* a one pixel wide source has nothing to pair with horizontally */
+                const int step = job.width > 1 ? CHANNELS : 0;
+
+                if (!job.sRGB)
+                {
+                    for (int x = 0; x < job.destinationWidth; x++)
+                    {
+                        const int left = x * CHANNELS * 2;
+
+                        for (int c = 0; c < CHANNELS; c++)
+                        {
+                            const uint32_t sum = top[left + c] + top[left + step + c] +
+                                                 bottom[left + c] + bottom[left + step + c];
+
+                            row[x * CHANNELS + c] = (uint8_t)((sum + 2) >> 2);
+                        }
+                    }
+
+                    continue;
+                }
+
+                for (int x = 0; x < job.destinationWidth; x++)
+                {
+                    const int left = x * CHANNELS * 2;
+
+                    for (int c = 0; c < CHANNELS; c++)
+                    {
+                        const int a = left + c;
+                        const int b = left + step + c;
+
+                        if (c == CHANNELS - 1)
+                        {
+                            const uint32_t sum = top[a] + top[b] + bottom[a] + bottom[b];
+                            row[x * CHANNELS + c] = (uint8_t)((sum + 2) >> 2);
+
+                            continue;
+                        }
+
+                        const uint32_t sum = tables.toLinear[top[a]] + tables.toLinear[top[b]] +
+                                             tables.toLinear[bottom[a]] +
+                                             tables.toLinear[bottom[b]];
+
+                        /* average of four 16-bit values, scaled to the 12-bit table index */
+                        const uint32_t index = (sum * 0xFFF + 0x1FFFE) / (0xFFFF * 4);
+                        row[x * CHANNELS + c] = tables.toSRGB[index];
+                    }
+                }
+            }
+        }
+
+        inline void KaiserRows(const Job& job, int first, int last)
+        {
+            const auto& tables  = GetSRGBTables();
+            const auto& weights = GetKaiserWeights();
+
+            std::vector<float> column(job.width * CHANNELS);
+
+            const auto load = [&](uint8_t value, int channel) {
+                if (job.sRGB && channel != CHANNELS - 1)
+                    return tables.toLinear[value] / 65535.0f;
+
+                return value / 255.0f;
+            };
+
+            const auto store = [&](float value, int channel) {
+                value = std::clamp(value, 0.0f, 1.0f);
+
+                if (job.sRGB && channel != CHANNELS - 1)
+                    return tables.toSRGB[(int)(value * 4095.0f + 0.5f)];
+
+                return (uint8_t)(value * 255.0f + 0.5f);
+            };
+
+            for (int y = first; y < last; y++)
+            {
+                /* vertical pass into one row of floats */
+                std::fill(column.begin(), column.end(), 0.0f);
+
+                for (int tap = 0; tap < TAPS; tap++)
+                {
+                    const int sourceY  = std::clamp(y * 2 - 2 + tap, 0, job.height - 1);
+                    const uint8_t* row = job.source + sourceY * job.pitch;
+
+                    for (int index = 0; index < job.width * CHANNELS; index++)
+                        column[index] += weights[tap] * load(row[index], index % CHANNELS);
+                }
+
+                /* horizontal pass into the destination row */
+                uint8_t* row = job.destination + y * job.destinationPitch;
+
+                for (int x = 0; x < job.destinationWidth; x++)
+                {
+                    std::array<float, CHANNELS> sum {};
+
+                    for (int tap = 0; tap < TAPS; tap++)
+                    {
+                        const int sourceX = std::clamp(x * 2 - 2 + tap, 0, job.width - 1);
+
+                        for (int c = 0; c < CHANNELS; c++)
+                            sum[c] += weights[tap] * column[sourceX * CHANNELS + c];
+                    }
+
+                    for (int c = 0; c < CHANNELS; c++)
+                        row[x * CHANNELS + c] = store(sum[c], c);
+                }
+            }
+        }
+    } // namespace detail
+
+    inline int GetLevelSize(int size)
+    {
+        return std::max(size / 2, 1);
+    }
+
+    /*
+    ** Filters the RGBA8 image @source (@width x @height, @pitch bytes per row) down to the
+    ** next mipmap level, written to @destination with @destinationPitch bytes per row.
+    */
+    inline void Downsample(const uint8_t* source, int width, int height, size_t pitch,
+                           uint8_t* destination, size_t destinationPitch, Filter filter, bool sRGB)
+    {
+        const int destinationWidth  = GetLevelSize(width);
+        const int destinationHeight = GetLevelSize(height);
+
+        const detail::Job job { source,      width,           height,          pitch,
+                                destination, destinationWidth, destinationPitch, sRGB };
+
+        const auto run = [job, filter](int first, int last) {
+            if (filter == FILTER_KAISER)
+                detail::KaiserRows(job, first, last);
+            else
+                detail::BoxRows(job, first, last);
+        };
+
+        const bool parallel = destinationWidth * destinationHeight >= THREAD_THRESHOLD;
+        love::ParallelFor(destinationHeight, parallel, run);
+    }
+} // namespace love::Mipmapper
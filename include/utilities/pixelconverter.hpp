@@ -0,0 +1,262 @@
+#pragma once
+
+#include <common/pixelformat.hpp>
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** Row-wise conversions between the uncompressed unorm pixel formats.
+** Every (source, destination) pair is its own template instance, so the
+** per-pixel load and store are inlined into one straight loop that the
+** compiler is free to vectorize. Packed and 16-bit formats use native
+** endianness, the same as ImageData::Pixel.
+*/
+namespace love::PixelConverter
+{
+    using RowFunction = void (*)(const void* source, void* destination, int width);
+
+    /* 16-bit unorm intermediate, wide enough for every supported format */
+    struct Channels
+    {
+        uint32_t r, g, b, a;
+    };
+
+    static constexpr uint32_t CHANNEL_MAX = 0xFFFF;
+
+    template<uint32_t Max>
+    inline constexpr uint32_t Expand(uint32_t value)
+    {
+        return (value * CHANNEL_MAX + Max / 2) / Max;
+    }
+
+    template<uint32_t Max>
+    inline constexpr uint32_t Reduce(uint32_t value)
+    {
+        return (value * Max + CHANNEL_MAX / 2) / CHANNEL_MAX;
+    }
+
+    // clang-format off
+    static constexpr std::array formats =
+    {
+        PIXELFORMAT_R8_UNORM,
+        PIXELFORMAT_R16_UNORM,
+        PIXELFORMAT_RG8_UNORM,
+        PIXELFORMAT_LA8_UNORM,
+        PIXELFORMAT_RG16_UNORM,
+        PIXELFORMAT_RGBA8_UNORM,
+        PIXELFORMAT_RGBA16_UNORM,
+        PIXELFORMAT_RGBA4_UNORM,
+        PIXELFORMAT_RGB5A1_UNORM,
+        PIXELFORMAT_RGB565_UNORM
+    };
+    // clang-format on
+
+    template<PixelFormat F>
+    inline Channels Load(const uint8_t* row, int index)
+    {
+        const auto* u16 = (const uint16_t*)row;
+
+        if constexpr (F == PIXELFORMAT_R8_UNORM)
+            return { Expand<0xFF>(row[index]), 0, 0, CHANNEL_MAX };
+        else if constexpr (F == PIXELFORMAT_R16_UNORM)
+            return { u16[index], 0, 0, CHANNEL_MAX };
+        else if constexpr (F == PIXELFORMAT_RG8_UNORM)
+        {
+            const uint8_t* pixel = row + index * 2;
+            return { Expand<0xFF>(pixel[0]), Expand<0xFF>(pixel[1]), 0, CHANNEL_MAX };
+        }
+        else if constexpr (F == PIXELFORMAT_LA8_UNORM)
+        {
+            const uint32_t luminance = Expand<0xFF>(row[index * 2]);
+            return { luminance, luminance, luminance, Expand<0xFF>(row[index * 2 + 1]) };
+        }
+        else if constexpr (F == PIXELFORMAT_RG16_UNORM)
+            return { u16[index * 2], u16[index * 2 + 1], 0, CHANNEL_MAX };
+        else if constexpr (F == PIXELFORMAT_RGBA8_UNORM)
+        {
+            const uint8_t* pixel = row + index * 4;
+            return { Expand<0xFF>(pixel[0]), Expand<0xFF>(pixel[1]), Expand<0xFF>(pixel[2]),
+                     Expand<0xFF>(pixel[3]) };
+        }
+        else if constexpr (F == PIXELFORMAT_RGBA16_UNORM)
+        {
+            const uint16_t* pixel = u16 + index * 4;
+            return { pixel[0], pixel[1], pixel[2], pixel[3] };
+        }
+        else if constexpr (F == PIXELFORMAT_RGBA4_UNORM)
+        {
+            const uint32_t packed = u16[index];
+            return { Expand<0x0F>((packed >> 12) & 0x0F), Expand<0x0F>((packed >> 8) & 0x0F),
+                     Expand<0x0F>((packed >> 4) & 0x0F), Expand<0x0F>(packed & 0x0F) };
+        }
+        else if constexpr (F == PIXELFORMAT_RGB5A1_UNORM)
+        {
+            const uint32_t packed = u16[index];
+            return { Expand<0x1F>((packed >> 11) & 0x1F), Expand<0x1F>((packed >> 6) & 0x1F),
+                     Expand<0x1F>((packed >> 1) & 0x1F), (packed & 0x01) * CHANNEL_MAX };
+        }
+        else if constexpr (F == PIXELFORMAT_RGB565_UNORM)
+        {
+            const uint32_t packed = u16[index];
+            return { Expand<0x1F>((packed >> 11) & 0x1F), Expand<0x3F>((packed >> 5) & 0x3F),
+                     Expand<0x1F>(packed & 0x1F), CHANNEL_MAX };
+        }
+        else
+            static_assert(F != F, "Unsupported pixel format.");
+    }
+
+    template<PixelFormat F>
+    inline void Store(uint8_t* row, int index, const Channels& color)
+    {
+        auto* u16 = (uint16_t*)row;
+
+        if constexpr (F == PIXELFORMAT_R8_UNORM)
+            row[index] = Reduce<0xFF>(color.r);
+        else if constexpr (F == PIXELFORMAT_R16_UNORM)
+            u16[index] = color.r;
+        else if constexpr (F == PIXELFORMAT_RG8_UNORM)
+        {
+            row[index * 2 + 0] = Reduce<0xFF>(color.r);
+            row[index * 2 + 1] = Reduce<0xFF>(color.g);
+        }
+        else if constexpr (F == PIXELFORMAT_LA8_UNORM)
+        {
+            row[index * 2 + 0] = Reduce<0xFF>(color.r);
+            row[index * 2 + 1] = Reduce<0xFF>(color.a);
+        }
+        else if constexpr (F == PIXELFORMAT_RG16_UNORM)
+        {
+            u16[index * 2 + 0] = color.r;
+            u16[index * 2 + 1] = color.g;
+        }
+        else if constexpr (F == PIXELFORMAT_RGBA8_UNORM)
+        {
+            uint8_t* pixel = row + index * 4;
+
+            pixel[0] = Reduce<0xFF>(color.r);
+            pixel[1] = Reduce<0xFF>(color.g);
+            pixel[2] = Reduce<0xFF>(color.b);
+            pixel[3] = Reduce<0xFF>(color.a);
+        }
+        else if constexpr (F == PIXELFORMAT_RGBA16_UNORM)
+        {
+            uint16_t* pixel = u16 + index * 4;
+
+            pixel[0] = color.r;
+            pixel[1] = color.g;
+            pixel[2] = color.b;
+            pixel[3] = color.a;
+        }
+        else if constexpr (F == PIXELFORMAT_RGBA4_UNORM)
+        {
+            u16[index] = (Reduce<0x0F>(color.r) << 12) | (Reduce<0x0F>(color.g) << 8) |
+                         (Reduce<0x0F>(color.b) << 4) | Reduce<0x0F>(color.a);
+        }
+        else if constexpr (F == PIXELFORMAT_RGB5A1_UNORM)
+        {
+            u16[index] = (Reduce<0x1F>(color.r) << 11) | (Reduce<0x1F>(color.g) << 6) |
+                         (Reduce<0x1F>(color.b) << 1) | Reduce<0x01>(color.a);
+        }
+        else if constexpr (F == PIXELFORMAT_RGB565_UNORM)
+        {
+            u16[index] = (Reduce<0x1F>(color.r) << 11) | (Reduce<0x3F>(color.g) << 5) |
+                         Reduce<0x1F>(color.b);
+        }
+        else
+            static_assert(F != F, "Unsupported pixel format.");
+    }
+
+    template<PixelFormat Source, PixelFormat Destination>
+    void ConvertRow(const void* source, void* destination, int width)
+    {
+        const auto* sourceRow = (const uint8_t*)source;
+        auto* destinationRow  = (uint8_t*)destination;
+
+        if constexpr (Source == PIXELFORMAT_RGBA8_UNORM &&
+                      Destination == PIXELFORMAT_RGBA16_UNORM)
+        {
+            /* exact widening, no intermediate rounding needed */
+            for (int index = 0; index < width * 4; index++)
+                ((uint16_t*)destinationRow)[index] = sourceRow[index] * 0x101;
+        }
+        else if constexpr (Source == PIXELFORMAT_RGBA16_UNORM &&
+                           Destination == PIXELFORMAT_RGBA8_UNORM)
+        {
+            for (int index = 0; index < width * 4; index++)
+                destinationRow[index] = Reduce<0xFF>(((const uint16_t*)sourceRow)[index]);
+        }
+        else
+        {
+            for (int index = 0; index < width; index++)
+                Store<Destination>(destinationRow, index, Load<Source>(sourceRow, index));
+        }
+    }
+
+    namespace detail
+    {
+        template<size_t S, size_t... D>
+        constexpr std::array<RowFunction, sizeof...(D)> MakeRow(std::index_sequence<D...>)
+        {
+            return { &ConvertRow<formats[S], formats[D]>... };
+        }
+
+        template<size_t... S>
+        constexpr auto MakeTable(std::index_sequence<S...>)
+        {
+            using Indices = std::make_index_sequence<formats.size()>;
+            return std::array<std::array<RowFunction, formats.size()>, formats.size()> {
+                MakeRow<S>(Indices {})...
+            };
+        }
+
+        static constexpr auto table = MakeTable(std::make_index_sequence<formats.size()> {});
+
+        inline constexpr int IndexOf(PixelFormat format)
+        {
+            for (size_t index = 0; index < formats.size(); index++)
+            {
+                if (formats[index] == format)
+                    return (int)index;
+            }
+
+            return -1;
+        }
+    } // namespace detail
+
+    /* Returns nullptr if either format has no conversion kernel. */
+    inline RowFunction GetRowFunction(PixelFormat source, PixelFormat destination)
+    {
+        const int sourceIndex      = detail::IndexOf(source);
+        const int destinationIndex = detail::IndexOf(destination);
+
+        if (sourceIndex < 0 || destinationIndex < 0)
+            return nullptr;
+
+        return detail::table[sourceIndex][destinationIndex];
+    }
+
+    inline bool Convert(PixelFormat source, const void* sourceData, size_t sourcePitch,
+                        PixelFormat destination, void* destinationData, size_t destinationPitch,
+                        int width, int height)
+    {
+        const auto function = GetRowFunction(source, destination);
+
+        if (function == nullptr)
+            return false;
+
+        for (int row = 0; row < height; row++)
+        {
+            const auto* sourceRow = (const uint8_t*)sourceData + row * sourcePitch;
+            auto* destinationRow  = (uint8_t*)destinationData + row * destinationPitch;
+
+            function(sourceRow, destinationRow, width);
+        }
+
+        return true;
+    }
+} // namespace love::PixelConverter
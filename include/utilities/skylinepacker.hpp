@@ -0,0 +1,167 @@
+#pragma once
+
+#include <common/math.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/*
+** Online rectangle packer for texture atlases. The free space is tracked as a skyline: the
+** top edge of everything placed so far, as a list of horizontal segments. Each rectangle
+** goes where its top edge ends up lowest (bottom-left rule), ties going to the narrowest
+** segment. Rectangles can be added at any time; nothing already placed ever moves. With
+** @padding, every rectangle is kept that many pixels from the others and from the edges.
+*/
+namespace love
+{
+    class SkylinePacker
+    {
+      public:
+        SkylinePacker(int width, int height, int padding = 0) :
+            width(width - padding),
+            height(height - padding),
+            padding(padding),
+            usedArea(0)
+        {
+            this->Reset();
+        }
+
+        void Reset()
+        {
+            this->skyline.assign(1, Segment { 0, 0, this->width });
+            this->usedArea = 0;
+        }
+
+        /* finds room for a @width x @height rectangle, or returns false if there is none */
+        bool Insert(int width, int height, Rect& rect)
+        {
+            if (width <= 0 || height <= 0)
+                return false;
+
+            /*
+            ** Each rectangle is placed with its padding to the right and below; the area packed
+            ** starts past the padding along the top and left edges of the page.
+            */
+            width += this->padding;
+            height += this->padding;
+
+            int bestIndex  = -1;
+            int bestTop    = std::numeric_limits<int>::max();
+            int bestLength = std::numeric_limits<int>::max();
+
+            for (size_t index = 0; index < this->skyline.size(); index++)
+            {
+                int y = 0;
+
+                if (!this->Fits(index, width, height, y))
+                    continue;
+
+                const int top    = y + height;
+                const int length = this->skyline[index].width;
+
+                if (top < bestTop || (top == bestTop && length < bestLength))
+                {
+                    bestIndex  = (int)index;
+                    bestTop    = top;
+                    bestLength = length;
+                }
+            }
+
+            if (bestIndex < 0)
+                return false;
+
+            rect = { this->skyline[bestIndex].x, bestTop - height, width, height };
+
+            this->AddSegment(bestIndex, rect);
+            this->usedArea += width * height;
+
+            rect.x += this->padding;
+            rect.y += this->padding;
+            rect.w -= this->padding;
+            rect.h -= this->padding;
+
+            return true;
+        }
+
+        /* fraction of the area covered by placed rectangles */
+        float GetOccupancy() const
+        {
+            return this->usedArea / (float)(this->width * this->height);
+        }
+
+      private:
+        struct Segment
+        {
+            int x, y;
+            int width;
+        };
+
+        /* whether the rectangle fits with its left edge on segment @index; @y is its bottom */
+        bool Fits(size_t index, int width, int height, int& y) const
+        {
+            if (this->skyline[index].x + width > this->width)
+                return false;
+
+            int remaining = width;
+            y             = this->skyline[index].y;
+
+            for (size_t next = index; remaining > 0; next++)
+            {
+                y = std::max(y, this->skyline[next].y);
+
+                if (y + height > this->height)
+                    return false;
+
+                remaining -= this->skyline[next].width;
+            }
+
+            return true;
+        }
+
+        void AddSegment(size_t index, const Rect& rect)
+        {
+            const Segment segment { rect.x, rect.y + rect.h, rect.w };
+            this->skyline.insert(this->skyline.begin() + index, segment);
+
+            /* trim or drop the segments the new one now covers */
+            for (size_t next = index + 1; next < this->skyline.size();)
+            {
+                const auto& previous = this->skyline[next - 1];
+                auto& current        = this->skyline[next];
+
+                const int overlap = previous.x + previous.width - current.x;
+
+                if (overlap <= 0)
+                    break;
+
+                current.x += overlap;
+                current.width -= overlap;
+
+                if (current.width > 0)
+                    break;
+
+                this->skyline.erase(this->skyline.begin() + next);
+            }
+
+            /* merge neighbours at the same height */
+            for (size_t next = 1; next < this->skyline.size();)
+            {
+                if (this->skyline[next - 1].y == this->skyline[next].y)
+                {
+                    this->skyline[next - 1].width += this->skyline[next].width;
+                    this->skyline.erase(this->skyline.begin() + next);
+                }
+                else
+                    next++;
+            }
+        }
+
+        int width;
+        int height;
+        int padding;
+        int usedArea;
+
+        std::vector<Segment> skyline;
+    };
+} // namespace love
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <common/math.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** Linear <-> tiled addressing for textures stored as 8x8 tiles, where the
+** pixels inside each tile are in Morton (Z) order. Rectangles are copied a
+** row at a time using precomputed column offsets, so no per-pixel floats,
+** divisions or bounds checks are involved.
+*/
+namespace love::Swizzle
+{
+    static constexpr uint32_t TILE_SIZE   = 0x08;
+    static constexpr uint32_t TILE_PIXELS = TILE_SIZE * TILE_SIZE;
+
+    /* spreads the low three bits of @value to bits 0, 2 and 4 */
+    inline constexpr uint32_t Spread(uint32_t value)
+    {
+        return (value & 0x01) | ((value & 0x02) << 1) | ((value & 0x04) << 2);
+    }
+
+    inline constexpr std::array<uint32_t, TILE_SIZE> MakeSpreadTable(uint32_t shift)
+    {
+        std::array<uint32_t, TILE_SIZE> table {};
+
+        for (uint32_t index = 0; index < TILE_SIZE; index++)
+            table[index] = Spread(index) << shift;
+
+        return table;
+    }
+
+    static constexpr auto mortonX = MakeSpreadTable(0);
+    static constexpr auto mortonY = MakeSpreadTable(1);
+
+    /* offset of the column @x within any row, in pixels */
+    inline constexpr uint32_t ColumnOffset(uint32_t x)
+    {
+        return (x / TILE_SIZE) * TILE_PIXELS + mortonX[x % TILE_SIZE];
+    }
+
+    /* offset of the start of row @y in a tiled image @width pixels wide (power of two) */
+    inline constexpr uint32_t RowOffset(uint32_t width, uint32_t y)
+    {
+        return (y / TILE_SIZE) * (width / TILE_SIZE) * TILE_PIXELS + mortonY[y % TILE_SIZE];
+    }
+
+    inline constexpr uint32_t TileIndex(uint32_t width, uint32_t x, uint32_t y)
+    {
+        return RowOffset(width, y) + ColumnOffset(x);
+    }
+
+    inline std::vector<uint32_t> ColumnOffsets(uint32_t x, uint32_t width)
+    {
+        std::vector<uint32_t> offsets(width);
+
+        for (uint32_t column = 0; column < width; column++)
+            offsets[column] = ColumnOffset(x + column);
+
+        return offsets;
+    }
+
+    /*
+    ** Copies a @rect.w x @rect.h block of linear pixels (@sourcePitch pixels per row)
+    ** into a tiled image @width pixels wide, at @rect.x, @rect.y.
+    */
+    template<typename T>
+    void LinearToTiled(const T* source, size_t sourcePitch, T* destination, uint32_t width,
+                       const Rect& rect)
+    {
+        const auto columns = ColumnOffsets(rect.x, rect.w);
+
+        for (int row = 0; row < rect.h; row++)
+        {
+            const T* sourceRow = source + row * sourcePitch;
+            T* destinationRow  = destination + RowOffset(width, rect.y + row);
+
+            for (int column = 0; column < rect.w; column++)
+                destinationRow[columns[column]] = sourceRow[column];
+        }
+    }
+
+    /*
+    ** Copies a @rect.w x @rect.h block at @rect.x, @rect.y of a tiled image @width pixels
+    ** wide into linear pixels (@destinationPitch pixels per row).
+    */
+    template<typename T>
+    void TiledToLinear(const T* source, uint32_t width, const Rect& rect, T* destination,
+                       size_t destinationPitch)
+    {
+        const auto columns = ColumnOffsets(rect.x, rect.w);
+
+        for (int row = 0; row < rect.h; row++)
+        {
+            const T* sourceRow = source + RowOffset(width, rect.y + row);
+            T* destinationRow  = destination + row * destinationPitch;
+
+            for (int column = 0; column < rect.w; column++)
+                destinationRow[column] = sourceRow[columns[column]];
+        }
+    }
+
+    /*
+    ** Copies @sourceRect of a tiled image @sourceWidth pixels wide into a tiled image
+    ** @destinationWidth pixels wide, at @x, @y.
+    */
+    template<typename T>
+    void TiledToTiled(const T* source, uint32_t sourceWidth, const Rect& sourceRect,
+                      T* destination, uint32_t destinationWidth, int x, int y)
+    {
+        const auto sourceColumns      = ColumnOffsets(sourceRect.x, sourceRect.w);
+        const auto destinationColumns = ColumnOffsets(x, sourceRect.w);
+
+        for (int row = 0; row < sourceRect.h; row++)
+        {
+            const T* sourceRow = source + RowOffset(sourceWidth, sourceRect.y + row);
+            T* destinationRow  = destination + RowOffset(destinationWidth, y + row);
+
+            for (int column = 0; column < sourceRect.w; column++)
+                destinationRow[destinationColumns[column]] = sourceRow[sourceColumns[column]];
+        }
+    }
+} // namespace love::Swizzle
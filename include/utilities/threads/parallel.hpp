@@ -0,0 +1,58 @@
+#pragma once
+
+#include <utilities/threads/threads.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+namespace love
+{
+    static constexpr int PARALLEL_MAX_THREADS = 0x04;
+
+    /*
+    ** Splits [0, @count) into contiguous bands and runs @func(first, last) on each. Band 0
+    ** runs on the calling thread and the rest on worker threads. Bands whose worker can't
+    ** be started run inline. @parallel = false runs everything on the calling thread.
+    */
+    template<typename F>
+    void ParallelFor(int count, bool parallel, const F& func)
+    {
+        if (count <= 0)
+            return;
+
+        int bands = 1;
+
+        if (parallel)
+        {
+            const int cores = (int)love::thread::hardware_concurrency();
+            bands           = std::clamp(cores, 1, std::min(PARALLEL_MAX_THREADS, count));
+        }
+
+        const int size = (count + bands - 1) / bands;
+        std::vector<love::thread> workers;
+
+        for (int band = 1; band < bands; band++)
+        {
+            const int first = band * size;
+            const int last  = std::min(first + size, count);
+
+            if (first >= last)
+                break;
+
+            try
+            {
+                workers.emplace_back(func, first, last);
+            }
+            catch (const std::exception&)
+            {
+                func(first, last);
+            }
+        }
+
+        func(0, std::min(size, count));
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+} // namespace love
@@ -28,10 +28,17 @@ namespace love
         void ReplacePixels(const void* data, size_t size, int slice, int mipmap, const Rect& rect,
                            bool reloadMipmaps);
 
+        /*
+        ** Returns the surface memory of @rect in @mipmap for the caller to write, flushed
+        ** by UnlockPixels. @pitch receives the row stride in bytes.
+        */
+        uint8_t* LockPixels(const Rect& rect, size_t& pitch, int mipmap = 0);
+
+        void UnlockPixels();
+
         void SetSamplerState(const SamplerState& state);
 
-        void GenerateMipmaps()
-        {}
+        void GenerateMipmaps(Mipmapper::Filter filter = Mipmapper::FILTER_BOX);
 
         bool LoadVolatile();
 
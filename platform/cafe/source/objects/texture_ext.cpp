@@ -46,7 +46,8 @@ static void createFramebufferObject(GX2ColorBuffer*& buffer, GX2Texture*& textur
     texture->surface.image = buffer->surface.image;
 }
 
-static void createTextureObject(GX2Texture*& texture, PixelFormat format, int width, int height)
+static void createTextureObject(GX2Texture*& texture, PixelFormat format, int width, int height,
+                                int mipmaps)
 {
     texture = new GX2Texture();
 
@@ -61,7 +62,7 @@ static void createTextureObject(GX2Texture*& texture, PixelFormat format, int wi
     texture->surface.height = height;
 
     texture->surface.depth     = 1;
-    texture->surface.mipLevels = 1;
+    texture->surface.mipLevels = mipmaps;
 
     std::optional<GX2SurfaceFormat> gxFormat;
     if (!(gxFormat = Renderer<Console::CAFE>::pixelFormats.Find(format)))
@@ -71,7 +72,7 @@ static void createTextureObject(GX2Texture*& texture, PixelFormat format, int wi
     texture->surface.aa       = GX2_AA_MODE1X;
     texture->surface.tileMode = GX2_TILE_MODE_LINEAR_ALIGNED;
     texture->viewFirstMip     = 0;
-    texture->viewNumMips      = 1;
+    texture->viewNumMips      = mipmaps;
     texture->viewFirstSlice   = 0;
     texture->viewNumSlices    = 1;
     texture->compMap = GX2_COMP_MAP(GX2_SQ_SEL_R, GX2_SQ_SEL_G, GX2_SQ_SEL_B, GX2_SQ_SEL_A);
@@ -88,6 +89,45 @@ static void createTextureObject(GX2Texture*& texture, PixelFormat format, int wi
 
     GX2Invalidate(GX2_INVALIDATE_MODE_CPU_TEXTURE, texture->surface.image,
                   texture->surface.imageSize);
+
+    if (mipmaps > 1)
+    {
+        const auto size = texture->surface.mipmapSize;
+        texture->surface.mipmaps = memalign(texture->surface.alignment, size);
+
+        if (!texture->surface.mipmaps)
+            throw love::Exception("Failed to create GX2Surface mipmaps.");
+
+        std::memset(texture->surface.mipmaps, 0, size);
+        GX2Invalidate(GX2_INVALIDATE_MODE_CPU_TEXTURE, texture->surface.mipmaps, size);
+    }
+}
+
+/* level 1 starts the mipmap block, later levels are offset from it */
+static uint8_t* getMipmapAddress(const GX2Surface& surface, int mipmap)
+{
+    if (mipmap == 0)
+        return (uint8_t*)surface.image;
+
+    const auto offset = (mipmap == 1) ? 0 : surface.mipLevelOffset[mipmap - 1];
+    return (uint8_t*)surface.mipmaps + offset;
+}
+
+/* row pitch of @mipmap in pixels, as a single level surface of that size */
+static uint32_t getMipmapPitch(const GX2Surface& surface, int mipmap)
+{
+    if (mipmap == 0)
+        return surface.pitch;
+
+    GX2Surface level = surface;
+
+    level.width     = std::max<uint32_t>(surface.width >> mipmap, 1);
+    level.height    = std::max<uint32_t>(surface.height >> mipmap, 1);
+    level.mipLevels = 1;
+
+    GX2CalcSurfaceSizeAndAlignment(&level);
+
+    return level.pitch;
 }
 
 Texture<Console::CAFE>::Texture(const Graphics<Console::CAFE>* graphics, const Settings& settings,
@@ -102,7 +142,7 @@ Texture<Console::CAFE>::Texture(const Graphics<Console::CAFE>* graphics, const S
     if (this->mipmapMode == MIPMAPS_AUTO && this->IsCompressed())
         this->mipmapMode = MIPMAPS_MANUAL;
 
-    if (this->mipmapMode != MIPMAPS_NONE)
+    if (this->mipmapMode != MIPMAPS_NONE && this->CanGenerateMipmaps())
         this->mipmapCount =
             Texture<>::GetTotalMipmapCount(this->pixelWidth, this->pixelHeight, this->depth);
 
@@ -186,7 +226,7 @@ void Texture<Console::CAFE>::CreateTexture()
     {
         bool clear = !hasData;
 
-        createTextureObject(this->texture, PixelFormat::PIXELFORMAT_RGBA8_UNORM, width, height);
+        createTextureObject(this->texture, PixelFormat::PIXELFORMAT_RGBA8_UNORM, width, height, 1);
         createFramebufferObject(this->framebuffer, this->texture, _width, _height);
 
         if (clear)
@@ -198,15 +238,14 @@ void Texture<Console::CAFE>::CreateTexture()
     }
     else
     {
-        createTextureObject(this->texture, this->format, _width, _height);
+        /* the surface is already cleared when created */
+        createTextureObject(this->texture, this->format, _width, _height, this->GetMipmapCount());
 
-        if (!hasData)
-        {
-            std::vector<uint8_t> empty(_width * _height, 0);
-            this->ReplacePixels(empty.data(), empty.size(), 0, 0, { 0, 0, _width, _height }, false);
-        }
-        else
+        if (hasData)
             this->ReplacePixels(this->slices.Get(0, 0), 0, 0, 0, 0, false);
+
+        if (this->NeedsMipmapGeneration())
+            this->GenerateMipmaps();
     }
 
     this->SetSamplerState(this->state);
@@ -215,7 +254,10 @@ void Texture<Console::CAFE>::CreateTexture()
 void Texture<Console::CAFE>::UnloadVolatile()
 {
     if (this->texture)
+    {
+        free(this->texture->surface.mipmaps);
         delete this->texture;
+    }
 
     if (this->framebuffer)
         delete this->framebuffer;
@@ -283,24 +325,66 @@ void Texture<Console::CAFE>::ReplacePixels(const void* data, size_t size, int sl
     if (graphics != nullptr && graphics->IsRenderTargetActive(this))
         return;
 
-    const auto pitch = this->texture->surface.pitch;
-
-    uint8_t* dest   = (uint8_t*)this->texture->surface.image;
+    size_t pitch    = 0;
+    uint8_t* dest   = this->LockPixels(rectangle, pitch);
     uint8_t* source = (uint8_t*)data;
 
-    size_t pixelSize = GetPixelFormatBlockSize(this->format);
+    const size_t rowSize = rectangle.w * GetPixelFormatBlockSize(this->format);
 
     /* copy by row */
     for (uint32_t y = 0; y < (uint32_t)rectangle.h; y++)
-    {
-        const auto srcRow  = (y * rectangle.w * pixelSize);
-        const auto destRow = (rectangle.x + (y + rectangle.y) * pitch) * pixelSize;
+        std::memcpy(dest + y * pitch, source + y * rowSize, rowSize);
 
-        std::memcpy(dest + destRow, source + srcRow, rectangle.w * pixelSize);
-    }
+    this->UnlockPixels();
+}
+
+uint8_t* Texture<Console::CAFE>::LockPixels(const Rect& rectangle, size_t& pitch, int mipmap)
+{
+    const auto& surface    = this->texture->surface;
+    const size_t pixelSize = GetPixelFormatBlockSize(this->format);
+
+    const auto levelPitch = getMipmapPitch(surface, mipmap);
+    const auto offset     = rectangle.x + rectangle.y * levelPitch;
+
+    /* the surface is linear, so the caller writes straight into texture memory */
+    pitch = levelPitch * pixelSize;
+
+    return getMipmapAddress(surface, mipmap) + offset * pixelSize;
+}
+
+void Texture<Console::CAFE>::UnlockPixels()
+{
+    const auto& surface = this->texture->surface;
+    GX2Invalidate(Texture::INVALIDATE_MODE, surface.image, surface.imageSize);
+
+    if (surface.mipmaps != nullptr)
+        GX2Invalidate(Texture::INVALIDATE_MODE, surface.mipmaps, surface.mipmapSize);
+}
+
+void Texture<Console::CAFE>::GenerateMipmaps(Mipmapper::Filter filter)
+{
+    this->CheckGenerateMipmaps();
+
+    if (this->texture == nullptr)
+        return;
+
+    const auto& surface = this->texture->surface;
+    const size_t pitch  = surface.pitch * GetPixelFormatBlockSize(this->format);
+
+    const auto upload = [&](int mipmap, const uint8_t* pixels, int width, int height) {
+        size_t levelPitch    = 0;
+        uint8_t* level       = this->LockPixels({ 0, 0, width, height }, levelPitch, mipmap);
+        const size_t rowSize = width * Mipmapper::CHANNELS;
+
+        for (int row = 0; row < height; row++)
+            std::memcpy(level + row * levelPitch, pixels + row * rowSize, rowSize);
+    };
+
+    /* the base level is read straight out of the linear surface */
+    this->GenerateMipmapLevels((const uint8_t*)surface.image, this->pixelWidth,
+                               this->pixelHeight, pitch, filter, upload);
 
-    const auto imageSize = this->texture->surface.imageSize;
-    GX2Invalidate(Texture::INVALIDATE_MODE, this->texture->surface.image, imageSize);
+    this->UnlockPixels();
 }
 
 void Texture<Console::CAFE>::Draw(Graphics<Console::CAFE>& graphics, const Matrix4& matrix)
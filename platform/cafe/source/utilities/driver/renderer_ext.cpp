@@ -1,6 +1,9 @@
 #include <utilities/driver/renderer_ext.hpp>
 
+#include <common/memorystats.hpp>
+
 #include <modules/keyboard_ext.hpp>
+#include <modules/profiler/profiler.hpp>
 
 #include <objects/texture_ext.hpp>
 
@@ -81,6 +84,8 @@ Renderer<Console::CAFE>::Renderer() :
     if (!GX2RCreateBuffer(&m_buffer))
         throw love::Exception("Failed to create GX2RBuffer");
 
+    MemoryStats::Add(MemoryStats::CATEGORY_VERTEX, MAX_OBJECTS * vertex::VERTEX_SIZE);
+
     GX2RSetAttributeBuffer(&m_buffer, 0, VERTEX_SIZE, 0);
 
     this->context.transform = (Transform*)memalign(0x100, sizeof(Transform));
@@ -169,6 +174,7 @@ Renderer<Console::CAFE>::~Renderer()
         this->OnForegroundReleased();
 
     GX2RDestroyBufferEx(&m_buffer, GX2R_RESOURCE_BIND_NONE);
+    MemoryStats::Remove(MemoryStats::CATEGORY_VERTEX, MAX_OBJECTS * vertex::VERTEX_SIZE);
 
     GX2Shutdown();
 
@@ -294,6 +300,8 @@ void Renderer<Console::CAFE>::BindFramebuffer(Texture<Console::ALL>* texture)
 
 void Renderer<Console::CAFE>::FlushVertices()
 {
+    Profiler::Zone zone("graphics.submit");
+
     auto* vertices = (Vertex*)GX2RLockBufferEx(&m_buffer, GX2R_RESOURCE_BIND_NONE);
 
     for (const auto& command : m_commands)
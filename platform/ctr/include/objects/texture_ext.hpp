@@ -2,6 +2,8 @@
 
 #include <citro3d.h>
 
+#include <memory>
+
 namespace love
 {
     template<>
@@ -25,10 +27,17 @@ namespace love
         void ReplacePixels(const void* data, size_t size, int slice, int mipmap, const Rect& rect,
                            bool reloadMipmaps);
 
+        /*
+        ** Returns linear staging memory for @rect of @mipmap, which UnlockPixels swizzles
+        ** into the tiled texture. @pitch receives the row stride in bytes.
+        */
+        uint8_t* LockPixels(const Rect& rect, size_t& pitch, int mipmap = 0);
+
+        void UnlockPixels();
+
         void SetSamplerState(const SamplerState& state);
 
-        void GenerateMipmaps()
-        {}
+        void GenerateMipmaps(Mipmapper::Filter filter = Mipmapper::FILTER_BOX);
 
         bool LoadVolatile();
 
@@ -53,5 +62,9 @@ namespace love
 
         C3D_Tex* texture;
         C3D_RenderTarget* framebuffer;
+
+        std::unique_ptr<uint8_t[]> staging;
+        Rect stagingRect;
+        int stagingMipmap;
     };
 } // namespace love
@@ -1,6 +1,8 @@
 #include <modules/image/imagemodule.hpp>
 #include <objects/imagedata_ext.hpp>
 
+#include <utilities/swizzle.hpp>
+
 using namespace love;
 
 void ImageData<Console::CTR>::Paste(ImageData* source, int x, int y, Rect& sourceRect)
@@ -14,9 +16,7 @@ void ImageData<Console::CTR>::Paste(ImageData* source, int x, int y, Rect& sourc
     if (srcFormat != PIXELFORMAT_RGBA8_UNORM && destFormat != PIXELFORMAT_RGBA8_UNORM)
         throw love::Exception("Both source and destination formats must be RGBA8.");
 
-    const auto srcWidth  = source->GetWidth();
-    const auto srcHeight = source->GetHeight();
-
+    const auto srcWidth   = source->GetWidth();
     const auto destWidth  = this->GetWidth();
     const auto destHeight = this->GetHeight();
 
@@ -28,29 +28,13 @@ void ImageData<Console::CTR>::Paste(ImageData* source, int x, int y, Rect& sourc
     uint8_t* srcData = (uint8_t*)source->GetData();
     uint8_t* dstData = (uint8_t*)this->GetData();
 
-    auto getFunction = source->pixelGetFunction;
-    auto setFunction = this->pixelSetFunction;
-
     const auto _srcWidth = NextPo2(srcWidth);
     const auto _dstWidth = NextPo2(destWidth);
 
-    for (int _y = 0; _y < std::min(sourceRect.h, destHeight - y); _y++)
-    {
-        for (int _x = 0; _x < std::min(sourceRect.w, destWidth - x); _x++)
-        {
-            Color color {};
-
-            // clang-format off
-            Vector2 srcPosition { (sourceRect.x + _x), (sourceRect.y + _y) };
-            const auto* sourcePixel = Color::FromTile(srcData, _srcWidth, srcPosition);
-
-            getFunction((const Pixel*)sourcePixel, color);
-
-            Vector2 dstPosition { (x + _x), (y + _y) };
-            auto* destinationPixel = Color::FromTile(dstData, _dstWidth, dstPosition);
+    Rect rect = sourceRect;
+    rect.w    = std::min(sourceRect.w, destWidth - x);
+    rect.h    = std::min(sourceRect.h, destHeight - y);
 
-            setFunction(color, (Pixel*)destinationPixel);
-            // clang-format on
-        }
-    }
-}
\ No newline at end of file
+    Swizzle::TiledToTiled((const uint32_t*)srcData, _srcWidth, rect, (uint32_t*)dstData, _dstWidth,
+                          x, y);
+}
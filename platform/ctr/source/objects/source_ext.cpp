@@ -1,16 +1,34 @@
 #include <objects/source_ext.hpp>
 #include <utilities/pool/sources.hpp>
 
+#include <common/memorystats.hpp>
+
 #include <algorithm>
 
 using namespace love;
 
 using DSP = love::DSP<Console::CTR>;
 
+static int16_t* allocateBuffer(size_t size)
+{
+    auto* buffer = (int16_t*)linearAlloc(size);
+
+    if (buffer != nullptr)
+        MemoryStats::Add(MemoryStats::CATEGORY_AUDIO, linearGetSize(buffer));
+
+    return buffer;
+}
+
+static void freeBuffer(void* buffer)
+{
+    MemoryStats::Remove(MemoryStats::CATEGORY_AUDIO, linearGetSize(buffer));
+    linearFree(buffer);
+}
+
 template<>
 Source<Console::CTR>::DataBuffer::DataBuffer(const void* data, size_t size) : size(size)
 {
-    this->buffer = (int16_t*)linearAlloc(size);
+    this->buffer = allocateBuffer(size);
     std::memcpy(this->buffer, (int16_t*)data, size);
 
     DSP_FlushDataCache(this->buffer, this->size);
@@ -19,7 +37,7 @@ Source<Console::CTR>::DataBuffer::DataBuffer(const void* data, size_t size) : si
 template<>
 Source<Console::CTR>::DataBuffer::~DataBuffer()
 {
-    linearFree(this->buffer);
+    freeBuffer(this->buffer);
 }
 
 Source<Console::CTR>::Source(AudioPool* pool, SoundData* soundData) :
@@ -49,7 +67,7 @@ Source<Console::CTR>::Source(AudioPool* pool, Decoder* decoder) : Source<>(TYPE_
 
     for (auto& buffer : this->buffers)
     {
-        buffer.data_pcm16 = (int16_t*)linearAlloc(decoder->GetSize());
+        buffer.data_pcm16 = allocateBuffer(decoder->GetSize());
         buffer.status     = NDSP_WBUF_DONE;
     }
 }
@@ -95,7 +113,7 @@ Source<Console::CTR>::Source(const Source& other) : Source<>(other.sourceType),
     for (size_t index = 0; index < this->bufferCount; index++)
     {
         if (this->sourceType == TYPE_STREAM)
-            this->buffers[index].data_pcm16 = (int16_t*)linearAlloc(this->decoder->GetSize());
+            this->buffers[index].data_pcm16 = allocateBuffer(this->decoder->GetSize());
 
         this->buffers[index].status = NDSP_WBUF_DONE;
     }
@@ -105,10 +123,14 @@ Source<Console::CTR>::~Source()
 {
     this->Stop();
 
+    /* static sources point into their DataBuffer, which frees itself */
+    if (this->sourceType != TYPE_STREAM)
+        return;
+
     for (auto& buffer : this->buffers)
     {
         if (buffer.data_pcm16)
-            linearFree(buffer.data_pcm16);
+            freeBuffer(buffer.data_pcm16);
     }
 }
 
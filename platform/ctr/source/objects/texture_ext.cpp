@@ -1,6 +1,7 @@
 #include <objects/texture_ext.hpp>
 
 #include <utilities/driver/renderer_ext.hpp>
+#include <utilities/swizzle.hpp>
 
 using namespace love;
 
@@ -19,7 +20,7 @@ static void createFramebufferObject(C3D_RenderTarget*& target, C3D_Tex*& texture
 }
 
 static void createTextureObject(C3D_Tex*& texture, PixelFormat format, uint16_t width,
-                                uint16_t height)
+                                uint16_t height, int mipmaps)
 {
     const auto _width  = NextPo2(width);
     const auto _height = NextPo2(height);
@@ -30,21 +31,32 @@ static void createTextureObject(C3D_Tex*& texture, PixelFormat format, uint16_t
     if (!(color = Renderer<Console::CTR>::pixelFormats.Find(format)))
         throw love::Exception("Invalid color format: %s", love::GetPixelFormatName(format));
 
-    if (!C3D_TexInit(texture, _width, _height, *color))
+    /* mipmapped textures get every level down to the 8x8 tile size */
+    bool success = false;
+
+    if (mipmaps > 1)
+        success = C3D_TexInitMipmap(texture, _width, _height, *color);
+    else
+        success = C3D_TexInit(texture, _width, _height, *color);
+
+    if (!success)
         throw love::Exception("Failed to create Texture!");
 }
 
 Texture<Console::CTR>::Texture(const Graphics<Console::ALL>* graphics, const Settings& settings,
                                const Slices* data) :
     Texture<Console::ALL>(settings, data),
-    framebuffer(nullptr)
+    framebuffer(nullptr),
+    staging(nullptr),
+    stagingRect {},
+    stagingMipmap(0)
 {
     this->format = graphics->GetSizedFormat(format, this->renderTarget, this->readable);
 
     if (this->mipmapMode == MIPMAPS_AUTO && this->IsCompressed())
         this->mipmapMode = MIPMAPS_MANUAL;
 
-    if (this->mipmapMode != MIPMAPS_NONE)
+    if (this->mipmapMode != MIPMAPS_NONE && this->CanGenerateMipmaps())
         this->mipmapCount =
             Texture<>::GetTotalMipmapCount(this->pixelWidth, this->pixelHeight, this->depth);
 
@@ -167,7 +179,9 @@ void Texture<Console::CTR>::CreateTexture()
     }
     else
     {
-        createTextureObject(this->texture, this->format, _width, _height);
+        createTextureObject(this->texture, this->format, _width, _height, this->GetMipmapCount());
+        this->mipmapCount = std::min<int>(this->mipmapCount, this->texture->maxLevel + 1);
+
         const auto copySize = love::GetPixelFormatSliceSize(this->format, _width, _height);
 
         if (!hasData)
@@ -176,6 +190,9 @@ void Texture<Console::CTR>::CreateTexture()
             std::memcpy(this->texture->data, this->slices.Get(0, 0)->GetData(), copySize);
 
         C3D_TexFlush(this->texture);
+
+        if (this->NeedsMipmapGeneration())
+            this->GenerateMipmaps();
     }
 
     this->SetSamplerState(this->state);
@@ -236,18 +253,10 @@ void _replacePixels(const void* source, void* texture, const Rect& rect, const i
     const auto sourcePowTwo = NextPo2(rect.w);
     const auto destPowTwo   = NextPo2(width);
 
-    for (int _y = 0; _y < std::min(rect.h, height - rect.y); _y++)
-    {
-        for (int _x = 0; _x < std::min(rect.w, width - rect.x); _x++)
-        {
-            Vector2 srcPosition { _x, _y };
-            const auto* srcPixel = Color::FromTile<T>(source, sourcePowTwo, srcPosition);
+    Rect sourceRect { 0, 0, std::min(rect.w, width - rect.x), std::min(rect.h, height - rect.y) };
 
-            Vector2 destPosition { (rect.x + _x), (rect.y + _y) };
-            auto* destPixel = Color::FromTile<T>(texture, destPowTwo, destPosition);
-            *destPixel      = *srcPixel;
-        }
-    }
+    Swizzle::TiledToTiled((const T*)source, sourcePowTwo, sourceRect, (T*)texture, destPowTwo,
+                          rect.x, rect.y);
 }
 
 void Texture<Console::CTR>::ReplacePixels(const void* data, size_t size, int slice, int mipmap,
@@ -270,6 +279,85 @@ void Texture<Console::CTR>::ReplacePixels(const void* data, size_t size, int sli
     C3D_TexFlush(this->texture);
 }
 
+uint8_t* Texture<Console::CTR>::LockPixels(const Rect& rect, size_t& pitch, int mipmap)
+{
+    if (this->staging)
+        throw love::Exception("Texture pixels are already locked.");
+
+    /* staging is linear and tightly packed; UnlockPixels tiles it with a pitch of rect.w */
+    const auto size = love::GetPixelFormatSliceSize(this->format, rect.w, rect.h, false);
+
+    this->staging       = std::make_unique<uint8_t[]>(size);
+    this->stagingRect   = rect;
+    this->stagingMipmap = mipmap;
+    MemoryStats::Add(MemoryStats::CATEGORY_STAGING, size);
+
+    pitch = rect.w * love::GetPixelFormatBlockSize(this->format);
+
+    return this->staging.get();
+}
+
+void Texture<Console::CTR>::UnlockPixels()
+{
+    if (!this->staging)
+        return;
+
+    const auto& rect = this->stagingRect;
+    const auto width = this->texture->width >> this->stagingMipmap;
+
+    void* data = C3D_TexGetImagePtr(this->texture, this->texture->data, this->stagingMipmap,
+                                    nullptr);
+
+    switch (love::GetPixelFormatBlockSize(this->format))
+    {
+        case 1:
+            Swizzle::LinearToTiled(this->staging.get(), rect.w, (uint8_t*)data, width, rect);
+            break;
+        case 2:
+            Swizzle::LinearToTiled((const uint16_t*)this->staging.get(), rect.w,
+                                   (uint16_t*)data, width, rect);
+            break;
+        default:
+            Swizzle::LinearToTiled((const uint32_t*)this->staging.get(), rect.w,
+                                   (uint32_t*)data, width, rect);
+            break;
+    }
+
+    C3D_TexFlush(this->texture);
+
+    const auto size = love::GetPixelFormatSliceSize(this->format, rect.w, rect.h, false);
+    MemoryStats::Remove(MemoryStats::CATEGORY_STAGING, size);
+
+    this->staging.reset();
+}
+
+void Texture<Console::CTR>::GenerateMipmaps(Mipmapper::Filter filter)
+{
+    this->CheckGenerateMipmaps();
+
+    if (this->texture == nullptr)
+        return;
+
+    /* levels are built from the whole power of two base level */
+    const int width  = this->texture->width;
+    const int height = this->texture->height;
+
+    std::vector<uint32_t> base(width * height);
+    Swizzle::TiledToLinear((const uint32_t*)this->texture->data, width, { 0, 0, width, height },
+                           base.data(), width);
+
+    const auto upload = [&](int mipmap, const uint8_t* pixels, int levelWidth, int levelHeight) {
+        size_t pitch   = 0;
+        uint8_t* level = this->LockPixels({ 0, 0, levelWidth, levelHeight }, pitch, mipmap);
+
+        std::memcpy(level, pixels, pitch * levelHeight);
+        this->UnlockPixels();
+    };
+
+    this->GenerateMipmapLevels((const uint8_t*)base.data(), width, height,
+                               width * sizeof(uint32_t), filter, upload);
+}
+
 void Texture<Console::CTR>::Draw(Graphics<Console::CTR>& graphics,
                                  const Matrix4& matrix)
 {
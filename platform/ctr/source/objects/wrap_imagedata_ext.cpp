@@ -1,5 +1,7 @@
 #include <objects/imagedata/wrap_imagedata.hpp>
 
+#include <utilities/swizzle.hpp>
+
 using namespace love;
 using ImageData = love::ImageData<Console::CTR>;
 
@@ -27,15 +29,17 @@ int Wrap_ImageData::__MapPixelUnsafe(lua_State* L)
     auto pixelSetFunction = self->GetPixelSetFunction();
     auto pixelGetFunction = self->GetPixelGetFunction();
 
-    uint32_t* data   = (uint32_t*)self->GetData();
+    uint8_t* data    = (uint8_t*)self->GetData();
     size_t pixelSize = self->GetPixelSize();
     unsigned _width  = NextPo2(imageWidth);
 
     for (int y = sourceY; y < sourceY + height; y++)
     {
+        uint8_t* row = data + Swizzle::RowOffset(_width, y) * pixelSize;
+
         for (int x = sourceX; x < sourceX + width; x++)
         {
-            auto* pixelData = (::ImageData::Pixel*)Color::FromTile(data, _width, { x, y });
+            auto* pixelData = (::ImageData::Pixel*)(row + Swizzle::ColumnOffset(x) * pixelSize);
 
             Color color {};
             pixelGetFunction(pixelData, color);
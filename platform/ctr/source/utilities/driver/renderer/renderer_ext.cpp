@@ -3,9 +3,12 @@
 
 #include <common/exception.hpp>
 #include <common/luax.hpp>
+#include <common/memorystats.hpp>
 
 #include <algorithm>
 
+#include <modules/profiler/profiler.hpp>
+
 #include <objects/shader_ext.hpp>
 #include <objects/texture_ext.hpp>
 
@@ -41,6 +44,8 @@ Renderer<Console::CTR>::Renderer() : targets {}, currentTexture(nullptr)
     if (!m_vertices)
         throw love::Exception("Out of memory.");
 
+    MemoryStats::Add(MemoryStats::CATEGORY_VERTEX, TOTAL_BUFFER_SIZE);
+
     int result = BufInfo_Add(&this->bufferInfo, (void*)m_vertices, VERTEX_SIZE, 0x03, 0x210);
     C3D_SetBufInfo(&this->bufferInfo);
 
@@ -54,6 +59,7 @@ Renderer<Console::CTR>::Renderer() : targets {}, currentTexture(nullptr)
 Renderer<Console::CTR>::~Renderer()
 {
     linearFree(m_vertices);
+    MemoryStats::Remove(MemoryStats::CATEGORY_VERTEX, TOTAL_BUFFER_SIZE);
 
     C3D_Fini();
     gfxExit();
@@ -136,6 +142,8 @@ using namespace vertex::attributes;
 
 void Renderer<Console::CTR>::FlushVertices()
 {
+    Profiler::Zone zone("graphics.submit");
+
     if (s_dirtyProjection)
     {
         const auto uniforms = Shader<Console::CTR>::current->GetUniformLocations();
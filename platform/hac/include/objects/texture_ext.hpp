@@ -27,10 +27,17 @@ namespace love
         void ReplacePixels(const void* data, size_t size, int slice, int mipmap, const Rect& rect,
                            bool reloadMipmaps);
 
+        /*
+        ** Returns staging memory for @rect of @mipmap, written to by the caller and
+        ** uploaded by UnlockPixels. @pitch receives the row stride in bytes.
+        */
+        uint8_t* LockPixels(const Rect& rect, size_t& pitch, int mipmap = 0);
+
+        void UnlockPixels();
+
         void SetSamplerState(const SamplerState& state);
 
-        void GenerateMipmaps()
-        {}
+        void GenerateMipmaps(Mipmapper::Filter filter = Mipmapper::FILTER_BOX);
 
         bool LoadVolatile();
 
@@ -59,12 +66,18 @@ namespace love
       private:
         void CreateTexture();
 
+        void GenerateMipmaps(const uint8_t* source, size_t pitch, Mipmapper::Filter filter);
+
         DkResHandle textureHandle;
 
         dk::Image image;
         dk::ImageDescriptor descriptor;
         CMemPool::Handle memory;
 
+        CMemPool::Handle staging;
+        Rect stagingRect;
+        int stagingMipmap;
+
         dk::Sampler sampler;
     };
 } // namespace love
@@ -41,36 +41,13 @@ static void dkImageRectFromRect(const Rect& rectangle, DkImageRect& out)
     out.depth  = (uint32_t)1;
 }
 
-static void createTextureObject(dk::Image& image, CMemPool::Handle& memory,
-                                dk::ImageDescriptor& descriptor, const void* data, size_t realSize,
-                                PixelFormat format, Rect rectangle)
+/* records a copy with @record and waits for the transfer queue to finish it */
+template<typename T>
+static void submitTransfer(const T& record)
 {
-    if (data == nullptr)
-        throw love::Exception("No data for Texture.");
-
-    std::optional<DkImageFormat> imageFormat;
-    if (!(imageFormat = Renderer<Console::HAC>::pixelFormats.Find(format)))
-        throw love::Exception("Invalid image format.");
-
-    auto size = love::GetPixelFormatSliceSize(format, rectangle.w, rectangle.h);
-
-    if (realSize != 0)
-        size = realSize;
-
-    if (size <= 0)
-        throw love::Exception("Invalid PixelFormat slice size.");
-
     auto poolId       = Renderer<Console::HAC>::DATA;
     auto& scratchPool = Renderer<Console::HAC>::Instance().GetMemPool(poolId);
 
-    auto tempImageMemory = scratchPool.allocate(size, DK_IMAGE_LINEAR_STRIDE_ALIGNMENT);
-
-    if (!tempImageMemory)
-        throw love::Exception("Failed to allocate temporary memory.");
-
-    /* copy the data into the temp image memory */
-    std::memcpy(tempImageMemory.getCpuAddr(), data, size);
-
     auto device     = Renderer<Console::HAC>::Instance().GetDevice();
     auto tempCmdBuf = dk::CmdBufMaker { device }.create();
 
@@ -84,15 +61,46 @@ static void createTextureObject(dk::Image& image, CMemPool::Handle& memory,
     /* add the memory to the command buffer */
     tempCmdBuf.addMemory(memBlock, offset, memSize);
 
+    record(tempCmdBuf);
+
+    const auto queueId = Renderer<Console::HAC>::QUEUE_IMAGES;
+    auto transferQueue = Renderer<Console::HAC>::Instance().GetQueue(queueId);
+
+    transferQueue.submitCommands(tempCmdBuf.finishList());
+    transferQueue.waitIdle();
+
+    tempCmdMemory.destroy();
+}
+
+/* creates the image; @data is uploaded to its base level unless it is null */
+static void createTextureObject(dk::Image& image, CMemPool::Handle& memory,
+                                dk::ImageDescriptor& descriptor, const void* data, size_t realSize,
+                                PixelFormat format, Rect rectangle, int mipmaps)
+{
+    std::optional<DkImageFormat> imageFormat;
+    if (!(imageFormat = Renderer<Console::HAC>::pixelFormats.Find(format)))
+        throw love::Exception("Invalid image format.");
+
+    auto size = love::GetPixelFormatSliceSize(format, rectangle.w, rectangle.h);
+
+    if (realSize != 0)
+        size = realSize;
+
+    if (size <= 0)
+        throw love::Exception("Invalid PixelFormat slice size.");
+
+    auto device = Renderer<Console::HAC>::Instance().GetDevice();
+
     /* set the image layout */
     dk::ImageLayout layout;
     dk::ImageLayoutMaker { device }
         .setFlags(0)
         .setFormat(*imageFormat)
         .setDimensions(rectangle.w, rectangle.h)
+        .setMipLevels(mipmaps)
         .initialize(layout);
 
-    poolId          = Renderer<Console::HAC>::IMAGE;
+    auto poolId     = Renderer<Console::HAC>::IMAGE;
     auto& imagePool = Renderer<Console::HAC>::Instance().GetMemPool(poolId);
 
     memory = imagePool.allocate(layout.getSize(), layout.getAlignment());
@@ -103,20 +111,30 @@ static void createTextureObject(dk::Image& image, CMemPool::Handle& memory,
     image.initialize(layout, memory.getMemBlock(), memory.getOffset());
     descriptor.initialize(image);
 
+    if (data == nullptr)
+        return;
+
+    poolId            = Renderer<Console::HAC>::DATA;
+    auto& scratchPool = Renderer<Console::HAC>::Instance().GetMemPool(poolId);
+
+    auto tempImageMemory = scratchPool.allocate(size, DK_IMAGE_LINEAR_STRIDE_ALIGNMENT);
+
+    if (!tempImageMemory)
+        throw love::Exception("Failed to allocate temporary memory.");
+
+    /* copy the data into the temp image memory */
+    std::memcpy(tempImageMemory.getCpuAddr(), data, size);
+
     dk::ImageView view { image };
+    view.setMipLevels(0, 1);
 
     DkImageRect dkRectangle {};
     dkImageRectFromRect(rectangle, dkRectangle);
 
-    tempCmdBuf.copyBufferToImage({ tempImageMemory.getGpuAddr() }, view, dkRectangle);
-
-    const auto queueId = Renderer<Console::HAC>::QUEUE_IMAGES;
-    auto transferQueue = Renderer<Console::HAC>::Instance().GetQueue(queueId);
+    submitTransfer([&](dk::CmdBuf& commands) {
+        commands.copyBufferToImage({ tempImageMemory.getGpuAddr() }, view, dkRectangle);
+    });
 
-    transferQueue.submitCommands(tempCmdBuf.finishList());
-    transferQueue.waitIdle();
-
-    tempCmdMemory.destroy();
     tempImageMemory.destroy();
 }
 
@@ -126,14 +144,17 @@ Texture<Console::HAC>::Texture(const Graphics<Console::HAC>* graphics, const Set
     textureHandle(0),
     image {},
     descriptor {},
-    memory {}
+    memory {},
+    staging {},
+    stagingRect {},
+    stagingMipmap(0)
 {
     this->format = graphics->GetSizedFormat(format, this->renderTarget, this->readable);
 
     if (this->mipmapMode == MIPMAPS_AUTO && this->IsCompressed())
         this->mipmapMode = MIPMAPS_MANUAL;
 
-    if (this->mipmapMode != MIPMAPS_NONE)
+    if (this->mipmapMode != MIPMAPS_NONE && this->CanGenerateMipmaps())
         this->mipmapCount =
             Texture<>::GetTotalMipmapCount(this->pixelWidth, this->pixelHeight, this->depth);
 
@@ -225,17 +246,30 @@ void Texture<Console::HAC>::CreateTexture()
     }
     else
     {
-        if (!hasData)
+        const auto size = love::GetPixelFormatSliceSize(this->format, _width, _height);
+        std::vector<uint8_t> empty;
+
+        const uint8_t* pixels = nullptr;
+        size_t pixelsSize     = size;
+
+        if (!hasData && this->clearOnCreate)
         {
-            std::vector<uint8_t> empty(_width * _height, 0);
-            createTextureObject(this->image, this->memory, this->descriptor, empty.data(),
-                                empty.size(), this->format, rectangle);
+            empty.resize(size, 0);
+            pixels = empty.data();
         }
-        else
+        else if (hasData)
         {
-            createTextureObject(this->image, this->memory, this->descriptor,
-                                this->slices.Get(0, 0)->GetData(),
-                                this->slices.Get(0, 0)->GetSize(), this->format, rectangle);
+            pixels     = (const uint8_t*)this->slices.Get(0, 0)->GetData();
+            pixelsSize = this->slices.Get(0, 0)->GetSize();
+        }
+
+        createTextureObject(this->image, this->memory, this->descriptor, pixels, pixelsSize,
+                            this->format, rectangle, this->GetMipmapCount());
+
+        if (pixels != nullptr && this->NeedsMipmapGeneration())
+        {
+            const auto pitch = love::GetPixelFormatSliceSize(this->format, _width, 1);
+            this->GenerateMipmaps(pixels, pitch, Mipmapper::FILTER_BOX);
         }
     }
 
@@ -258,6 +292,7 @@ void Texture<Console::HAC>::SetSamplerState(const SamplerState& state)
 void Texture<Console::HAC>::UnloadVolatile()
 {
     Renderer<Console::HAC>::Instance().UnRegister(this);
+    this->staging.destroy();
     this->memory.destroy();
 }
 
@@ -339,45 +374,116 @@ void Texture<Console::HAC>::ReplacePixels(const void* data, size_t size, int sli
     if (!data || size == 0)
         throw love::Exception("No data for replacement.");
 
+    size_t pitch = 0;
+    std::memcpy(this->LockPixels(rectangle, pitch), data, size);
+
+    this->UnlockPixels();
+}
+
+uint8_t* Texture<Console::HAC>::LockPixels(const Rect& rectangle, size_t& pitch, int mipmap)
+{
+    if (this->staging)
+        throw love::Exception("Texture pixels are already locked.");
+
+    const auto size = love::GetPixelFormatSliceSize(this->format, rectangle.w, rectangle.h);
+
     auto poolId       = Renderer<Console::HAC>::DATA;
     auto& scratchPool = Renderer<Console::HAC>::Instance().GetMemPool(poolId);
 
-    auto tempImageMemory = scratchPool.allocate(size, DK_IMAGE_LINEAR_STRIDE_ALIGNMENT);
+    this->staging = scratchPool.allocate(size, DK_IMAGE_LINEAR_STRIDE_ALIGNMENT);
 
-    if (!tempImageMemory)
+    if (!this->staging)
         throw love::Exception("Failed to allocate temporary memory.");
 
-    /* copy the data into the temp image memory */
-    std::memcpy(tempImageMemory.getCpuAddr(), data, size);
+    this->stagingRect   = rectangle;
+    this->stagingMipmap = mipmap;
+    MemoryStats::Add(MemoryStats::CATEGORY_STAGING, this->staging.getSize());
 
-    auto device     = Renderer<Console::HAC>::Instance().GetDevice();
-    auto tempCmdBuf = dk::CmdBufMaker { device }.create();
+    pitch = love::GetPixelFormatSliceSize(this->format, rectangle.w, 1);
 
-    /* make some memory for the command buffer */
-    auto tempCmdMemory = scratchPool.allocate(DK_MEMBLOCK_ALIGNMENT);
+    return (uint8_t*)this->staging.getCpuAddr();
+}
 
-    const auto& memBlock = tempCmdMemory.getMemBlock();
-    const auto offset    = tempCmdMemory.getOffset();
-    const auto memSize   = tempCmdMemory.getSize();
+void Texture<Console::HAC>::UnlockPixels()
+{
+    if (!this->staging)
+        return;
 
-    /* add the memory to the command buffer */
-    tempCmdBuf.addMemory(memBlock, offset, memSize);
+    dk::ImageView view { this->image };
+    view.setMipLevels(this->stagingMipmap, 1);
+
+    DkImageRect dkRectangle {};
+    dkImageRectFromRect(this->stagingRect, dkRectangle);
+
+    submitTransfer([&](dk::CmdBuf& commands) {
+        commands.copyBufferToImage({ this->staging.getGpuAddr() }, view, dkRectangle);
+    });
+
+    MemoryStats::Remove(MemoryStats::CATEGORY_STAGING, this->staging.getSize());
+    this->staging.destroy();
+}
+
+void Texture<Console::HAC>::GenerateMipmaps(Mipmapper::Filter filter)
+{
+    this->CheckGenerateMipmaps();
+
+    if (!this->memory)
+        return;
+
+    /* the base level only lives in GPU memory, so copy it back first */
+    const Rect rectangle { 0, 0, this->pixelWidth, this->pixelHeight };
+    const auto size = love::GetPixelFormatSliceSize(this->format, rectangle.w, rectangle.h);
+
+    auto poolId       = Renderer<Console::HAC>::DATA;
+    auto& scratchPool = Renderer<Console::HAC>::Instance().GetMemPool(poolId);
+
+    auto readback = scratchPool.allocate(size, DK_IMAGE_LINEAR_STRIDE_ALIGNMENT);
+
+    if (!readback)
+        throw love::Exception("Failed to allocate temporary memory.");
+
+    MemoryStats::Add(MemoryStats::CATEGORY_STAGING, readback.getSize());
 
     dk::ImageView view { this->image };
+    view.setMipLevels(0, 1);
 
     DkImageRect dkRectangle {};
     dkImageRectFromRect(rectangle, dkRectangle);
 
-    tempCmdBuf.copyBufferToImage({ tempImageMemory.getGpuAddr() }, view, dkRectangle);
+    submitTransfer([&](dk::CmdBuf& commands) {
+        commands.copyImageToBuffer(view, dkRectangle, { readback.getGpuAddr() });
+    });
 
-    const auto queueId = Renderer<Console::HAC>::QUEUE_IMAGES;
-    auto transferQueue = Renderer<Console::HAC>::Instance().GetQueue(queueId);
+    const auto pitch = love::GetPixelFormatSliceSize(this->format, rectangle.w, 1);
 
-    transferQueue.submitCommands(tempCmdBuf.finishList());
-    transferQueue.waitIdle();
+    try
+    {
+        this->GenerateMipmaps((const uint8_t*)readback.getCpuAddr(), pitch, filter);
+    }
+    catch (...)
+    {
+        MemoryStats::Remove(MemoryStats::CATEGORY_STAGING, readback.getSize());
+        readback.destroy();
+        throw;
+    }
 
-    tempCmdMemory.destroy();
-    tempImageMemory.destroy();
+    MemoryStats::Remove(MemoryStats::CATEGORY_STAGING, readback.getSize());
+    readback.destroy();
+}
+
+void Texture<Console::HAC>::GenerateMipmaps(const uint8_t* source, size_t pitch,
+                                            Mipmapper::Filter filter)
+{
+    const auto upload = [&](int mipmap, const uint8_t* pixels, int width, int height) {
+        size_t levelPitch = 0;
+        uint8_t* level    = this->LockPixels({ 0, 0, width, height }, levelPitch, mipmap);
+
+        std::memcpy(level, pixels, levelPitch * height);
+        this->UnlockPixels();
+    };
+
+    this->GenerateMipmapLevels(source, this->pixelWidth, this->pixelHeight, pitch, filter,
+                               upload);
 }
 
 void Texture<Console::HAC>::Draw(Graphics<Console::HAC>& graphics, const Matrix4& matrix)
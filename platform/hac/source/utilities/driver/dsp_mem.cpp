@@ -1,5 +1,7 @@
 #include <utilities/driver/dsp_mem.hpp>
 
+#include <common/memorystats.hpp>
+
 /* Audio Pool */
 void* AudioMemory::POOL_BASE = nullptr;
 AudioMemory::MemoryPool AudioMemory::audioPool;
@@ -36,12 +38,15 @@ void* AudioMemory::Align(size_t size, size_t& aligned)
         return nullptr;
 
     aligned = chunk.size;
+    love::MemoryStats::Add(love::MemoryStats::CATEGORY_AUDIO, chunk.size);
+
     return chunk.address;
 }
 
 void AudioMemory::Free(const void* chunk, const size_t size)
 {
     audioPool.DeAllocate((uint8_t*)chunk, size);
+    love::MemoryStats::Remove(love::MemoryStats::CATEGORY_AUDIO, size);
 }
 
 /* Audio Pool's Memory Pool */
@@ -1,6 +1,9 @@
 #include <utilities/driver/renderer_ext.hpp>
 
+#include <common/memorystats.hpp>
+
 #include <modules/graphics_ext.hpp>
+#include <modules/profiler/profiler.hpp>
 
 #include <objects/texture_ext.hpp>
 
@@ -33,6 +36,7 @@ Renderer<Console::HAC>::Renderer() :
     /* allocate our rings */
     this->commands.allocate(this->pools.data, COMMAND_SIZE);
     this->vertices.allocate(this->pools.data, VERTEX_COMMAND_SIZE / 2);
+    MemoryStats::Add(MemoryStats::CATEGORY_VERTEX, this->vertices.getSize() * MAX_RENDERTARGETS);
 
     /* set up the device depth state */
     this->state.depthStencil.setDepthTestEnable(true);
@@ -56,6 +60,8 @@ Renderer<Console::HAC>::~Renderer()
 {
     this->DestroyFramebuffers();
     this->uniformBuffer.destroy();
+
+    MemoryStats::Remove(MemoryStats::CATEGORY_VERTEX, this->vertices.getSize() * MAX_RENDERTARGETS);
 }
 
 Renderer<Console::HAC>::Info Renderer<Console::HAC>::GetRendererInfo()
@@ -281,6 +287,7 @@ void Renderer<Console::HAC>::Present()
     {
         this->vertices.end();
 
+        Profiler::Zone zone("graphics.submit");
         this->mainQueue.submitCommands(this->commands.end(this->commandBuffer));
         this->mainQueue.presentImage(this->swapchain, this->framebuffers.slot);
 
@@ -1,11 +1,14 @@
 #include <common/luax.hpp>
 
+#include <common/memorystats.hpp>
 #include <common/module.hpp>
 #include <common/object.hpp>
 #include <common/reference.hpp>
 #include <common/variant.hpp>
 
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
 #include <math.h>
 
 using namespace love;
@@ -13,8 +16,51 @@ using namespace love;
 static constexpr const char* MAIN_THREAD_KEY = "_love_mainthread";
 static constexpr auto MAX_OBJECT_KEY         = 0x20000000000000ULL;
 
+/* the proxy registry is keyed by this address, as a string key is hashed on every lookup */
+static char objectsKey = 0;
+
 /* main stuff */
 
+static void* allocate(void*, void* pointer, size_t oldSize, size_t newSize)
+{
+    /* Lua 5.1 passes zero for @oldSize when @pointer is null */
+    if (newSize == 0)
+    {
+        MemoryStats::Remove(MemoryStats::CATEGORY_LUA, oldSize);
+        std::free(pointer);
+
+        return nullptr;
+    }
+
+    void* result = std::realloc(pointer, newSize);
+
+    if (result != nullptr)
+    {
+        MemoryStats::Remove(MemoryStats::CATEGORY_LUA, oldSize);
+        MemoryStats::Add(MemoryStats::CATEGORY_LUA, newSize);
+    }
+
+    return result;
+}
+
+static int panic(lua_State* L)
+{
+    std::fprintf(stderr, "PANIC: unprotected error in call to Lua API (%s)\n",
+                 lua_tostring(L, -1));
+
+    return 0;
+}
+
+lua_State* luax::NewState()
+{
+    lua_State* L = lua_newstate(allocate, nullptr);
+
+    if (L != nullptr)
+        lua_atpanic(L, panic);
+
+    return L;
+}
+
 int luax::Preload(lua_State* L, lua_CFunction func, const char* name)
 {
     lua_getglobal(L, "package");
@@ -211,7 +257,9 @@ void luax::RegisterTypeInit(lua_State* L, love::Type* type)
 
         lua_setmetatable(L, -2);
 
-        lua_setfield(L, LUA_REGISTRYINDEX, "_loveobjects");
+        lua_pushlightuserdata(L, &objectsKey);
+        lua_insert(L, -2);
+        lua_rawset(L, LUA_REGISTRYINDEX);
     }
     else
         lua_pop(L, 1);
@@ -418,7 +466,21 @@ int luax::InsistRegistry(lua_State* L, Registry registry)
         case Registry::REGISTRY_MODULES:
             return luax::InsistLOVE(L, "_modules");
         case Registry::REGISTRY_OBJECTS:
-            return luax::Insist(L, LUA_REGISTRYINDEX, "_loveobjects");
+        {
+            luax::GetRegistry(L, registry);
+
+            if (!lua_istable(L, -1))
+            {
+                lua_pop(L, 1);
+                lua_newtable(L);
+
+                lua_pushlightuserdata(L, &objectsKey);
+                lua_pushvalue(L, -2);
+                lua_rawset(L, LUA_REGISTRYINDEX);
+            }
+
+            return 1;
+        }
         default:
             return luaL_error(L, "Attempted to use invalid registry");
     }
@@ -429,7 +491,8 @@ int luax::GetRegistry(lua_State* L, Registry registry)
     switch (registry)
     {
         case Registry::REGISTRY_OBJECTS:
-            lua_getfield(L, LUA_REGISTRYINDEX, "_loveobjects");
+            lua_pushlightuserdata(L, &objectsKey);
+            lua_rawget(L, LUA_REGISTRYINDEX);
             return 1;
         case Registry::REGISTRY_MODULES:
             return luax::GetLOVE(L, "_modules");
@@ -496,7 +559,7 @@ int luax::Release(lua_State* L)
 
             luax::PushObjectKey(L, objectKey);
             lua_pushnil(L);
-            lua_settable(L, -3);
+            lua_rawset(L, -3);
         }
 
         lua_pop(L, 1);
@@ -580,8 +643,9 @@ void luax::PushType(lua_State* L, love::Type& type, Object* object)
     objectkey_t key = luax::ComputeObjectKey(L, object);
 
     // push using that key
+    // the registry is a plain weak table, so skip the metamethod lookup
     luax::PushObjectKey(L, key);
-    lua_gettable(L, -2);
+    lua_rawget(L, -2);
 
     // if the proxy doesn't exist in registry, add it
     if (lua_type(L, -1) != LUA_TUSERDATA)
@@ -592,7 +656,7 @@ void luax::PushType(lua_State* L, love::Type& type, Object* object)
         luax::PushObjectKey(L, key);
         lua_pushvalue(L, -2);
 
-        lua_settable(L, -4);
+        lua_rawset(L, -4);
     }
 
     // remove registry from the stack
@@ -724,11 +788,20 @@ love::Variant luax::CheckVariant(lua_State* L, int index, bool allowUserdata,
                     throw love::Exception("Cycle detected in table!");
             }
 
-            auto* table   = new Variant::SharedTable();
-            size_t length = luax::ObjectLength(L, -1);
+            auto* table = new Variant::SharedTable();
+
+            /* count every key (array and hash part) so the pairs live in one allocation */
+            size_t count = 0;
+            lua_pushnil(L);
+
+            while (lua_next(L, index))
+            {
+                lua_pop(L, 1);
+                count++;
+            }
 
-            if (length > 0)
-                table->pairs.reserve(length);
+            if (count > 0)
+                table->pairs.reserve(count);
 
             lua_pushnil(L);
 
@@ -805,7 +878,18 @@ void luax::PushVariant(lua_State* L, const Variant& variant)
             auto& table   = data.table->pairs;
             int tableSize = (int)table.size();
 
-            lua_createtable(L, 0, tableSize);
+            /* lua_next visits the array part first, so count its leading keys */
+            int arraySize = 0;
+            for (const auto& keyValue : table)
+            {
+                const auto& key = keyValue.first;
+                if (!key.Is(Variant::NUMBER) || key.GetData().number != arraySize + 1)
+                    break;
+
+                arraySize++;
+            }
+
+            lua_createtable(L, arraySize, tableSize - arraySize);
 
             for (int index = 0; index < tableSize; ++index)
             {
@@ -814,7 +898,7 @@ void luax::PushVariant(lua_State* L, const Variant& variant)
                 luax::PushVariant(L, keyValue.first);
                 luax::PushVariant(L, keyValue.second);
 
-                lua_settable(L, -3);
+                lua_rawset(L, -3);
             }
 
             break;
@@ -0,0 +1,42 @@
+#include <common/message.hpp>
+
+#include <utilities/threads/threads.hpp>
+
+#include <mutex>
+
+using namespace love;
+
+static constexpr size_t MAX_POOLED_MESSAGES = 0x40;
+
+/* trivially destructible, so messages released during shutdown are still safe */
+static love::mutex poolMutex;
+static void* pool[MAX_POOLED_MESSAGES];
+static size_t poolSize = 0;
+
+void* Message::operator new(size_t size)
+{
+    if (size == sizeof(Message))
+    {
+        std::unique_lock lock(poolMutex);
+
+        if (poolSize > 0)
+            return pool[--poolSize];
+    }
+
+    return ::operator new(size);
+}
+
+void Message::operator delete(void* memory)
+{
+    {
+        std::unique_lock lock(poolMutex);
+
+        if (poolSize < MAX_POOLED_MESSAGES)
+        {
+            pool[poolSize++] = memory;
+            return;
+        }
+    }
+
+    ::operator delete(memory);
+}
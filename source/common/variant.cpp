@@ -29,7 +29,7 @@ Variant::Variant(const char* string, size_t len)
     else
     {
         type              = STRING;
-        this->data.string = new SharedString(string, len);
+        this->data.string = SharedString::Create(string, len);
     }
 }
 
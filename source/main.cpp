@@ -4,6 +4,8 @@
 #include <utilities/result.hpp>
 
 #include <modules/love/love.hpp>
+#include <modules/profiler/profiler.hpp>
+
 #include <string.h>
 
 using namespace love;
@@ -11,7 +13,7 @@ using namespace love;
 DoneAction RunLOVE(int argc, char** argv, int& retval, Variant& restartValue)
 {
     /* make a new lua state */
-    lua_State* L = luaL_newstate();
+    lua_State* L = luax::NewState();
     luaL_openlibs(L);
 
     luaopen_bit(L);
@@ -105,6 +107,9 @@ int main(int argc, char** argv)
         return 0;
     }
 
+    /* love.run and every zone it opens live on this thread */
+    Profiler::SetThreadName("main");
+
     DoneAction done = love::DONE_QUIT;
     int returnValue = 0;
     Variant restartValue;
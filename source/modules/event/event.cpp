@@ -2,11 +2,16 @@
 #include <utilities/driver/hid_ext.hpp>
 
 #include <modules/joystickmodule_ext.hpp>
+#include <modules/profiler/profiler.hpp>
 #include <modules/touch/touch.hpp>
 
+#include <utilities/driver/renderer/renderer.tcc>
+
 #include <common/console.hpp>
+#include <common/strongreference.hpp>
 
 #include <mutex>
+#include <utility>
 
 using namespace love;
 
@@ -75,7 +80,7 @@ Message* love::Event::ConvertWindowEvent(const LOVE_Event& event, std::vector<Va
         {
             args.emplace_back(event.subType == SUBTYPE_FOCUS_GAINED);
 
-            result = new Message("focus", args);
+            result = new Message("focus", std::move(args));
             break;
         }
         default:
@@ -109,7 +114,7 @@ Message* love::Event::ConvertJoystickEvent(const LOVE_Event& event, std::vector<
 
             args.emplace_back(type, joystick);
 
-            result = new Message("joystickadded", args);
+            result = new Message("joystickadded", std::move(args));
             break;
         }
         case SUBTYPE_GAMEPADREMOVED:
@@ -123,7 +128,7 @@ Message* love::Event::ConvertJoystickEvent(const LOVE_Event& event, std::vector<
 
             args.emplace_back(type, joystick);
 
-            result = new Message("joystickremoved", args);
+            result = new Message("joystickremoved", std::move(args));
             break;
         }
         case SUBTYPE_GAMEPADDOWN:
@@ -142,7 +147,7 @@ Message* love::Event::ConvertJoystickEvent(const LOVE_Event& event, std::vector<
             else if (event.subType == SUBTYPE_GAMEPADUP)
                 name = "gamepadreleased";
 
-            result = new Message(name, args);
+            result = new Message(name, std::move(args));
             break;
         }
         case SUBTYPE_GAMEPADAXIS:
@@ -156,7 +161,7 @@ Message* love::Event::ConvertJoystickEvent(const LOVE_Event& event, std::vector<
             args.emplace_back(event.padAxis.name, strlen(event.padAxis.name));
             args.emplace_back(event.padAxis.value);
 
-            result = new Message("gamepadaxis", args);
+            result = new Message("gamepadaxis", std::move(args));
             break;
         }
         case SUBTYPE_GAMEPADSENSORUPDATED:
@@ -177,7 +182,7 @@ Message* love::Event::ConvertJoystickEvent(const LOVE_Event& event, std::vector<
             args.emplace_back(event.padSensor.data[1]);
             args.emplace_back(event.padSensor.data[2]);
 
-            result = new Message("joysticksensorupdated", args);
+            result = new Message("joysticksensorupdated", std::move(args));
         }
         default:
             break;
@@ -195,7 +200,7 @@ Message* love::Event::ConvertKeyboardEvent(const LOVE_Event& event, std::vector<
         case SUBTYPE_TEXTINPUT:
         {
             args.emplace_back(event.keyboard.text);
-            result = new Message("textinput", args);
+            result = new Message("textinput", std::move(args));
         }
         default:
             break;
@@ -234,7 +239,7 @@ Message* love::Event::ConvertTouchEvent(const LOVE_Event& event, std::vector<Var
     else
         name = "touchmoved";
 
-    return new Message(name, args);
+    return new Message(name, std::move(args));
 }
 
 void love::Event::InternalClear()
@@ -253,18 +258,47 @@ void love::Event::Push(Message* message)
     this->queue.push(message);
 }
 
+void love::Event::Dispatch(const LOVE_Event& event)
+{
+    Message* message = this->Convert(event);
+
+    if (message)
+    {
+        this->Push(message);
+        message->Release();
+    }
+}
+
 void love::Event::Pump()
 {
+    Profiler::Zone zone("event.pump");
+
     while (::HID::Instance().Poll(&this->event))
     {
-        Message* message = this->Convert(this->event);
+        /* live input is dropped while a replay stands in for it */
+        if (!this->replay.IsLiveEvent(this->event))
+            continue;
 
-        if (message)
-        {
-            this->Push(message);
-            message->Release();
-        }
+        this->replay.Record(this->event);
+        this->Dispatch(this->event);
+    }
+
+    while (this->replay.Next(this->event))
+        this->Dispatch(this->event);
+}
+
+double love::Event::Step(double delta)
+{
+    /* taken so a frame that doesn't present isn't charged for an earlier one */
+    const double presentTime = std::exchange(Renderer<>::presentTime, 0.0);
+
+    if (this->replay.Step(delta, presentTime))
+    {
+        StrongReference<Message> message(new Message("replayfinished"), Acquire::NORETAIN);
+        this->Push(message);
     }
+
+    return delta;
 }
 
 bool love::Event::Poll(Message*& message)
@@ -297,8 +331,16 @@ Message* love::Event::Wait()
 
     LOVE_Event event;
 
+    if (this->replay.Next(event))
+        return this->Convert(event);
+
     if (::HID::Instance().Poll(&event) == false)
         return nullptr;
 
+    if (!this->replay.IsLiveEvent(event))
+        return nullptr;
+
+    this->replay.Record(event);
+
     return this->Convert(event);
 }
@@ -0,0 +1,481 @@
+#include <modules/event/replay.hpp>
+
+#include <common/exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+
+using namespace love;
+
+namespace
+{
+    constexpr char MAGIC[4] = { 'L', 'R', 'P', 'L' };
+
+    constexpr size_t HEADER_SIZE = 0x08;
+
+    enum Record
+    {
+        RECORD_FRAME,
+        RECORD_EVENT
+    };
+
+    /* bounds-checked, little-endian reads over a recording */
+    class Reader
+    {
+      public:
+        Reader(const uint8_t* data, size_t size) : data(data), size(size), offset(0)
+        {}
+
+        bool AtEnd() const
+        {
+            return this->offset == this->size;
+        }
+
+        uint8_t Read8()
+        {
+            return *this->Take(1);
+        }
+
+        uint32_t Read32()
+        {
+            const uint8_t* bytes = this->Take(4);
+            return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+        }
+
+        uint64_t Read64()
+        {
+            uint64_t low = this->Read32();
+            return low | (uint64_t)this->Read32() << 32;
+        }
+
+        float ReadFloat()
+        {
+            uint32_t bits = this->Read32();
+
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            return value;
+        }
+
+        double ReadDouble()
+        {
+            uint64_t bits = this->Read64();
+
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const size_t length = this->Read32();
+            return std::string((const char*)this->Take(length), length);
+        }
+
+      private:
+        const uint8_t* Take(size_t count)
+        {
+            if (count > this->size - this->offset)
+                throw love::Exception("Replay data is truncated.");
+
+            const uint8_t* bytes = this->data + this->offset;
+            this->offset += count;
+
+            return bytes;
+        }
+
+        const uint8_t* data;
+        size_t size;
+        size_t offset;
+    };
+} // namespace
+
+static void put8(std::vector<uint8_t>& bytes, uint8_t value)
+{
+    bytes.push_back(value);
+}
+
+static void put32(std::vector<uint8_t>& bytes, uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        bytes.push_back((uint8_t)(value >> shift));
+}
+
+static void put64(std::vector<uint8_t>& bytes, uint64_t value)
+{
+    put32(bytes, (uint32_t)value);
+    put32(bytes, (uint32_t)(value >> 32));
+}
+
+static void putFloat(std::vector<uint8_t>& bytes, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    put32(bytes, bits);
+}
+
+static void putDouble(std::vector<uint8_t>& bytes, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    put64(bytes, bits);
+}
+
+static void putString(std::vector<uint8_t>& bytes, std::string_view string)
+{
+    put32(bytes, (uint32_t)string.size());
+    bytes.insert(bytes.end(), string.begin(), string.end());
+}
+
+/* nearest-rank percentile of sorted @values */
+static double percentile(const std::vector<double>& values, double fraction)
+{
+    size_t rank = (size_t)std::ceil(fraction * values.size());
+    return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+}
+
+static Replay::Timing getTiming(std::vector<double> times)
+{
+    Replay::Timing timing {};
+
+    if (times.empty())
+        return timing;
+
+    std::sort(times.begin(), times.end());
+
+    double total = 0;
+
+    for (double time : times)
+        total += time;
+
+    timing.mean = total / times.size();
+    timing.p95  = percentile(times, 0.95);
+    timing.p99  = percentile(times, 0.99);
+    timing.max  = times.back();
+
+    return timing;
+}
+
+Replay::Replay() :
+    state(STATE_IDLE),
+    recording(),
+    events(),
+    frameEnds(),
+    deltas(),
+    names(),
+    eventIndex(0),
+    frameIndex(0),
+    cpuTimes(),
+    wallTimes()
+{}
+
+void Replay::StartRecording()
+{
+    if (this->state != STATE_IDLE)
+        throw love::Exception("A recording or replay is already running.");
+
+    this->recording.clear();
+    this->recording.insert(this->recording.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    put32(this->recording, VERSION);
+
+    this->state = STATE_RECORDING;
+}
+
+std::vector<uint8_t> Replay::StopRecording()
+{
+    if (this->state != STATE_RECORDING)
+        throw love::Exception("Nothing is being recorded.");
+
+    this->state = STATE_IDLE;
+
+    return std::move(this->recording);
+}
+
+void Replay::Record(const LOVE_Event& event)
+{
+    /* quit, low memory and window events stay live during a replay, so aren't recorded */
+    if (this->state != STATE_RECORDING || !Replay::IsInputEvent(event))
+        return;
+
+    auto& bytes = this->recording;
+
+    put8(bytes, RECORD_EVENT);
+    put8(bytes, (uint8_t)event.type);
+    put8(bytes, (uint8_t)event.subType);
+
+    switch (event.type)
+    {
+        case TYPE_GAMEPAD:
+        {
+            switch (event.subType)
+            {
+                case SUBTYPE_GAMEPADDOWN:
+                case SUBTYPE_GAMEPADUP:
+                    put32(bytes, (uint32_t)event.padButton.id);
+                    put32(bytes, (uint32_t)event.padButton.button);
+                    putString(bytes, event.padButton.name);
+                    break;
+                case SUBTYPE_GAMEPADAXIS:
+                    put32(bytes, (uint32_t)event.padAxis.id);
+                    put32(bytes, (uint32_t)event.padAxis.axis);
+                    putString(bytes, event.padAxis.name);
+                    putFloat(bytes, event.padAxis.value);
+                    break;
+                case SUBTYPE_GAMEPADSENSORUPDATED:
+                    put32(bytes, (uint32_t)event.padSensor.id);
+                    put8(bytes, (uint8_t)event.padSensor.type);
+                    put8(bytes, (uint8_t)event.padSensor.data.size());
+
+                    for (float value : event.padSensor.data)
+                        putFloat(bytes, value);
+
+                    break;
+                default:
+                    put32(bytes, (uint32_t)event.padStatus.id);
+                    break;
+            }
+            break;
+        }
+        case TYPE_TOUCH:
+        {
+            put64(bytes, (uint64_t)event.touchFinger.id);
+            putDouble(bytes, event.touchFinger.x);
+            putDouble(bytes, event.touchFinger.y);
+            putDouble(bytes, event.touchFinger.dx);
+            putDouble(bytes, event.touchFinger.dy);
+            putDouble(bytes, event.touchFinger.pressure);
+            break;
+        }
+        case TYPE_WINDOW:
+        {
+            if (event.subType == SUBTYPE_RESIZE)
+            {
+                put32(bytes, (uint32_t)event.size.width);
+                put32(bytes, (uint32_t)event.size.height);
+            }
+            break;
+        }
+        case TYPE_KEYBOARD:
+            putString(bytes, event.keyboard.text);
+            break;
+        default:
+            break;
+    }
+}
+
+const char* Replay::Intern(std::string&& name)
+{
+    return this->names.insert(std::move(name)).first->c_str();
+}
+
+void Replay::Reset()
+{
+    this->events.clear();
+    this->frameEnds.clear();
+    this->deltas.clear();
+    this->names.clear();
+}
+
+void Replay::Decode(const uint8_t* data, size_t size)
+{
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+        throw love::Exception("Not a replay file.");
+
+    Reader reader(data + sizeof(MAGIC), size - sizeof(MAGIC));
+
+    if (uint32_t version = reader.Read32(); version != VERSION)
+        throw love::Exception("Unsupported replay version %u.", version);
+
+    while (!reader.AtEnd())
+    {
+        const uint8_t record = reader.Read8();
+
+        if (record == RECORD_FRAME)
+        {
+            this->deltas.push_back(reader.ReadDouble());
+            this->frameEnds.push_back(this->events.size());
+
+            continue;
+        }
+        else if (record != RECORD_EVENT)
+            throw love::Exception("Replay data is corrupt.");
+
+        auto& event   = this->events.emplace_back();
+        event.type    = (EventType)reader.Read8();
+        event.subType = (SubEventType)reader.Read8();
+
+        switch (event.type)
+        {
+            case TYPE_GAMEPAD:
+            {
+                switch (event.subType)
+                {
+                    case SUBTYPE_GAMEPADDOWN:
+                    case SUBTYPE_GAMEPADUP:
+                        event.padButton.id     = reader.Read32();
+                        event.padButton.button = (int)reader.Read32();
+                        event.padButton.name   = this->Intern(reader.ReadString());
+                        break;
+                    case SUBTYPE_GAMEPADAXIS:
+                        event.padAxis.id    = reader.Read32();
+                        event.padAxis.axis  = reader.Read32();
+                        event.padAxis.name  = this->Intern(reader.ReadString());
+                        event.padAxis.value = reader.ReadFloat();
+                        break;
+                    case SUBTYPE_GAMEPADSENSORUPDATED:
+                    {
+                        event.padSensor.id   = reader.Read32();
+                        event.padSensor.type = (Sensor::SensorType)reader.Read8();
+                        event.padSensor.data.resize(reader.Read8());
+
+                        for (float& value : event.padSensor.data)
+                            value = reader.ReadFloat();
+
+                        break;
+                    }
+                    default:
+                        event.padStatus.id = reader.Read32();
+                        break;
+                }
+                break;
+            }
+            case TYPE_TOUCH:
+            {
+                event.touchFinger.id       = (int64_t)reader.Read64();
+                event.touchFinger.x        = reader.ReadDouble();
+                event.touchFinger.y        = reader.ReadDouble();
+                event.touchFinger.dx       = reader.ReadDouble();
+                event.touchFinger.dy       = reader.ReadDouble();
+                event.touchFinger.pressure = reader.ReadDouble();
+                break;
+            }
+            case TYPE_WINDOW:
+            {
+                if (event.subType == SUBTYPE_RESIZE)
+                {
+                    reader.Read32();
+                    reader.Read32();
+                }
+
+                /* written by older builds; window events are delivered live instead */
+                this->events.pop_back();
+                break;
+            }
+            case TYPE_KEYBOARD:
+                event.keyboard.text = reader.ReadString();
+                break;
+            case TYPE_GENERAL:
+                /* written by older builds; delivering them again would end the replay early */
+                this->events.pop_back();
+                break;
+            default:
+                throw love::Exception("Replay data is corrupt.");
+        }
+    }
+}
+
+void Replay::StartReplay(const void* data, size_t size)
+{
+    if (this->state != STATE_IDLE)
+        throw love::Exception("A recording or replay is already running.");
+
+    this->Reset();
+
+    try
+    {
+        this->Decode((const uint8_t*)data, size);
+    }
+    catch (love::Exception&)
+    {
+        this->Reset();
+        throw;
+    }
+
+    this->eventIndex = 0;
+    this->frameIndex = 0;
+
+    this->cpuTimes.clear();
+    this->cpuTimes.reserve(this->deltas.size());
+
+    this->wallTimes.clear();
+    this->wallTimes.reserve(this->deltas.size());
+
+    this->state = STATE_REPLAYING;
+}
+
+void Replay::StopReplay()
+{
+    if (this->state != STATE_REPLAYING)
+        return;
+
+    this->state = STATE_IDLE;
+    this->Reset();
+}
+
+bool Replay::Next(LOVE_Event& event)
+{
+    if (this->state != STATE_REPLAYING)
+        return false;
+
+    size_t end = this->events.size();
+
+    if (this->frameIndex < this->frameEnds.size())
+        end = this->frameEnds[this->frameIndex];
+
+    if (this->eventIndex >= end)
+        return false;
+
+    event = this->events[this->eventIndex++];
+
+    return true;
+}
+
+bool Replay::Step(double& delta, double presentTime)
+{
+    if (this->state == STATE_RECORDING)
+    {
+        put8(this->recording, RECORD_FRAME);
+        putDouble(this->recording, delta);
+
+        return false;
+    }
+
+    if (this->state != STATE_REPLAYING)
+        return false;
+
+    /* the first step's time is spent loading the replay, so it isn't counted */
+    if (this->frameIndex > 0)
+    {
+        this->cpuTimes.push_back(std::max(delta - presentTime, 0.0));
+        this->wallTimes.push_back(delta);
+    }
+
+    if (this->frameIndex >= this->deltas.size())
+    {
+        this->StopReplay();
+        return true;
+    }
+
+    /* events the game never pumped are dropped with their frame */
+    this->eventIndex = this->frameEnds[this->frameIndex];
+    delta            = this->deltas[this->frameIndex++];
+
+    return false;
+}
+
+Replay::Stats Replay::GetStats() const
+{
+    Stats stats {};
+
+    stats.frames = (int64_t)this->wallTimes.size();
+    stats.cpu    = getTiming(this->cpuTimes);
+    stats.wall   = getTiming(this->wallTimes);
+
+    return stats;
+}
@@ -3,6 +3,8 @@
 #include <modules/event/event.hpp>
 #include <modules/event/wrap_event.hpp>
 
+#include <modules/filesystem/wrap_filesystem.hpp>
+
 #include <modules/love/love.hpp>
 
 static constexpr char wrap_event_lua[] = {
@@ -76,7 +78,7 @@ int Wrap_Event::Push(lua_State* L)
         }
     }
 
-    StrongReference<Message> message(new Message(name, args), Acquire::NORETAIN);
+    StrongReference<Message> message(new Message(name, std::move(args)), Acquire::NORETAIN);
 
     instance()->Push(message);
     luax::PushBoolean(L, true);
@@ -108,7 +110,7 @@ int Wrap_Event::Quit(lua_State* L)
         for (int index = 1; index <= std::max(1, lua_gettop(L)); index++)
             args.push_back(luax::CheckVariant(L, index));
 
-        StrongReference<Message> message(new Message("quit", args), Acquire::NORETAIN);
+        StrongReference<Message> message(new Message("quit", std::move(args)), Acquire::NORETAIN);
         instance()->Push(message);
     });
 
@@ -126,7 +128,7 @@ int Wrap_Event::Restart(lua_State* L)
         for (int index = 1; index <= lua_gettop(L); index++)
             args.push_back(luax::CheckVariant(L, index));
 
-        StrongReference<Message> message(new Message("quit", args), Acquire::NORETAIN);
+        StrongReference<Message> message(new Message("quit", std::move(args)), Acquire::NORETAIN);
         instance()->Push(message);
     });
 
@@ -135,16 +137,116 @@ int Wrap_Event::Restart(lua_State* L)
     return 1;
 }
 
+int Wrap_Event::StartRecording(lua_State* L)
+{
+    luax::CatchException(L, [&]() { instance()->GetReplay().StartRecording(); });
+
+    return 0;
+}
+
+int Wrap_Event::StopRecording(lua_State* L)
+{
+    std::vector<uint8_t> recording;
+
+    luax::CatchException(L, [&]() { recording = instance()->GetReplay().StopRecording(); });
+
+    lua_pushlstring(L, (const char*)recording.data(), recording.size());
+
+    return 1;
+}
+
+int Wrap_Event::StartReplay(lua_State* L)
+{
+    StrongReference<Data> data(Wrap_Filesystem::GetData(L, 1), Acquire::NORETAIN);
+
+    luax::CatchException(L, [&]() {
+        instance()->GetReplay().StartReplay(data->GetData(), data->GetSize());
+    });
+
+    return 0;
+}
+
+int Wrap_Event::StopReplay(lua_State* L)
+{
+    instance()->GetReplay().StopReplay();
+
+    return 0;
+}
+
+static void setTimingFields(lua_State* L, const Replay::Timing& timing)
+{
+    lua_pushnumber(L, timing.mean);
+    lua_setfield(L, -2, "mean");
+
+    lua_pushnumber(L, timing.p95);
+    lua_setfield(L, -2, "p95");
+
+    lua_pushnumber(L, timing.p99);
+    lua_setfield(L, -2, "p99");
+
+    lua_pushnumber(L, timing.max);
+    lua_setfield(L, -2, "max");
+}
+
+int Wrap_Event::GetReplayStats(lua_State* L)
+{
+    const auto stats = instance()->GetReplay().GetStats();
+
+    if (lua_istable(L, 1))
+        lua_pushvalue(L, 1);
+    else
+        lua_createtable(L, 0, 6);
+
+    lua_pushinteger(L, stats.frames);
+    lua_setfield(L, -2, "frames");
+
+    setTimingFields(L, stats.cpu);
+
+    lua_getfield(L, -1, "wall");
+
+    if (!lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        lua_createtable(L, 0, 4);
+    }
+
+    setTimingFields(L, stats.wall);
+    lua_setfield(L, -2, "wall");
+
+    return 1;
+}
+
+int Wrap_Event::IsRecording(lua_State* L)
+{
+    luax::PushBoolean(L, instance()->GetReplay().GetState() == Replay::STATE_RECORDING);
+
+    return 1;
+}
+
+int Wrap_Event::IsReplaying(lua_State* L)
+{
+    luax::PushBoolean(L, instance()->GetReplay().GetState() == Replay::STATE_REPLAYING);
+
+    return 1;
+}
+
 // clang-format off
 static constexpr luaL_Reg functions[] =
 {
-    { "clear",     Wrap_Event::Clear   },
-    { "poll_i",    poll_i              },
-    { "pump",      Wrap_Event::Pump    },
-    { "push",      Wrap_Event::Push    },
-    { "quit",      Wrap_Event::Quit    },
-    { "restart",   Wrap_Event::Restart },
-    { "wait",      Wrap_Event::Wait    }
+    { "clear",          Wrap_Event::Clear          },
+    { "getReplayStats", Wrap_Event::GetReplayStats },
+    { "isRecording",    Wrap_Event::IsRecording    },
+    { "isReplaying",    Wrap_Event::IsReplaying    },
+    { "poll_i",         poll_i                     },
+    { "pump",           Wrap_Event::Pump           },
+    { "push",           Wrap_Event::Push           },
+    { "quit",           Wrap_Event::Quit           },
+    { "restart",        Wrap_Event::Restart        },
+    { "startRecording", Wrap_Event::StartRecording },
+    { "startReplay",    Wrap_Event::StartReplay    },
+    { "stopRecording",  Wrap_Event::StopRecording  },
+    { "stopReplay",     Wrap_Event::StopReplay     },
+    { "wait",           Wrap_Event::Wait           }
 };
 
 // clang-format on
@@ -0,0 +1,288 @@
+#include <modules/filesystem/filequeue.hpp>
+#include <modules/filesystem/filesystem.hpp>
+
+#include <common/exception.hpp>
+
+#include <modules/event/event.hpp>
+
+#include <algorithm>
+
+using namespace love;
+
+FileQueue::FileQueue(Filesystem* filesystem) :
+    filesystem(filesystem),
+    pending(),
+    sequence(0),
+    finish(false),
+    writers(),
+    signalled(false)
+{
+    this->name = "FileQueue";
+}
+
+FileQueue::~FileQueue()
+{}
+
+void FileQueue::Submit(FileRequest* request)
+{
+    std::unique_lock lock(this->mutex);
+
+    this->pending.emplace_back(request);
+    this->condition.notify_one();
+}
+
+FileRequest* FileQueue::Read(const std::string& filename, int priority)
+{
+    const uint64_t sequence = this->sequence++;
+
+    auto* request = new FileRequest(FileRequest::OPERATION_READ, filename, priority, sequence);
+    this->Submit(request);
+
+    return request;
+}
+
+FileRequest* FileQueue::Write(const std::string& filename, const void* contents, size_t size,
+                              int priority, bool append)
+{
+    const auto operation = append ? FileRequest::OPERATION_APPEND : FileRequest::OPERATION_WRITE;
+
+    const uint64_t sequence = this->sequence++;
+
+    auto* request = new FileRequest(operation, filename, contents, size, priority, sequence);
+    this->Submit(request);
+
+    return request;
+}
+
+void FileQueue::AddWriter(SaveWriter* writer)
+{
+    std::unique_lock lock(this->mutex);
+
+    this->writers.emplace_back(writer);
+    this->condition.notify_one();
+}
+
+void FileQueue::RemoveWriter(SaveWriter* writer)
+{
+    std::unique_lock lock(this->mutex);
+
+    std::erase_if(this->writers, [writer](const StrongReference<SaveWriter>& item) {
+        return item.Get() == writer;
+    });
+}
+
+void FileQueue::Signal()
+{
+    std::unique_lock lock(this->mutex);
+
+    this->signalled = true;
+    this->condition.notify_one();
+}
+
+void FileQueue::SetFinish()
+{
+    std::unique_lock lock(this->mutex);
+
+    this->finish = true;
+    this->condition.notify_one();
+}
+
+void FileQueue::Take(Batch& batch)
+{
+    std::erase_if(this->pending, [](const StrongReference<FileRequest>& request) {
+        return request->GetStatus() == FileRequest::STATUS_CANCELLED;
+    });
+
+    if (this->pending.empty())
+        return;
+
+    const auto before = [](const auto& first, const auto& second) {
+        if (first->GetPriority() != second->GetPriority())
+            return first->GetPriority() > second->GetPriority();
+
+        return first->GetSequence() < second->GetSequence();
+    };
+
+    const auto best = std::min_element(this->pending.begin(), this->pending.end(), before);
+
+    /* start from the oldest request for that file, so its requests stay in order */
+    const std::string filename = (*best)->GetFilename();
+    bool reading               = false;
+
+    for (auto it = this->pending.begin(); it != this->pending.end();)
+    {
+        FileRequest* request = *it;
+
+        if (request->GetFilename() != filename)
+        {
+            ++it;
+            continue;
+        }
+
+        const bool read = request->GetOperation() == FileRequest::OPERATION_READ;
+
+        if (batch.empty())
+            reading = read;
+        else if (read != reading)
+            break;
+
+        if (request->Begin())
+            batch.push_back(*it);
+
+        it = this->pending.erase(it);
+    }
+}
+
+void FileQueue::Notify(FileRequest* request)
+{
+    auto* event = Module::GetInstance<Event>(Module::M_EVENT);
+
+    if (event == nullptr)
+        return;
+
+    std::vector<Variant> args = { Variant(&FileRequest::type, request) };
+
+    StrongReference<Message> message(new Message("filerequest", std::move(args)),
+                                     Acquire::NORETAIN);
+    event->Push(message);
+}
+
+void FileQueue::RunRead(Batch& batch)
+{
+    const std::string& filename = batch.front()->GetFilename();
+
+    StrongReference<FileData> data;
+    std::string error;
+
+    try
+    {
+        data.Set(this->filesystem->Read(filename.c_str()), Acquire::NORETAIN);
+
+        if (!data)
+            error = "File could not be read.";
+    }
+    catch (love::Exception& e)
+    {
+        error = e.what();
+    }
+
+    /* every reader shares the one FileData */
+    for (auto& request : batch)
+    {
+        if (error.empty())
+            request->Finish(data);
+        else
+            request->Fail(error);
+    }
+}
+
+void FileQueue::RunWrite(Batch& batch)
+{
+    const std::string& filename = batch.front()->GetFilename();
+
+    const std::vector<uint8_t>* contents = &batch.front()->GetContents();
+    std::vector<uint8_t> combined;
+
+    bool append = true;
+
+    for (auto& request : batch)
+        append = append && request->GetOperation() == FileRequest::OPERATION_APPEND;
+
+    if (batch.size() > 1)
+    {
+        /* a write discards everything queued before it */
+        for (auto& request : batch)
+        {
+            const auto& bytes = request->GetContents();
+
+            if (request->GetOperation() == FileRequest::OPERATION_WRITE)
+                combined.assign(bytes.begin(), bytes.end());
+            else
+                combined.insert(combined.end(), bytes.begin(), bytes.end());
+        }
+
+        contents = &combined;
+    }
+
+    std::string error;
+
+    try
+    {
+        if (append)
+            this->filesystem->Append(filename.c_str(), contents->data(), contents->size());
+        else
+            this->filesystem->Write(filename.c_str(), contents->data(), contents->size());
+    }
+    catch (love::Exception& e)
+    {
+        error = e.what();
+    }
+
+    for (auto& request : batch)
+    {
+        if (error.empty())
+            request->Finish(nullptr);
+        else
+            request->Fail(error);
+    }
+}
+
+void FileQueue::ThreadFunction()
+{
+    while (true)
+    {
+        Batch batch;
+        Writers writers;
+
+        {
+            std::unique_lock lock(this->mutex);
+
+            const auto wake = [this]() {
+                return this->finish || this->signalled || !this->pending.empty();
+            };
+
+            if (this->writers.empty())
+                this->condition.wait(lock, wake);
+            else
+                this->condition.wait_for(lock, WRITER_POLL_INTERVAL, wake);
+
+            if (this->finish)
+                break;
+
+            this->signalled = false;
+            writers         = this->writers;
+
+            this->Take(batch);
+        }
+
+        for (auto& writer : writers)
+            writer->Poll(false);
+
+        if (batch.empty())
+            continue;
+
+        if (batch.front()->GetOperation() == FileRequest::OPERATION_READ)
+            this->RunRead(batch);
+        else
+            this->RunWrite(batch);
+
+        for (auto& request : batch)
+            this->Notify(request);
+    }
+
+    Writers writers;
+
+    {
+        std::unique_lock lock(this->mutex);
+
+        for (auto& request : this->pending)
+            request->Cancel();
+
+        this->pending.clear();
+        writers.swap(this->writers);
+    }
+
+    /* whatever the writers still hold goes out before the filesystem does */
+    for (auto& writer : writers)
+        writer->Poll(true);
+}
@@ -1,14 +1,37 @@
 #include <common/console.hpp>
+#include <common/exception.hpp>
+#include <common/luax.hpp>
+#include <common/version.hpp>
 
 #include <utilities/bidirectionalmap/bidirectionalmap.hpp>
+#include <utilities/hashfunction/fnv1a.hpp>
 
 #include <algorithm>
+#include <cstdio>
 #include <filesystem>
 
+#include <modules/filesystem/filequeue.hpp>
 #include <modules/filesystem/filesystem.hpp>
 
 using namespace love;
 
+static std::size_t replaceAll(std::string& inout, std::string_view what, std::string_view with)
+{
+    std::size_t count {};
+    for (std::string::size_type pos {};
+         inout.npos != (pos = inout.find(what.data(), pos, what.length()));
+         pos += with.length(), ++count)
+    {
+        inout.replace(pos, what.length(), with.data(), with.length());
+    }
+    return count;
+}
+
+Filesystem::~Filesystem()
+{
+    this->StopQueue();
+}
+
 FileData* Filesystem::NewFileData(const void* data, size_t size, const char* filename) const
 {
     auto* fileData = new FileData(size, filename);
@@ -17,6 +40,165 @@ FileData* Filesystem::NewFileData(const void* data, size_t size, const char* fil
     return fileData;
 }
 
+FileQueue* Filesystem::GetQueue()
+{
+    std::unique_lock lock(this->queueMutex);
+
+    if (this->queue == nullptr)
+    {
+        auto* queue = new FileQueue(this);
+
+        if (!queue->Start())
+        {
+            queue->Release();
+            throw love::Exception("Could not start the file I/O thread.");
+        }
+
+        this->queue = queue;
+    }
+
+    return this->queue;
+}
+
+void Filesystem::StopQueue()
+{
+    std::unique_lock lock(this->queueMutex);
+
+    if (this->queue == nullptr)
+        return;
+
+    this->queue->SetFinish();
+    this->queue->Wait();
+
+    this->queue->Release();
+    this->queue = nullptr;
+}
+
+FileRequest* Filesystem::ReadAsync(const char* filename, int priority)
+{
+    return this->GetQueue()->Read(filename, priority);
+}
+
+FileRequest* Filesystem::WriteAsync(const char* filename, const void* data, int64_t size,
+                                    int priority, bool append)
+{
+    return this->GetQueue()->Write(filename, data, size, priority, append);
+}
+
+SaveWriter* Filesystem::NewSaveWriter(const char* filename, const SaveWriter::Settings& settings)
+{
+    auto* writer = new SaveWriter(this, filename, settings);
+
+    try
+    {
+        this->GetQueue()->AddWriter(writer);
+    }
+    catch (love::Exception&)
+    {
+        writer->Release();
+        throw;
+    }
+
+    return writer;
+}
+
+void Filesystem::PollSaveWriters()
+{
+    this->GetQueue()->Signal();
+}
+
+void Filesystem::CloseSaveWriter(SaveWriter* writer)
+{
+    if (writer->IsClosed())
+        return;
+
+    writer->SetClosed();
+    this->GetQueue()->RemoveWriter(writer);
+
+    writer->Poll(true);
+}
+
+bool Filesystem::FindModule(const std::string& module, std::string& path)
+{
+    std::unique_lock lock(this->modulePathsMutex);
+
+    this->lookups++;
+
+    const uint64_t current = generation.load();
+
+    if (this->modulePathsGeneration != current)
+    {
+        this->modulePaths.clear();
+        this->modulePathsGeneration = current;
+    }
+
+    if (auto iterator = this->modulePaths.find(module); iterator != this->modulePaths.end())
+    {
+        this->cacheHits++;
+        path = iterator->second;
+
+        return !path.empty();
+    }
+
+    std::string resolved {};
+
+    for (std::string element : this->GetRequirePath())
+    {
+        replaceAll(element, "?", module);
+
+        Info info {};
+        this->statCalls++;
+
+        if (this->GetInfo(element.c_str(), info) && info.type != FILETYPE_DIRECTORY)
+        {
+            resolved = std::move(element);
+            break;
+        }
+    }
+
+    path                      = resolved;
+    this->modulePaths[module] = std::move(resolved);
+
+    return !path.empty();
+}
+
+void Filesystem::ClearModulePaths()
+{
+    std::unique_lock lock(this->modulePathsMutex);
+    this->modulePaths.clear();
+}
+
+Filesystem::RequireStats Filesystem::GetRequireStats() const
+{
+    RequireStats stats {};
+
+    stats.lookups     = this->lookups.load();
+    stats.cacheHits   = this->cacheHits.load();
+    stats.stats       = this->statCalls.load();
+    stats.bytesParsed = this->bytesParsed.load();
+
+    stats.bytecodeHits = this->bytecodeHits.load();
+
+    return stats;
+}
+
+std::string Filesystem::GetBytecodePath(const std::string& name, uint64_t sourceHash,
+                                        size_t sourceSize)
+{
+    static constexpr std::string_view version = __APP_VERSION__ "/" LUA_VERSION;
+
+    const uint64_t nameKey = love::FNV1a(name.data(), name.size());
+
+    uint64_t sourceKey = love::FNV1a(version.data(), version.size());
+    sourceKey          = love::FNV1a(&sourceHash, sizeof(sourceHash), sourceKey) ^ sourceSize;
+
+    char filename[0x30] {};
+    std::snprintf(filename, sizeof(filename), "%016llx-%016llx.luac",
+                  (unsigned long long)nameKey, (unsigned long long)sourceKey);
+
+    return std::string(BYTECODE_DIRECTORY) + "/" + filename;
+}
+
 bool Filesystem::GetRealPathType(const std::string& path, FileType& type) const
 {
     if (!std::filesystem::exists(path))
@@ -1,5 +1,6 @@
 #include <common/console.hpp>
 #include <modules/filesystem/physfs/filesystem.hpp>
+#include <modules/filesystem/physfs/packarchive.hpp>
 
 #include <physfs.h>
 
@@ -14,7 +15,9 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cstdio>
 #include <filesystem>
+#include <string_view>
 
 #define APPDATA_FOLDER ""
 #define APPDATA_PREFIX ""
@@ -25,6 +28,169 @@
 
 using namespace love::physfs;
 
+/*
+** Finds the entries of a zip archive in memory that are stored without compression, so that
+** reading them can hand out a view of the archive rather than a copy. Anything unusual is
+** left for PhysFS to read as before.
+*/
+static void indexStoredEntries(const love::Data* data,
+                               std::unordered_map<std::string, std::pair<size_t, size_t>>& entries)
+{
+    static constexpr uint32_t END_SIGNATURE     = 0x06054B50;
+    static constexpr uint32_t CENTRAL_SIGNATURE = 0x02014B50;
+    static constexpr uint32_t LOCAL_SIGNATURE   = 0x04034B50;
+
+    static constexpr size_t END_SIZE     = 0x16;
+    static constexpr size_t CENTRAL_SIZE = 0x2E;
+    static constexpr size_t LOCAL_SIZE   = 0x1E;
+
+    const auto* bytes = (const uint8_t*)data->GetData();
+    const size_t size = data->GetSize();
+
+    const auto read16 = [bytes](size_t at) -> uint32_t { return bytes[at] | bytes[at + 1] << 8; };
+    const auto read32 = [&read16](size_t at) { return read16(at) | read16(at + 2) << 16; };
+
+    /* too small to hold a single entry */
+    if (size < CENTRAL_SIZE + END_SIZE)
+        return;
+
+    /* the end of central directory record may be followed by a comment of up to 64 KiB */
+    size_t end          = size - END_SIZE;
+    const size_t lowest = end > 0xFFFF ? end - 0xFFFF : 0;
+
+    while (read32(end) != END_SIGNATURE)
+    {
+        if (end == lowest)
+            return;
+
+        end--;
+    }
+
+    const uint32_t count = read16(end + 0x0A);
+    size_t entry         = read32(end + 0x10);
+
+    for (uint32_t index = 0; index < count; index++)
+    {
+        if (entry > size - CENTRAL_SIZE || read32(entry) != CENTRAL_SIGNATURE)
+            return;
+
+        const uint32_t flags        = read16(entry + 0x08);
+        const uint32_t method       = read16(entry + 0x0A);
+        const uint32_t compressed   = read32(entry + 0x14);
+        const uint32_t uncompressed = read32(entry + 0x18);
+        const uint32_t nameLength   = read16(entry + 0x1C);
+        const size_t local          = read32(entry + 0x2A);
+
+        const size_t next = entry + CENTRAL_SIZE + nameLength + read16(entry + 0x1E) +
+                            read16(entry + 0x20);
+
+        if (next > size)
+            return;
+
+        std::string name((const char*)bytes + entry + CENTRAL_SIZE, nameLength);
+        entry = next;
+
+        /* compressed, encrypted, zip64 and directory entries */
+        if (method != 0 || (flags & 0x01) || compressed != uncompressed)
+            continue;
+
+        if (compressed == 0xFFFFFFFF || name.empty() || name.back() == '/')
+            continue;
+
+        if (local > size - LOCAL_SIZE || read32(local) != LOCAL_SIGNATURE)
+            continue;
+
+        const size_t offset = local + LOCAL_SIZE + read16(local + 0x1A) + read16(local + 0x1C);
+
+        if (offset > size || uncompressed > size - offset)
+            continue;
+
+        entries[name] = { offset, uncompressed };
+    }
+}
+
+/* real path of @filename in the save directory, or empty if there is none */
+static std::string getWritePath(const char* filename)
+{
+    const char* writeDirectory = PHYSFS_getWriteDir();
+
+    if (writeDirectory == nullptr)
+        return std::string();
+
+    return normalize(writeDirectory + std::string(PATH_SEPARATOR) + filename);
+}
+
+/* staging names owned by Replace, so they never collide with a game's own files */
+static constexpr std::string_view REPLACE_TEMPORARY = ".love-replace.tmp";
+static constexpr std::string_view REPLACE_BACKUP    = ".love-replace.bak";
+
+/*
+** Moves @temporary over @target. Where the console won't rename over an existing file, the
+** original is moved to @backup first and removed last, so that at every step one of the
+** three names holds a complete copy for recoverReplaced to find.
+*/
+static bool replaceFile(const std::string& temporary, const std::string& target,
+                        const std::string& backup)
+{
+    if (std::rename(temporary.c_str(), target.c_str()) == 0)
+        return true;
+
+    /* left over from a replace that was cut short after its second rename */
+    std::remove(backup.c_str());
+
+    if (std::rename(target.c_str(), backup.c_str()) != 0)
+        return false;
+
+    if (std::rename(temporary.c_str(), target.c_str()) != 0)
+    {
+        std::rename(backup.c_str(), target.c_str());
+        return false;
+    }
+
+    std::remove(backup.c_str());
+
+    return true;
+}
+
+/*
+** Finishes every Replace under @directory that was cut short between its renames: where a
+** backup is left and its target is missing, the target is restored. Runs once, when the save
+** directory is mounted, rather than on every lookup.
+*/
+static void recoverReplaced(const std::string& directory)
+{
+    std::error_code error;
+    std::vector<std::string> backups;
+
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end;
+         !error && it != end; it.increment(error))
+    {
+        const std::string path = it->path().string();
+
+        if (path.ends_with(REPLACE_BACKUP))
+            backups.push_back(path);
+    }
+
+    for (const auto& backup : backups)
+    {
+        const std::string target    = backup.substr(0, backup.size() - REPLACE_BACKUP.size());
+        const std::string temporary = target + std::string(REPLACE_TEMPORARY);
+
+        /* the target is only missing between a replace's second and third rename */
+        if (!std::filesystem::exists(target, error))
+        {
+            /* the .tmp was complete before the original was moved aside, so it is newer */
+            if (std::rename(temporary.c_str(), target.c_str()) != 0 &&
+                std::rename(backup.c_str(), target.c_str()) != 0)
+            {
+                continue;
+            }
+        }
+
+        std::remove(backup.c_str());
+    }
+}
+
 static std::string getApplicationPath(std::string origin)
 {
 #if defined(__EMULATION__)
@@ -77,6 +243,8 @@ Filesystem::Filesystem() :
 
 Filesystem::~Filesystem()
 {
+    this->StopQueue();
+
     if (PHYSFS_isInit())
         PHYSFS_deinit();
 }
@@ -101,6 +269,8 @@ bool Filesystem::SetupWriteDirectory()
     if (!PHYSFS_isInit())
         return false;
 
+    std::unique_lock lock(this->writeDirectoryMutex);
+
     if (!this->saveDirectoryNeedsMounting)
         return true;
 
@@ -148,6 +318,9 @@ void Filesystem::Init(const char* arg0)
 
     PHYSFS_setWriteDir(nullptr);
 
+    if (!PackArchive::Register())
+        throw love::Exception("Failed to register pack archives: %s", Filesystem::GetLastError());
+
     this->SetSymlinksEnabled(false);
 }
 
@@ -176,6 +349,8 @@ bool Filesystem::SetIdentity(const char* identity, bool appendToPath)
     if (identity == nullptr || strlen(identity) == 0)
         return false;
 
+    std::unique_lock lock(this->writeDirectoryMutex);
+
     for (auto path : this->appCommonPaths)
     {
         if (!this->commonPathMountInfo[path].mounted)
@@ -184,7 +359,10 @@ bool Filesystem::SetIdentity(const char* identity, bool appendToPath)
         std::string fullPath = this->GetFullCommonPath(path);
 
         if (!fullPath.empty() && !PHYSFS_unmount(fullPath.c_str()))
+        {
+            Filesystem::Invalidate();
             return false;
+        }
     }
 
     std::array<bool, CommonPath::PATH_MAX_ENUM> oldMountedCommonPaths = { false };
@@ -223,6 +401,8 @@ bool Filesystem::SetIdentity(const char* identity, bool appendToPath)
         }
     }
 
+    Filesystem::Invalidate();
+
     return true;
 }
 
@@ -244,6 +424,7 @@ bool Filesystem::SetSource(const char* source)
         return false;
 
     this->gameSource = search;
+    Filesystem::Invalidate();
 
     return true;
 }
@@ -346,6 +527,12 @@ bool Filesystem::MountCommonPathInternal(CommonPath path, const char* mountPoint
         std::string mount               = (mountPoint != nullptr) ? mountPoint : "/";
         this->commonPathMountInfo[path] = { true, mount, permissions };
 
+        if (path == CommonPath::APP_SAVEDIR)
+        {
+            recoverReplaced(fullPath);
+            Filesystem::Invalidate();
+        }
+
         return true;
     }
 
@@ -369,11 +556,19 @@ bool Filesystem::MountFullPath(const char* archive, const char* mountPoint,
     {
         if (!PHYSFS_setWriteDir(archive))
             return false;
+
+        /* the write directory changed even if the mount below fails */
+        Filesystem::Invalidate();
     }
 
     // if (permissions == MountPermissions::READWRITE)
     //     return PHYSFS_mountRW(archive, mountPoint, appendToPath) != 0;
-    return PHYSFS_mount(archive, mountPoint, appendToPath) != 0;
+    if (PHYSFS_mount(archive, mountPoint, appendToPath) == 0)
+        return false;
+
+    Filesystem::Invalidate();
+
+    return true;
 }
 
 bool Filesystem::Mount(const char* archive, const char* mountPoint, bool appendToPath)
@@ -419,10 +614,26 @@ bool Filesystem::Mount(Data* data, const char* archiveName, const char* mountPoi
     if (!PHYSFS_isInit())
         return false;
 
+    std::unique_lock lock(this->mountMutex);
+
     if (PHYSFS_mountMemory(data->GetData(), data->GetSize(), nullptr, archiveName, mountPoint,
                            appendToPath))
     {
-        this->mountedData[archiveName] = data;
+        auto& mounted = this->mountedData[archiveName];
+
+        mounted.data.Set(data);
+        mounted.mountPoint = mountPoint != nullptr ? mountPoint : "";
+
+        while (!mounted.mountPoint.empty() && mounted.mountPoint.front() == '/')
+            mounted.mountPoint.erase(0, 1);
+
+        while (!mounted.mountPoint.empty() && mounted.mountPoint.back() == '/')
+            mounted.mountPoint.pop_back();
+
+        mounted.storedEntries.clear();
+        indexStoredEntries(data, mounted.storedEntries);
+
+        Filesystem::Invalidate();
 
         return true;
     }
@@ -435,13 +646,17 @@ bool Filesystem::UnMount(const char* archive)
     if (!PHYSFS_isInit() || !archive)
         return false;
 
-    auto mountedIterator = this->mountedData.find(archive);
-
-    if (mountedIterator != mountedData.end() && PHYSFS_unmount(archive) != 0)
     {
-        this->mountedData.erase(mountedIterator);
+        std::unique_lock lock(this->mountMutex);
+        auto mountedIterator = this->mountedData.find(archive);
 
-        return true;
+        if (mountedIterator != mountedData.end() && PHYSFS_unmount(archive) != 0)
+        {
+            this->mountedData.erase(mountedIterator);
+            Filesystem::Invalidate();
+
+            return true;
+        }
     }
 
     auto allowedIterator = std::find(allowedMountPaths.begin(), allowedMountPaths.end(), archive);
@@ -468,7 +683,12 @@ bool Filesystem::UnMount(const char* archive)
     if (PHYSFS_getMountPoint(realPath.c_str()) == nullptr)
         return false;
 
-    return (PHYSFS_unmount(realPath.c_str()) != 0);
+    if (PHYSFS_unmount(realPath.c_str()) == 0)
+        return false;
+
+    Filesystem::Invalidate();
+
+    return true;
 }
 
 bool Filesystem::UnMountFullPath(const char* fullPath)
@@ -476,7 +696,12 @@ bool Filesystem::UnMountFullPath(const char* fullPath)
     if (!PHYSFS_isInit() || !fullPath)
         return false;
 
-    return (PHYSFS_unmount(fullPath) != 0);
+    if (PHYSFS_unmount(fullPath) == 0)
+        return false;
+
+    Filesystem::Invalidate();
+
+    return true;
 }
 
 bool Filesystem::UnMount(CommonPath path)
@@ -495,17 +720,22 @@ bool Filesystem::UnMount(CommonPath path)
 
 bool Filesystem::UnMount(Data* data)
 {
-    for (const auto& dataPair : this->mountedData)
+    std::string archive;
+
     {
-        if (dataPair.second.Get() == data)
-        {
-            std::string archive = dataPair.first;
+        std::unique_lock lock(this->mountMutex);
 
-            return this->UnMount(archive.c_str());
-        }
+        const auto iterator =
+            std::find_if(this->mountedData.begin(), this->mountedData.end(),
+                         [data](const auto& pair) { return pair.second.data.Get() == data; });
+
+        if (iterator == this->mountedData.end())
+            return false;
+
+        archive = iterator->first;
     }
 
-    return false;
+    return this->UnMount(archive.c_str());
 }
 
 love::File* Filesystem::OpenFile(const char* filename, File::Mode mode) const
@@ -574,12 +804,24 @@ std::string Filesystem::GetRealDirectory(const char* filename) const
     return std::string(directory);
 }
 
-bool Filesystem::Exists(const char* filepath) const
+Filesystem::MetadataCache& Filesystem::GetMetadataCache() const
 {
-    if (!PHYSFS_isInit())
-        return false;
+    const uint64_t generation = Filesystem::GetGeneration();
+
+    if (this->metadata.generation != generation)
+    {
+        this->metadata.infos.clear();
+        this->metadata.directories.clear();
+        this->metadata.generation = generation;
+    }
 
-    return PHYSFS_exists(filepath) != 0;
+    return this->metadata;
+}
+
+bool Filesystem::Exists(const char* filepath) const
+{
+    Info info {};
+    return this->GetInfo(filepath, info);
 }
 
 bool Filesystem::GetInfo(const char* filepath, Info& info) const
@@ -587,10 +829,27 @@ bool Filesystem::GetInfo(const char* filepath, Info& info) const
     if (!PHYSFS_isInit())
         return false;
 
+    std::unique_lock lock(this->metadataMutex);
+    auto& infos = this->GetMetadataCache().infos;
+
+    if (auto iterator = infos.find(filepath); iterator != infos.end())
+    {
+        if (iterator->second)
+            info = *iterator->second;
+
+        return iterator->second.has_value();
+    }
+
+    if (infos.size() >= MAX_CACHED_PATHS)
+        infos.clear();
+
     PHYSFS_Stat stat {};
 
     if (!PHYSFS_stat(filepath, &stat))
+    {
+        infos.emplace(filepath, std::nullopt);
         return false;
+    }
 
     info.size     = stat.filesize;
     info.modtime  = stat.modtime;
@@ -605,6 +864,8 @@ bool Filesystem::GetInfo(const char* filepath, Info& info) const
     else
         info.type = FileType::FILETYPE_OTHER;
 
+    infos.emplace(filepath, info);
+
     return true;
 }
 
@@ -619,6 +880,8 @@ bool Filesystem::CreateDirectory(const char* directory)
     if (!PHYSFS_mkdir(directory))
         return false;
 
+    Filesystem::Invalidate();
+
     return true;
 }
 
@@ -633,6 +896,8 @@ bool Filesystem::Remove(const char* file)
     if (!PHYSFS_delete(file))
         return false;
 
+    Filesystem::Invalidate();
+
     return true;
 }
 
@@ -643,8 +908,55 @@ love::FileData* Filesystem::Read(const char* filename, int64_t size) const
     return file.Read(size);
 }
 
+love::FileData* Filesystem::ReadStoredEntry(const char* filename) const
+{
+    /* the file queue reads through here while the main thread may be mounting */
+    std::unique_lock lock(this->mountMutex);
+
+    if (this->mountedData.empty())
+        return nullptr;
+
+    const char* archive = PHYSFS_getRealDir(filename);
+
+    if (archive == nullptr)
+        return nullptr;
+
+    const auto iterator = this->mountedData.find(archive);
+
+    if (iterator == this->mountedData.end())
+        return nullptr;
+
+    const auto& mounted = iterator->second;
+    std::string_view path(filename);
+
+    while (!path.empty() && path.front() == '/')
+        path.remove_prefix(1);
+
+    if (!mounted.mountPoint.empty())
+    {
+        const size_t length = mounted.mountPoint.size();
+
+        if (!path.starts_with(mounted.mountPoint) || path.size() <= length || path[length] != '/')
+            return nullptr;
+
+        path.remove_prefix(length + 1);
+    }
+
+    const auto entry = mounted.storedEntries.find(std::string(path));
+
+    if (entry == mounted.storedEntries.end())
+        return nullptr;
+
+    const auto [offset, size] = entry->second;
+
+    return new FileData(mounted.data.Get(), offset, size, filename);
+}
+
 love::FileData* Filesystem::Read(const char* filename) const
 {
+    if (auto* view = this->ReadStoredEntry(filename))
+        return view;
+
     File file(filename, File::MODE_READ);
 
     return file.Read();
@@ -666,20 +978,112 @@ void Filesystem::Append(const char* filename, const void* data, int64_t size) co
         throw love::Exception("Data could not be written.");
 }
 
+void Filesystem::WriteCache(const char* filename, const void* data, int64_t size)
+{
+    if (!PHYSFS_isInit() || !this->SetupWriteDirectory())
+        throw love::Exception("Could not set write directory.");
+
+    const std::string directory = parentize(filename);
+
+    if (!directory.empty() && !PHYSFS_mkdir(directory.c_str()))
+        throw love::Exception("Could not create directory %s.", directory.c_str());
+
+    /* opened directly, as a File would forget every module lookup when it closes */
+    PHYSFS_File* file = PHYSFS_openWrite(filename);
+
+    if (file == nullptr)
+        throw love::Exception("Could not open file %s.", filename);
+
+    const bool written = PHYSFS_writeBytes(file, data, size) == size;
+    const bool closed  = PHYSFS_close(file) != 0;
+
+    this->ForgetMetadata(filename);
+
+    if (!written || !closed)
+        throw love::Exception("Data could not be written.");
+}
+
+bool Filesystem::RemoveCache(const char* filename)
+{
+    if (!PHYSFS_isInit() || !this->SetupWriteDirectory() || !PHYSFS_delete(filename))
+        return false;
+
+    this->ForgetMetadata(filename);
+
+    return true;
+}
+
+void Filesystem::ForgetMetadata(const char* filename) const
+{
+    const std::string directory = parentize(filename);
+
+    std::unique_lock lock(this->metadataMutex);
+    auto& cache = this->GetMetadataCache();
+
+    cache.infos.erase(filename);
+    cache.infos.erase(directory);
+    cache.directories.erase(directory);
+}
+
+void Filesystem::InvalidatePath(const char* filename)
+{
+    this->ForgetMetadata(filename);
+    this->ClearModulePaths();
+}
+
+void Filesystem::Replace(const char* filename, const void* data, int64_t size) const
+{
+    this->Write((std::string(filename) + std::string(REPLACE_TEMPORARY)).c_str(), data, size);
+
+    const std::string target = getWritePath(filename);
+
+    if (target.empty())
+        throw love::Exception("Could not set write directory.");
+
+    const std::string temporary = target + std::string(REPLACE_TEMPORARY);
+    const std::string backup    = target + std::string(REPLACE_BACKUP);
+
+    const bool replaced = replaceFile(temporary, target, backup);
+    Filesystem::Invalidate();
+
+    if (!replaced)
+        throw love::Exception("Could not replace %s.", filename);
+}
+
 bool Filesystem::GetDirectoryItems(const char* directory, std::vector<std::string>& items)
 {
     if (!PHYSFS_isInit())
         return false;
 
-    char** files = PHYSFS_enumerateFiles(directory);
+    std::unique_lock lock(this->metadataMutex);
+    auto& directories = this->GetMetadataCache().directories;
 
-    if (files == nullptr)
-        return false;
+    auto iterator = directories.find(directory);
 
-    for (auto file = files; *file != nullptr; file++)
-        items.push_back(*file);
+    if (iterator == directories.end())
+    {
+        if (directories.size() >= MAX_CACHED_PATHS)
+            directories.clear();
+
+        std::optional<std::vector<std::string>> listing;
+
+        if (char** files = PHYSFS_enumerateFiles(directory))
+        {
+            listing.emplace();
+
+            for (auto file = files; *file != nullptr; file++)
+                listing->push_back(*file);
+
+            PHYSFS_freeList(files);
+        }
+
+        iterator = directories.emplace(directory, std::move(listing)).first;
+    }
 
-    PHYSFS_freeList(files);
+    if (!iterator->second)
+        return false;
+
+    items.insert(items.end(), iterator->second->begin(), iterator->second->end());
 
     return true;
 }
@@ -689,6 +1093,8 @@ void Filesystem::SetSymlinksEnabled(bool enable)
     if (!PHYSFS_isInit())
         return;
 
+    Filesystem::Invalidate();
+
     PHYSFS_permitSymbolicLinks(enable ? 1 : 0);
 }
 
@@ -0,0 +1,831 @@
+#include <modules/filesystem/physfs/packarchive.hpp>
+
+#include <common/exception.hpp>
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <physfs.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace love::physfs;
+
+namespace
+{
+    constexpr char MAGIC[4] = { 'L', 'P', 'A', 'K' };
+
+    constexpr size_t HEADER_SIZE = 0x20;
+    constexpr size_t RECORD_SIZE = 0x30;
+
+    struct Entry
+    {
+        std::string name;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t storedSize;
+        int64_t modtime;
+        uint32_t storage;
+    };
+
+    struct Archive
+    {
+        PHYSFS_Io* io;
+        uint32_t blockSize;
+
+        /* sorted by name */
+        std::vector<Entry> entries;
+    };
+
+    struct Handle
+    {
+        const Archive* archive;
+        const Entry* entry;
+
+        /* our own duplicate of the archive's Io, so handles don't fight over its position */
+        PHYSFS_Io* io;
+        uint64_t position;
+
+        std::vector<uint32_t> seekTable;
+        std::vector<uint8_t> block;
+        std::vector<uint8_t> packed;
+
+        int64_t cachedBlock;
+        size_t blockLength;
+
+        ~Handle()
+        {
+            if (this->io != nullptr)
+                this->io->destroy(this->io);
+        }
+    };
+} // namespace
+
+static uint32_t read32(const uint8_t* bytes)
+{
+    return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+static uint64_t read64(const uint8_t* bytes)
+{
+    return read32(bytes) | (uint64_t)read32(bytes + 4) << 32;
+}
+
+static void put32(std::vector<uint8_t>& bytes, uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        bytes.push_back((uint8_t)(value >> shift));
+}
+
+static void put64(std::vector<uint8_t>& bytes, uint64_t value)
+{
+    put32(bytes, (uint32_t)value);
+    put32(bytes, (uint32_t)(value >> 32));
+}
+
+static const char* lastError()
+{
+    return PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode());
+}
+
+static bool readExactly(PHYSFS_Io* io, void* buffer, uint64_t length)
+{
+    return io->read(io, buffer, length) == (PHYSFS_sint64)length;
+}
+
+/* the first entry at or after @name */
+static std::vector<Entry>::const_iterator lowerBound(const Archive* archive, std::string_view name)
+{
+    return std::lower_bound(archive->entries.begin(), archive->entries.end(), name,
+                            [](const Entry& entry, std::string_view name) {
+                                return std::string_view(entry.name) < name;
+                            });
+}
+
+static const Entry* findEntry(const Archive* archive, const char* name)
+{
+    const auto it = lowerBound(archive, name);
+
+    if (it == archive->entries.end() || it->name != name)
+        return nullptr;
+
+    return &*it;
+}
+
+static bool isDirectory(const Archive* archive, const char* name)
+{
+    if (*name == '\0')
+        return true;
+
+    const std::string prefix = std::string(name) + "/";
+    const auto it            = lowerBound(archive, prefix);
+
+    return it != archive->entries.end() && it->name.starts_with(prefix);
+}
+
+/* io */
+
+static bool loadBlock(Handle* handle, int64_t index)
+{
+    if (handle->cachedBlock == index)
+        return true;
+
+    const Entry* entry        = handle->entry;
+    const uint64_t blockSize  = handle->archive->blockSize;
+    const uint32_t start      = handle->seekTable[index];
+    const uint32_t packedSize = handle->seekTable[index + 1] - start;
+    const uint64_t unpacked   = std::min(blockSize, entry->size - index * blockSize);
+
+    /* a block that didn't shrink would have been stored as it was */
+    if (packedSize > unpacked)
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+        return false;
+    }
+
+    if (!handle->io->seek(handle->io, entry->offset + start))
+        return false;
+
+    if (packedSize == unpacked)
+    {
+        if (!readExactly(handle->io, handle->block.data(), unpacked))
+            return false;
+    }
+    else
+    {
+        if (!readExactly(handle->io, handle->packed.data(), packedSize))
+            return false;
+
+        const auto* source = (const char*)handle->packed.data();
+        auto* destination  = (char*)handle->block.data();
+
+        if (LZ4_decompress_safe(source, destination, packedSize, unpacked) != (int)unpacked)
+        {
+            PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+            return false;
+        }
+    }
+
+    handle->cachedBlock = index;
+    handle->blockLength = unpacked;
+
+    return true;
+}
+
+static PHYSFS_sint64 ioRead(PHYSFS_Io* io, void* buffer, PHYSFS_uint64 length)
+{
+    auto* handle       = (Handle*)io->opaque;
+    const Entry* entry = handle->entry;
+
+    length = std::min(length, entry->size - handle->position);
+
+    if (entry->storage == PackArchive::STORAGE_STORED)
+    {
+        if (!handle->io->seek(handle->io, entry->offset + handle->position))
+            return -1;
+
+        const auto read = handle->io->read(handle->io, buffer, length);
+
+        if (read > 0)
+            handle->position += read;
+
+        return read;
+    }
+
+    const uint64_t blockSize = handle->archive->blockSize;
+    uint64_t copied          = 0;
+
+    while (copied < length)
+    {
+        if (!loadBlock(handle, handle->position / blockSize))
+            return copied > 0 ? (PHYSFS_sint64)copied : -1;
+
+        const size_t within = handle->position % blockSize;
+        const size_t count  = std::min<uint64_t>(length - copied, handle->blockLength - within);
+
+        std::memcpy((uint8_t*)buffer + copied, handle->block.data() + within, count);
+
+        handle->position += count;
+        copied += count;
+    }
+
+    return copied;
+}
+
+static PHYSFS_sint64 ioWrite(PHYSFS_Io*, const void*, PHYSFS_uint64)
+{
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return -1;
+}
+
+static int ioSeek(PHYSFS_Io* io, PHYSFS_uint64 offset)
+{
+    auto* handle = (Handle*)io->opaque;
+
+    if (offset > handle->entry->size)
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_PAST_EOF);
+        return 0;
+    }
+
+    handle->position = offset;
+    return 1;
+}
+
+static PHYSFS_sint64 ioTell(PHYSFS_Io* io)
+{
+    return ((Handle*)io->opaque)->position;
+}
+
+static PHYSFS_sint64 ioLength(PHYSFS_Io* io)
+{
+    return ((Handle*)io->opaque)->entry->size;
+}
+
+static PHYSFS_Io* openEntry(const Archive* archive, const Entry* entry);
+
+static PHYSFS_Io* ioDuplicate(PHYSFS_Io* io)
+{
+    const auto* handle = (const Handle*)io->opaque;
+    return openEntry(handle->archive, handle->entry);
+}
+
+static int ioFlush(PHYSFS_Io*)
+{
+    return 1;
+}
+
+static void ioDestroy(PHYSFS_Io* io)
+{
+    delete (Handle*)io->opaque;
+    delete io;
+}
+
+static PHYSFS_Io* openEntry(const Archive* archive, const Entry* entry)
+{
+    std::unique_ptr<Handle> handle;
+    PHYSFS_Io* io = nullptr;
+
+    try
+    {
+        handle.reset(new Handle { archive, entry, nullptr, 0, {}, {}, {}, -1, 0 });
+        io = new PHYSFS_Io;
+    }
+    catch (std::bad_alloc&)
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_OUT_OF_MEMORY);
+        return nullptr;
+    }
+
+    std::unique_ptr<PHYSFS_Io> owner(io);
+
+    if ((handle->io = archive->io->duplicate(archive->io)) == nullptr)
+        return nullptr;
+
+    if (entry->storage == PackArchive::STORAGE_LZ4)
+    {
+        const uint64_t blocks = (entry->size + archive->blockSize - 1) / archive->blockSize;
+        std::vector<uint8_t> table;
+
+        try
+        {
+            table.resize((blocks + 1) * sizeof(uint32_t));
+            handle->seekTable.resize(blocks + 1);
+            handle->block.resize(std::min<uint64_t>(archive->blockSize, entry->size));
+            handle->packed.resize(handle->block.size());
+        }
+        catch (std::bad_alloc&)
+        {
+            PHYSFS_setErrorCode(PHYSFS_ERR_OUT_OF_MEMORY);
+            return nullptr;
+        }
+
+        if (!handle->io->seek(handle->io, entry->offset))
+            return nullptr;
+
+        if (!readExactly(handle->io, table.data(), table.size()))
+            return nullptr;
+
+        for (uint64_t index = 0; index <= blocks; index++)
+            handle->seekTable[index] = read32(&table[index * sizeof(uint32_t)]);
+
+        const auto& seekTable = handle->seekTable;
+
+        if (!std::is_sorted(seekTable.begin(), seekTable.end()) ||
+            seekTable.back() > entry->storedSize)
+        {
+            PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+            return nullptr;
+        }
+    }
+
+    *io = { 0, handle.release(), ioRead, ioWrite, ioSeek, ioTell, ioLength, ioDuplicate,
+            ioFlush, ioDestroy };
+
+    return owner.release();
+}
+
+/* archiver */
+
+static void* openArchive(PHYSFS_Io* io, const char*, int forWrite, int* claimed)
+{
+    uint8_t header[HEADER_SIZE];
+
+    if (!io->seek(io, 0) || !readExactly(io, header, HEADER_SIZE) ||
+        std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_UNSUPPORTED);
+        return nullptr;
+    }
+
+    *claimed = 1;
+
+    if (forWrite)
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+        return nullptr;
+    }
+
+    const uint32_t version   = read32(header + 0x04);
+    const uint64_t count     = read32(header + 0x08);
+    const uint32_t blockSize = read32(header + 0x0C);
+    const uint64_t toc       = read64(header + 0x10);
+    const uint64_t namesSize = read32(header + 0x18);
+    const PHYSFS_sint64 size = io->length(io);
+    const uint64_t length    = size > 0 ? size : 0;
+
+    const uint64_t tocSize = count * RECORD_SIZE + namesSize;
+
+    const bool badBlockSize =
+        blockSize < PackArchive::MIN_BLOCK_SIZE || blockSize > PackArchive::MAX_BLOCK_SIZE;
+
+    if (version != PackArchive::VERSION || badBlockSize || toc > length ||
+        tocSize > length - toc)
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+        return nullptr;
+    }
+
+    try
+    {
+        std::vector<uint8_t> records(tocSize);
+
+        if (!io->seek(io, toc) || !readExactly(io, records.data(), tocSize))
+            return nullptr;
+
+        auto archive = std::make_unique<Archive>();
+
+        archive->blockSize = blockSize;
+        archive->entries.reserve(count);
+
+        const char* names = (const char*)records.data() + count * RECORD_SIZE;
+
+        for (uint64_t index = 0; index < count; index++)
+        {
+            const uint8_t* record = &records[index * RECORD_SIZE];
+
+            Entry entry {};
+            entry.offset     = read64(record + 0x00);
+            entry.size       = read64(record + 0x08);
+            entry.storedSize = read64(record + 0x10);
+            entry.modtime    = (int64_t)read64(record + 0x18);
+            entry.storage    = read32(record + 0x28);
+
+            const uint64_t nameOffset = read32(record + 0x20);
+            const uint64_t nameLength = read32(record + 0x24);
+
+            const bool outside = entry.offset > length || entry.storedSize > length - entry.offset;
+
+            /* bounds the size too: an LZ4 entry's seek table has to fit in what it stores */
+            const uint64_t blocks = entry.size / blockSize + (entry.size % blockSize != 0);
+
+            const bool badSize = (entry.storage == PackArchive::STORAGE_STORED)
+                                     ? entry.size != entry.storedSize
+                                     : (blocks + 1) * sizeof(uint32_t) > entry.storedSize;
+
+            if (outside || badSize || nameOffset + nameLength > namesSize ||
+                entry.storage > PackArchive::STORAGE_LZ4)
+            {
+                PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+                return nullptr;
+            }
+
+            entry.name.assign(names + nameOffset, nameLength);
+            archive->entries.push_back(std::move(entry));
+        }
+
+        /* lookups rely on the order; fix up anything not packed by Create */
+        const auto byName = [](const Entry& a, const Entry& b) { return a.name < b.name; };
+
+        if (!std::is_sorted(archive->entries.begin(), archive->entries.end(), byName))
+            std::sort(archive->entries.begin(), archive->entries.end(), byName);
+
+        archive->io = io;
+        return archive.release();
+    }
+    catch (std::bad_alloc&)
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_OUT_OF_MEMORY);
+        return nullptr;
+    }
+}
+
+static PHYSFS_EnumerateCallbackResult enumerate(void* opaque, const char* directory,
+                                                PHYSFS_EnumerateCallback callback,
+                                                const char* origin, void* data)
+{
+    const auto* archive = (const Archive*)opaque;
+
+    std::string prefix = directory;
+
+    if (!prefix.empty())
+        prefix += '/';
+
+    std::string_view last;
+
+    /* everything below one child directory sorts together, so each is only reported once */
+    for (auto it = lowerBound(archive, prefix); it != archive->entries.end(); ++it)
+    {
+        if (!it->name.starts_with(prefix))
+            break;
+
+        std::string_view child = std::string_view(it->name).substr(prefix.size());
+        child                  = child.substr(0, child.find('/'));
+
+        if (child == last)
+            continue;
+
+        last = child;
+
+        const std::string name(child);
+        const auto result = callback(data, origin, name.c_str());
+
+        if (result == PHYSFS_ENUM_ERROR)
+        {
+            PHYSFS_setErrorCode(PHYSFS_ERR_APP_CALLBACK);
+            return PHYSFS_ENUM_ERROR;
+        }
+
+        if (result == PHYSFS_ENUM_STOP)
+            return PHYSFS_ENUM_STOP;
+    }
+
+    return PHYSFS_ENUM_OK;
+}
+
+static PHYSFS_Io* openRead(void* opaque, const char* filename)
+{
+    const auto* archive = (const Archive*)opaque;
+    const Entry* entry  = findEntry(archive, filename);
+
+    if (entry == nullptr)
+    {
+        PHYSFS_setErrorCode(isDirectory(archive, filename) ? PHYSFS_ERR_NOT_A_FILE
+                                                           : PHYSFS_ERR_NOT_FOUND);
+        return nullptr;
+    }
+
+    return openEntry(archive, entry);
+}
+
+static PHYSFS_Io* openWrite(void*, const char*)
+{
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return nullptr;
+}
+
+static int modify(void*, const char*)
+{
+    PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+    return 0;
+}
+
+static int statEntry(void* opaque, const char* filename, PHYSFS_Stat* stat)
+{
+    const auto* archive = (const Archive*)opaque;
+
+    stat->readonly = 1;
+
+    if (const Entry* entry = findEntry(archive, filename))
+    {
+        stat->filesize   = entry->size;
+        stat->modtime    = entry->modtime;
+        stat->createtime = entry->modtime;
+        stat->accesstime = entry->modtime;
+        stat->filetype   = PHYSFS_FILETYPE_REGULAR;
+
+        return 1;
+    }
+
+    if (isDirectory(archive, filename))
+    {
+        stat->filesize   = 0;
+        stat->modtime    = -1;
+        stat->createtime = -1;
+        stat->accesstime = -1;
+        stat->filetype   = PHYSFS_FILETYPE_DIRECTORY;
+
+        return 1;
+    }
+
+    PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+    return 0;
+}
+
+static void closeArchive(void* opaque)
+{
+    auto* archive = (Archive*)opaque;
+
+    archive->io->destroy(archive->io);
+    delete archive;
+}
+
+// clang-format off
+static const PHYSFS_Archiver archiver =
+{
+    0,
+    { "LPAK", "LÖVE Potion asset pack", "LÖVE Potion", "", 0 },
+    openArchive,
+    enumerate,
+    openRead,
+    openWrite,
+    openWrite,
+    modify,
+    modify,
+    statEntry,
+    closeArchive
+};
+// clang-format on
+
+bool PackArchive::Register()
+{
+    return PHYSFS_registerArchiver(&archiver) != 0;
+}
+
+/* packing */
+
+static void collectFiles(const std::string& directory, std::vector<std::string>& files)
+{
+    std::vector<std::string> children;
+
+    if (char** items = PHYSFS_enumerateFiles(directory.c_str()))
+    {
+        for (char** item = items; *item != nullptr; item++)
+            children.push_back(directory.empty() ? *item : directory + "/" + *item);
+
+        PHYSFS_freeList(items);
+    }
+
+    for (const auto& path : children)
+    {
+        PHYSFS_Stat stat {};
+
+        if (!PHYSFS_stat(path.c_str(), &stat))
+            continue;
+
+        if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY)
+            collectFiles(path, files);
+        else if (stat.filetype == PHYSFS_FILETYPE_REGULAR)
+            files.push_back(path);
+    }
+}
+
+static std::string trimSlashes(std::string path)
+{
+    while (!path.empty() && path.front() == '/')
+        path.erase(0, 1);
+
+    while (!path.empty() && path.back() == '/')
+        path.pop_back();
+
+    return path;
+}
+
+static void readSource(const std::string& path, std::vector<uint8_t>& contents)
+{
+    PHYSFS_File* file = PHYSFS_openRead(path.c_str());
+
+    if (file == nullptr)
+        throw love::Exception("Could not open %s: %s", path.c_str(), lastError());
+
+    const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+
+    contents.resize(length > 0 ? length : 0);
+
+    const bool success = length >= 0 && PHYSFS_readBytes(file, contents.data(), length) == length;
+    PHYSFS_close(file);
+
+    if (!success)
+        throw love::Exception("Could not read %s: %s", path.c_str(), lastError());
+}
+
+/*
+** Splits @contents into blocks and LZ4-compresses each, writing the seek table and blocks to
+** @packed. Returns false when that doesn't come out smaller than @contents.
+*/
+static bool compressEntry(const std::vector<uint8_t>& contents, uint32_t blockSize, int level,
+                          std::vector<uint8_t>& packed)
+{
+    const size_t blocks    = (contents.size() + blockSize - 1) / blockSize;
+    const size_t tableSize = (blocks + 1) * sizeof(uint32_t);
+
+    std::vector<uint8_t> block(LZ4_compressBound(blockSize));
+    std::vector<uint8_t> data;
+
+    packed.clear();
+    put32(packed, (uint32_t)tableSize);
+
+    for (size_t index = 0; index < blocks; index++)
+    {
+        const size_t offset = index * blockSize;
+        const int size      = (int)std::min<size_t>(blockSize, contents.size() - offset);
+
+        const auto* source = (const char*)contents.data() + offset;
+        auto* destination  = (char*)block.data();
+        const int capacity = (int)block.size();
+
+        int compressed = 0;
+
+        if (level > 8)
+            compressed = LZ4_compress_HC(source, destination, size, capacity, level);
+        else if (level > 0)
+            compressed = LZ4_compress_fast(source, destination, size, capacity, 9 - level);
+        else
+            compressed = LZ4_compress_default(source, destination, size, capacity);
+
+        /* keep blocks that don't shrink as they are; readers tell them apart by length */
+        if (compressed <= 0 || compressed >= size)
+            data.insert(data.end(), source, source + size);
+        else
+            data.insert(data.end(), block.begin(), block.begin() + compressed);
+
+        if (tableSize + data.size() >= contents.size() || tableSize + data.size() > UINT32_MAX)
+            return false;
+
+        put32(packed, (uint32_t)(tableSize + data.size()));
+    }
+
+    packed.insert(packed.end(), data.begin(), data.end());
+
+    return true;
+}
+
+int PackArchive::Create(const char* directory, const char* filename, const Settings& settings)
+{
+    if (settings.blockSize < MIN_BLOCK_SIZE || settings.blockSize > MAX_BLOCK_SIZE)
+        throw love::Exception("Invalid pack block size: %u", settings.blockSize);
+
+    if (settings.alignment == 0 || (settings.alignment & (settings.alignment - 1)) != 0)
+        throw love::Exception("Pack alignment must be a power of two.");
+
+    if (settings.level != -1 && (settings.level < 1 || settings.level > LZ4HC_CLEVEL_MAX))
+        throw love::Exception("Invalid pack compression level: %d", settings.level);
+
+    const std::string root   = trimSlashes(directory);
+    const std::string output = trimSlashes(filename);
+
+    std::vector<std::string> paths;
+    collectFiles(root, paths);
+
+    /* the pack can't contain itself */
+    std::erase(paths, output);
+
+    struct Record
+    {
+        std::string path;
+        std::string name;
+        Entry entry;
+    };
+
+    std::vector<Record> records;
+
+    for (auto& path : paths)
+    {
+        std::string name = root.empty() ? path : path.substr(root.size() + 1);
+        records.push_back({ std::move(path), std::move(name), {} });
+    }
+
+    std::sort(records.begin(), records.end(),
+              [](const Record& a, const Record& b) { return a.name < b.name; });
+
+    /* closes and deletes a pack that wasn't finished, however packing was cut short */
+    struct PackFile
+    {
+        PHYSFS_File* file;
+        const std::string& path;
+
+        ~PackFile()
+        {
+            if (this->file == nullptr)
+                return;
+
+            PHYSFS_close(this->file);
+            PHYSFS_delete(this->path.c_str());
+        }
+    } pack { PHYSFS_openWrite(output.c_str()), output };
+
+    PHYSFS_File* file = pack.file;
+
+    if (file == nullptr)
+        throw love::Exception("Could not open %s for writing: %s", output.c_str(), lastError());
+
+    uint64_t offset = 0;
+
+    const auto write = [&](const void* data, size_t size) {
+        if (PHYSFS_writeBytes(file, data, size) != (PHYSFS_sint64)size)
+            throw love::Exception("Could not write %s: %s", output.c_str(), lastError());
+
+        offset += size;
+    };
+
+    const auto pad = [&](uint64_t alignment) {
+        static constexpr uint8_t zeros[0x40] {};
+
+        while (offset % alignment != 0)
+            write(zeros, std::min<uint64_t>(alignment - offset % alignment, sizeof(zeros)));
+    };
+
+    std::vector<uint8_t> contents;
+    std::vector<uint8_t> packed;
+
+    const uint8_t empty[HEADER_SIZE] {};
+    write(empty, HEADER_SIZE);
+
+    for (auto& record : records)
+    {
+        readSource(record.path, contents);
+
+        PHYSFS_Stat stat {};
+        PHYSFS_stat(record.path.c_str(), &stat);
+
+        pad(settings.alignment);
+
+        Entry& entry  = record.entry;
+        entry.offset  = offset;
+        entry.size    = contents.size();
+        entry.modtime = stat.modtime;
+        entry.storage = STORAGE_STORED;
+
+        if (settings.compress && !contents.empty() &&
+            compressEntry(contents, settings.blockSize, settings.level, packed))
+        {
+            entry.storage = STORAGE_LZ4;
+            write(packed.data(), packed.size());
+        }
+        else
+            write(contents.data(), contents.size());
+
+        entry.storedSize = offset - entry.offset;
+    }
+
+    pad(sizeof(uint64_t));
+
+    const uint64_t toc = offset;
+
+    std::vector<uint8_t> table;
+    std::string names;
+
+    for (const auto& record : records)
+    {
+        const Entry& entry = record.entry;
+
+        put64(table, entry.offset);
+        put64(table, entry.size);
+        put64(table, entry.storedSize);
+        put64(table, (uint64_t)entry.modtime);
+        put32(table, (uint32_t)names.size());
+        put32(table, (uint32_t)record.name.size());
+        put32(table, entry.storage);
+        put32(table, 0);
+
+        names += record.name;
+    }
+
+    table.insert(table.end(), names.begin(), names.end());
+    write(table.data(), table.size());
+
+    std::vector<uint8_t> header(MAGIC, MAGIC + sizeof(MAGIC));
+    put32(header, VERSION);
+    put32(header, (uint32_t)records.size());
+    put32(header, settings.blockSize);
+    put64(header, toc);
+    put32(header, (uint32_t)names.size());
+    put32(header, settings.alignment);
+
+    if (!PHYSFS_seek(file, 0))
+        throw love::Exception("Could not write %s: %s", output.c_str(), lastError());
+
+    write(header.data(), header.size());
+
+    pack.file = nullptr;
+
+    if (!PHYSFS_close(file))
+        throw love::Exception("Could not write %s: %s", output.c_str(), lastError());
+
+    return (int)records.size();
+}
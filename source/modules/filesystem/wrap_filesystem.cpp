@@ -2,32 +2,25 @@
 #include <modules/data/wrap_data.hpp>
 
 #include <modules/filesystem/physfs/filesystem.hpp>
+#include <modules/filesystem/physfs/packarchive.hpp>
 #include <modules/filesystem/wrap_filesystem.hpp>
 
 #include <objects/data/filedata/wrap_filedata.hpp>
 #include <objects/file/wrap_file.hpp>
+#include <objects/filerequest/wrap_filerequest.hpp>
+#include <objects/savewriter/wrap_savewriter.hpp>
 
+#include <cstring>
 #include <filesystem>
 #include <format>
 
 #include <utilities/functions.hpp>
+#include <utilities/hashfunction/fnv1a.hpp>
 
 using namespace love;
 
 #define instance() (Module::GetInstance<Filesystem>(Module::M_FILESYSTEM))
 
-std::size_t replaceAll(std::string& inout, std::string_view what, std::string_view with)
-{
-    std::size_t count {};
-    for (std::string::size_type pos {};
-         inout.npos != (pos = inout.find(what.data(), pos, what.length()));
-         pos += with.length(), ++count)
-    {
-        inout.replace(pos, what.length(), with.data(), with.length());
-    }
-    return count;
-}
-
 Filesystem::MountPermissions Wrap_Filesystem::CheckPermissionType(lua_State* L, int index)
 {
     const char* string = luaL_checkstring(L, index);
@@ -52,6 +45,138 @@ Filesystem::CommonPath Wrap_Filesystem::CheckCommonPathType(lua_State* L, int in
     return Filesystem::CommonPath::APP_SAVEDIR;
 }
 
+/*
+** Cached chunks start with a header naming the source they were compiled from, which is
+** checked before the chunk is handed to Lua. The cache never leaves the device, so the
+** header is in native byte order.
+*/
+struct BytecodeHeader
+{
+    char magic[8];
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+};
+
+static constexpr char BYTECODE_MAGIC[8] = "LOVEBC1";
+
+static BytecodeHeader makeBytecodeHeader(const Data* source)
+{
+    BytecodeHeader header {};
+
+    std::memcpy(header.magic, BYTECODE_MAGIC, sizeof(header.magic));
+    header.sourceHash = love::FNV1a(source->GetData(), source->GetSize());
+    header.sourceSize = source->GetSize();
+
+    return header;
+}
+
+static int writeBytecode(lua_State*, const void* data, size_t size, void* userdata)
+{
+    ((std::string*)userdata)->append((const char*)data, size);
+    return 0;
+}
+
+/*
+** Removes the entries an edit or upgrade left behind for the chunk cached at @path, which
+** share its name key, and any named the old way, with a single key.
+*/
+static void removeStaleBytecode(const std::string& path)
+{
+    const std::string directory = Filesystem::BYTECODE_DIRECTORY;
+
+    const auto entry  = path.substr(directory.size() + 1);
+    const auto prefix = entry.substr(0, entry.find('-') + 1);
+
+    std::vector<std::string> items {};
+    instance()->GetDirectoryItems(directory.c_str(), items);
+
+    for (const auto& item : items)
+    {
+        if (item != entry && (item.starts_with(prefix) || item.find('-') == std::string::npos))
+            instance()->RemoveCache((directory + "/" + item).c_str());
+    }
+}
+
+/* dumps the function on top of the stack to @path; the cache is best-effort */
+static bool saveBytecode(lua_State* L, const std::string& path, const BytecodeHeader& header)
+{
+    std::string bytecode((const char*)&header, sizeof(header));
+
+    if (lua_dump(L, writeBytecode, &bytecode) != 0)
+        return false;
+
+    try
+    {
+        instance()->WriteCache(path.c_str(), bytecode.data(), bytecode.size());
+    }
+    catch (love::Exception&)
+    {
+        return false;
+    }
+
+    removeStaleBytecode(path);
+
+    return true;
+}
+
+/*
+** Loads @source as @filename, preferring a compiled chunk from the bytecode cache when it's
+** enabled. A chunk whose header doesn't match @source, or that fails to load (damaged, or
+** from another Lua build), is ignored.
+*/
+static int loadChunk(lua_State* L, const std::string& filename, Data* source)
+{
+    auto* filesystem    = instance();
+    const auto chunk    = "@" + filename;
+    const bool useCache = filesystem->IsBytecodeCacheEnabled();
+
+    BytecodeHeader header {};
+    std::string path {};
+
+    if (useCache)
+    {
+        header = makeBytecodeHeader(source);
+        path   = Filesystem::GetBytecodePath(filename, header.sourceHash, header.sourceSize);
+
+        if (filesystem->Exists(path.c_str()))
+        {
+            StrongReference<FileData> bytecode;
+
+            try
+            {
+                bytecode.Set(filesystem->Read(path.c_str()), Acquire::NORETAIN);
+            }
+            catch (love::Exception&)
+            {}
+
+            if (bytecode.Get() != nullptr && bytecode->GetSize() > sizeof(header) &&
+                std::memcmp(bytecode->GetData(), &header, sizeof(header)) == 0)
+            {
+                const auto* data  = (const char*)bytecode->GetData() + sizeof(header);
+                const size_t size = bytecode->GetSize() - sizeof(header);
+
+                if (luaL_loadbuffer(L, data, size, chunk.c_str()) == 0)
+                {
+                    filesystem->CountBytecodeHit();
+                    return 0;
+                }
+
+                lua_pop(L, 1);
+            }
+        }
+    }
+
+    filesystem->CountBytesParsed(source->GetSize());
+
+    const auto* text = (const char*)source->GetData();
+    int status       = luaL_loadbuffer(L, text, source->GetSize(), chunk.c_str());
+
+    if (status == 0 && useCache)
+        saveBytecode(L, path, header);
+
+    return status;
+}
+
 int Wrap_Filesystem::Load(lua_State* L)
 {
     std::string filename = luaL_checkstring(L, 1);
@@ -66,8 +191,7 @@ int Wrap_Filesystem::Load(lua_State* L)
         return luax::IOError(L, "%s", e.what());
     }
 
-    int status =
-        luaL_loadbuffer(L, (const char*)data->GetData(), data->GetSize(), ("@" + filename).c_str());
+    int status = loadChunk(L, filename, data);
     data->Release();
 
     switch (status)
@@ -211,23 +335,14 @@ int Wrap_Filesystem::Loader(lua_State* L)
             c = '/';
     }
 
-    auto* inst = instance();
-    for (std::string element : inst->GetRequirePath())
-    {
-        replaceAll(element, "?", moduleName);
-
-        Filesystem::Info info {};
+    std::string path {};
 
-        if (inst->GetInfo(element.c_str(), info))
-        {
-            if (info.type != Filesystem::FILETYPE_DIRECTORY)
-            {
-                lua_pop(L, 1);
-                lua_pushstring(L, element.c_str());
+    if (instance()->FindModule(moduleName, path))
+    {
+        lua_pop(L, 1);
+        lua_pushstring(L, path.c_str());
 
-                return Wrap_Filesystem::Load(L);
-            }
-        }
+        return Wrap_Filesystem::Load(L);
     }
 
     std::string errstr = "\n    no '%s' in LOVE game directories.";
@@ -237,6 +352,155 @@ int Wrap_Filesystem::Loader(lua_State* L)
     return 1;
 }
 
+int Wrap_Filesystem::SetBytecodeCacheEnabled(lua_State* L)
+{
+    instance()->SetBytecodeCacheEnabled(luax::CheckBoolean(L, 1));
+
+    return 0;
+}
+
+int Wrap_Filesystem::IsBytecodeCacheEnabled(lua_State* L)
+{
+    luax::PushBoolean(L, instance()->IsBytecodeCacheEnabled());
+
+    return 1;
+}
+
+static void compileDirectory(lua_State* L, const std::string& path, int& compiled, int& failed)
+{
+    Filesystem::Info info {};
+
+    if (!instance()->GetInfo(path.c_str(), info))
+        return;
+
+    if (info.type == Filesystem::FILETYPE_DIRECTORY)
+    {
+        /* don't compile the cache into itself */
+        if (path == Filesystem::BYTECODE_DIRECTORY)
+            return;
+
+        std::vector<std::string> items {};
+        instance()->GetDirectoryItems(path.c_str(), items);
+
+        for (const auto& item : items)
+            compileDirectory(L, path.empty() ? item : path + "/" + item, compiled, failed);
+
+        return;
+    }
+
+    if (path.size() < 4 || path.compare(path.size() - 4, 4, ".lua") != 0)
+        return;
+
+    StrongReference<FileData> source;
+
+    try
+    {
+        source.Set(instance()->Read(path.c_str()), Acquire::NORETAIN);
+    }
+    catch (love::Exception&)
+    {
+        failed++;
+        return;
+    }
+
+    const auto* text   = (const char*)source->GetData();
+    const auto chunk   = "@" + path;
+    const auto header  = makeBytecodeHeader(source.Get());
+    const auto cached  = Filesystem::GetBytecodePath(path, header.sourceHash, header.sourceSize);
+    const bool success = luaL_loadbuffer(L, text, source->GetSize(), chunk.c_str()) == 0 &&
+                         saveBytecode(L, cached, header);
+
+    lua_pop(L, 1);
+
+    if (success)
+        compiled++;
+    else
+        failed++;
+}
+
+int Wrap_Filesystem::CompileBytecode(lua_State* L)
+{
+    std::string path = luaL_optstring(L, 1, "");
+
+    while (!path.empty() && path.back() == '/')
+        path.pop_back();
+
+    int compiled = 0;
+    int failed   = 0;
+
+    compileDirectory(L, path, compiled, failed);
+
+    lua_pushinteger(L, compiled);
+    lua_pushinteger(L, failed);
+
+    return 2;
+}
+
+int Wrap_Filesystem::CreatePack(lua_State* L)
+{
+    const char* directory = luaL_checkstring(L, 1);
+    const char* filename  = luaL_checkstring(L, 2);
+
+    physfs::PackArchive::Settings settings {};
+
+    if (lua_istable(L, 3))
+    {
+        settings.compress  = luax::BoolFlag(L, 3, "compress", settings.compress);
+        settings.level     = luax::IntFlag(L, 3, "level", settings.level);
+        settings.blockSize = luax::IntFlag(L, 3, "blocksize", settings.blockSize);
+        settings.alignment = luax::IntFlag(L, 3, "alignment", settings.alignment);
+    }
+    else if (!lua_isnoneornil(L, 3))
+        return luaL_argerror(L, 3, "expected table");
+
+    if (!Wrap_Filesystem::SetupWriteDirectory())
+        return luax::IOError(L, "Could not set write directory.");
+
+    int count = 0;
+
+    try
+    {
+        count = physfs::PackArchive::Create(directory, filename, settings);
+    }
+    catch (love::Exception& e)
+    {
+        return luax::IOError(L, "%s", e.what());
+    }
+
+    Filesystem::Invalidate();
+
+    lua_pushinteger(L, count);
+
+    return 1;
+}
+
+int Wrap_Filesystem::GetRequireStats(lua_State* L)
+{
+    const auto stats = instance()->GetRequireStats();
+
+    if (lua_istable(L, 1))
+        lua_pushvalue(L, 1);
+    else
+        lua_createtable(L, 0, 5);
+
+    lua_pushinteger(L, stats.lookups);
+    lua_setfield(L, -2, "lookups");
+
+    lua_pushinteger(L, stats.cacheHits);
+    lua_setfield(L, -2, "cachehits");
+
+    lua_pushinteger(L, stats.stats);
+    lua_setfield(L, -2, "stats");
+
+    lua_pushinteger(L, stats.bytesParsed);
+    lua_setfield(L, -2, "bytesparsed");
+
+    lua_pushinteger(L, stats.bytecodeHits);
+    lua_setfield(L, -2, "bytecodehits");
+
+    return 1;
+}
+
 bool Wrap_Filesystem::SetupWriteDirectory()
 {
     if (instance() != 0)
@@ -249,7 +513,11 @@ int Wrap_Filesystem::GetRequirePath(lua_State* L)
 {
     std::string path;
     bool seperator = false;
-    auto paths     = instance()->GetRequirePath();
+
+    auto lock  = instance()->LockRequirePath();
+    auto paths = instance()->GetRequirePath();
+
+    lock.unlock();
 
     for (auto& element : paths)
     {
@@ -271,6 +539,11 @@ int Wrap_Filesystem::Append(lua_State* L)
     return Wrap_Filesystem::WriteOrAppend(L, File::MODE_APPEND);
 }
 
+int Wrap_Filesystem::AppendAsync(lua_State* L)
+{
+    return Wrap_Filesystem::WriteOrAppendAsync(L, true);
+}
+
 int Wrap_Filesystem::CreateDirectory(lua_State* L)
 {
     const char* name = luaL_checkstring(L, 1);
@@ -515,6 +788,47 @@ int Wrap_Filesystem::NewFileData(lua_State* L)
     return 1;
 }
 
+int Wrap_Filesystem::NewSaveWriter(lua_State* L)
+{
+    const char* filename = luaL_checkstring(L, 1);
+
+    SaveWriter::Settings settings {};
+
+    if (lua_istable(L, 2))
+    {
+        lua_getfield(L, 2, "mode");
+
+        if (!lua_isnoneornil(L, -1))
+        {
+            const char* mode = luaL_checkstring(L, -1);
+
+            if (auto found = SaveWriter::modes.Find(mode))
+                settings.mode = *found;
+            else
+                return luax::EnumError(L, "save writer mode", SaveWriter::modes, mode);
+        }
+
+        lua_pop(L, 1);
+
+        settings.bufferSize = luax::IntFlag(L, 2, "buffersize", settings.bufferSize);
+        settings.blockSize  = luax::IntFlag(L, 2, "blocksize", settings.blockSize);
+        settings.interval   = luax::NumberFlag(L, 2, "interval", settings.interval);
+    }
+    else if (!lua_isnoneornil(L, 2))
+        return luaL_argerror(L, 2, "expected table");
+
+    if (!Wrap_Filesystem::SetupWriteDirectory())
+        return luax::IOError(L, "Could not set write directory.");
+
+    SaveWriter* writer = nullptr;
+    luax::CatchException(L, [&]() { writer = instance()->NewSaveWriter(filename, settings); });
+
+    luax::PushType(L, writer);
+    writer->Release();
+
+    return 1;
+}
+
 int Wrap_Filesystem::Read(lua_State* L)
 {
     auto type = DataModule::CONTAINER_STRING;
@@ -558,6 +872,21 @@ int Wrap_Filesystem::Read(lua_State* L)
     return 2;
 }
 
+int Wrap_Filesystem::ReadAsync(lua_State* L)
+{
+    const char* filename = luaL_checkstring(L, 1);
+    int priority         = luaL_optinteger(L, 2, 0);
+
+    FileRequest* request = nullptr;
+
+    luax::CatchException(L, [&]() { request = instance()->ReadAsync(filename, priority); });
+
+    luax::PushType(L, request);
+    request->Release();
+
+    return 1;
+}
+
 int Wrap_Filesystem::Remove(lua_State* L)
 {
     const char* filename = luaL_checkstring(L, 1);
@@ -586,9 +915,13 @@ int Wrap_Filesystem::GetWorkingDirectory(lua_State* L)
 int Wrap_Filesystem::SetRequirePath(lua_State* L)
 {
     std::string element = luaL_checkstring(L, 1);
-    auto& requirePath   = instance()->GetRequirePath();
+
+    auto lock         = instance()->LockRequirePath();
+    auto& requirePath = instance()->GetRequirePath();
 
     requirePath.clear();
+    Filesystem::Invalidate();
+
     std::string path;
 
     for (char item : element)
@@ -659,6 +992,44 @@ int Wrap_Filesystem::Write(lua_State* L)
     return Wrap_Filesystem::WriteOrAppend(L, File::MODE_WRITE);
 }
 
+int Wrap_Filesystem::WriteOrAppendAsync(lua_State* L, bool append)
+{
+    const char* filename = luaL_checkstring(L, 1);
+
+    const char* input = nullptr;
+    size_t length     = 0;
+
+    if (luax::IsType(L, 2, Data::type))
+    {
+        Data* data = luax::ToType<Data>(L, 2);
+
+        input  = (const char*)data->GetData();
+        length = data->GetSize();
+    }
+    else if (lua_isstring(L, 2))
+        input = lua_tolstring(L, 2, &length);
+    else
+        return luaL_argerror(L, 2, "string or Data expected");
+
+    int priority = luaL_optinteger(L, 3, 0);
+
+    FileRequest* request = nullptr;
+
+    luax::CatchException(L, [&]() {
+        request = instance()->WriteAsync(filename, input, length, priority, append);
+    });
+
+    luax::PushType(L, request);
+    request->Release();
+
+    return 1;
+}
+
+int Wrap_Filesystem::WriteAsync(lua_State* L)
+{
+    return Wrap_Filesystem::WriteOrAppendAsync(L, false);
+}
+
 File* Wrap_Filesystem::GetFile(lua_State* L, int index)
 {
     File* file = nullptr;
@@ -695,9 +1066,12 @@ int Wrap_Filesystem::Lines(lua_State* L)
     else
         return luaL_argerror(L, 1, "expected filename.");
 
-    lua_pushstring(L, ""); // buffer
-    lua_pushstring(L, 0);  // buffer offset
-    lua_pushcclosure(L, Wrap_File::Lines_I, 3);
+    bool slices = false;
+
+    if (!lua_isnoneornil(L, 2))
+        slices = Wrap_DataModule::CheckContainerType(L, 2) == DataModule::CONTAINER_DATA;
+
+    Wrap_File::PushLinesIterator(L, lua_gettop(L), false, slices);
 
     return 1;
 }
@@ -804,45 +1178,56 @@ bool Wrap_Filesystem::CanGetData(lua_State* L, int index)
 // clang-format off
 static constexpr luaL_Reg functions[] =
 {
-    { "append",                 Wrap_Filesystem::Append                 },
-    { "createDirectory",        Wrap_Filesystem::CreateDirectory        },
-    { "exists",                 Wrap_Filesystem::Exists                 },
-    { "getDirectoryItems",      Wrap_Filesystem::GetDirectoryItems      },
-    { "getExecutablePath",      Wrap_Filesystem::GetExecutablePath      },
-    { "getIdentity",            Wrap_Filesystem::GetIdentity            },
-    { "getInfo",                Wrap_Filesystem::GetInfo                },
-    { "getRealDirectory",       Wrap_Filesystem::GetRealDirectory       },
-    { "getRequirePath",         Wrap_Filesystem::GetRequirePath         },
-    { "getSaveDirectory",       Wrap_Filesystem::GetSaveDirectory       },
-    { "getSource",              Wrap_Filesystem::GetSource              },
-    { "getSourceBaseDirectory", Wrap_Filesystem::GetSourceBaseDirectory },
-    { "getUserDirectory",       Wrap_Filesystem::GetUserDirectory       },
-    { "getWorkingDirectory",    Wrap_Filesystem::GetWorkingDirectory    },
-    { "init",                   Wrap_Filesystem::Init                   },
-    { "isFused",                Wrap_Filesystem::IsFused                },
-    { "lines",                  Wrap_Filesystem::Lines                  },
-    { "load",                   Wrap_Filesystem::Load                   },
-    { "mount",                  Wrap_Filesystem::Mount                  },
-    { "mountFullPath",          Wrap_Filesystem::MountFullPath          },
-    { "mountCommonPath",        Wrap_Filesystem::MountCommonPath        },
-    { "openFile",               Wrap_Filesystem::OpenFile               },
-    { "newFileData",            Wrap_Filesystem::NewFileData            },
-    { "read",                   Wrap_Filesystem::Read                   },
-    { "remove",                 Wrap_Filesystem::Remove                 },
-    { "setFused",               Wrap_Filesystem::SetFused               },
-    { "setIdentity",            Wrap_Filesystem::SetIdentity            },
-    { "setRequirePath",         Wrap_Filesystem::SetRequirePath         },
-    { "setSource",              Wrap_Filesystem::SetSource              },
-    { "unmount",                Wrap_Filesystem::UnMount                },
-    { "unmountFullPath",        Wrap_Filesystem::UnMountFullPath        },
-    { "unmountCommonPath",      Wrap_Filesystem::UnMountCommonPath      },
-    { "write",                  Wrap_Filesystem::Write                  }
+    { "append",                  Wrap_Filesystem::Append                  },
+    { "appendAsync",             Wrap_Filesystem::AppendAsync             },
+    { "compileBytecode",         Wrap_Filesystem::CompileBytecode         },
+    { "createDirectory",         Wrap_Filesystem::CreateDirectory         },
+    { "createPack",              Wrap_Filesystem::CreatePack              },
+    { "exists",                  Wrap_Filesystem::Exists                  },
+    { "getDirectoryItems",       Wrap_Filesystem::GetDirectoryItems       },
+    { "getExecutablePath",       Wrap_Filesystem::GetExecutablePath       },
+    { "getIdentity",             Wrap_Filesystem::GetIdentity             },
+    { "getInfo",                 Wrap_Filesystem::GetInfo                 },
+    { "getRealDirectory",        Wrap_Filesystem::GetRealDirectory        },
+    { "getRequirePath",          Wrap_Filesystem::GetRequirePath          },
+    { "getRequireStats",         Wrap_Filesystem::GetRequireStats         },
+    { "getSaveDirectory",        Wrap_Filesystem::GetSaveDirectory        },
+    { "getSource",               Wrap_Filesystem::GetSource               },
+    { "getSourceBaseDirectory",  Wrap_Filesystem::GetSourceBaseDirectory  },
+    { "getUserDirectory",        Wrap_Filesystem::GetUserDirectory        },
+    { "getWorkingDirectory",     Wrap_Filesystem::GetWorkingDirectory     },
+    { "init",                    Wrap_Filesystem::Init                    },
+    { "isBytecodeCacheEnabled",  Wrap_Filesystem::IsBytecodeCacheEnabled  },
+    { "isFused",                 Wrap_Filesystem::IsFused                 },
+    { "lines",                   Wrap_Filesystem::Lines                   },
+    { "load",                    Wrap_Filesystem::Load                    },
+    { "mount",                   Wrap_Filesystem::Mount                   },
+    { "mountFullPath",           Wrap_Filesystem::MountFullPath           },
+    { "mountCommonPath",         Wrap_Filesystem::MountCommonPath         },
+    { "openFile",                Wrap_Filesystem::OpenFile                },
+    { "newFileData",             Wrap_Filesystem::NewFileData             },
+    { "newSaveWriter",           Wrap_Filesystem::NewSaveWriter           },
+    { "read",                    Wrap_Filesystem::Read                    },
+    { "readAsync",               Wrap_Filesystem::ReadAsync               },
+    { "remove",                  Wrap_Filesystem::Remove                  },
+    { "setBytecodeCacheEnabled", Wrap_Filesystem::SetBytecodeCacheEnabled },
+    { "setFused",                Wrap_Filesystem::SetFused                },
+    { "setIdentity",             Wrap_Filesystem::SetIdentity             },
+    { "setRequirePath",          Wrap_Filesystem::SetRequirePath          },
+    { "setSource",               Wrap_Filesystem::SetSource               },
+    { "unmount",                 Wrap_Filesystem::UnMount                 },
+    { "unmountFullPath",         Wrap_Filesystem::UnMountFullPath         },
+    { "unmountCommonPath",       Wrap_Filesystem::UnMountCommonPath       },
+    { "write",                   Wrap_Filesystem::Write                   },
+    { "writeAsync",              Wrap_Filesystem::WriteAsync              }
 };
 
 static constexpr lua_CFunction types[] =
 {
     Wrap_FileData::Register,
     Wrap_File::Register,
+    Wrap_FileRequest::Register,
+    Wrap_SaveWriter::Register,
     nullptr
 };
 // clang-format on
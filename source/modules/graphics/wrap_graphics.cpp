@@ -6,6 +6,7 @@
 
 #include <modules/filesystem/wrap_filesystem.hpp>
 
+#include <objects/atlas/wrap_atlas.hpp>
 #include <objects/compressedimagedata/wrap_compressedimagedata.hpp>
 #include <objects/font/wrap_font.hpp>
 #include <objects/imagedata/wrap_imagedata.hpp>
@@ -149,9 +150,7 @@ int Wrap_Graphics::SetBackgroundColor(lua_State* L)
     }
     else if (lua_isnumber(L, 1))
     {
-        color.r = luaL_checknumber(L, 1);
-        color.g = luaL_checknumber(L, 2);
-        color.b = luaL_checknumber(L, 3);
+        std::tie(color.r, color.g, color.b) = luax::CheckArguments<float, float, float>(L, 1);
         color.a = luaL_optnumber(L, 4, 1.0f);
     }
 
@@ -190,9 +189,7 @@ int Wrap_Graphics::SetColor(lua_State* L)
     }
     else if (lua_isnumber(L, 1))
     {
-        color.r = luaL_checknumber(L, 1);
-        color.g = luaL_checknumber(L, 2);
-        color.b = luaL_checknumber(L, 3);
+        std::tie(color.r, color.g, color.b) = luax::CheckArguments<float, float, float>(L, 1);
         color.a = luaL_optnumber(L, 4, 1.0f);
     }
 
@@ -658,46 +655,122 @@ static void parseDPIScale(Data* fileData, float* dpiScale)
     size_t position   = filename.rfind('@');
 }
 
-static std::pair<StrongReference<ImageData<Console::Which>>, StrongReference<CompressedImageData>>
-getImageData(lua_State* L, int index, bool allowCompressed, float* dpiScale)
+using ImageDataPair =
+    std::pair<StrongReference<ImageData<Console::Which>>, StrongReference<CompressedImageData>>;
+
+static ImageDataPair getImageData(lua_State* L, Data* data, bool allowCompressed)
 {
     StrongReference<ImageData<Console::Which>> image;
     StrongReference<CompressedImageData> compressed;
 
-    if (luax::IsType(L, index, ImageData<>::type))
-        image.Set(Wrap_ImageData::CheckImageData(L, index));
-    else if (luax::IsType(L, index, CompressedImageData::type))
+    auto* module = Module::GetInstance<ImageModule>(Module::M_IMAGE);
+
+    if (module == nullptr)
+        luaL_error(L, "Cannot load images without the image module.");
+
+    if (allowCompressed && module->IsCompressed(data))
     {
-        compressed.Set(Wrap_CompressedImageData::CheckCompressedImageData(L, index));
+        luax::CatchException(L, [&]() {
+            compressed.Set(module->NewCompressedImageData(data), Acquire::NORETAIN);
+        });
     }
-    else if (Wrap_Filesystem::CanGetData(L, index))
+    else
     {
-        auto* module = Module::GetInstance<ImageModule>(Module::M_IMAGE);
+        luax::CatchException(L,
+                             [&]() { image.Set(module->NewImageData(data), Acquire::NORETAIN); });
+    }
+
+    return std::make_pair(image, compressed);
+}
+
+/* filenames and FileData, but not ImageData or CompressedImageData */
+static bool isEncodedImage(lua_State* L, int index)
+{
+    if (luax::IsType(L, index, ImageData<>::type))
+        return false;
 
-        if (module == nullptr)
-            luaL_error(L, "Cannot load images without the image module.");
+    if (luax::IsType(L, index, CompressedImageData::type))
+        return false;
+
+    return Wrap_Filesystem::CanGetData(L, index);
+}
+
+static ImageDataPair getImageData(lua_State* L, int index, bool allowCompressed, float* dpiScale)
+{
+    if (luax::IsType(L, index, CompressedImageData::type))
+    {
+        StrongReference<CompressedImageData> compressed;
+        compressed.Set(Wrap_CompressedImageData::CheckCompressedImageData(L, index));
 
+        return std::make_pair(StrongReference<ImageData<Console::Which>>(), compressed);
+    }
+    else if (isEncodedImage(L, index))
+    {
         StrongReference<Data> data(Wrap_Filesystem::GetData(L, index), Acquire::NORETAIN);
 
         if (dpiScale != nullptr)
             parseDPIScale(data, dpiScale);
 
-        if (allowCompressed && module->IsCompressed(data))
-        {
-            luax::CatchException(L, [&]() {
-                compressed.Set(module->NewCompressedImageData(data), Acquire::NORETAIN);
-            });
-        }
-        else
-        {
-            luax::CatchException(
-                L, [&]() { image.Set(module->NewImageData(data), Acquire::NORETAIN); });
-        }
+        return getImageData(L, data, allowCompressed);
     }
-    else
-        image.Set(Wrap_ImageData::CheckImageData(L, index));
 
-    return std::make_pair(image, compressed);
+    StrongReference<ImageData<Console::Which>> image;
+    image.Set(Wrap_ImageData::CheckImageData(L, index));
+
+    return std::make_pair(image, StrongReference<CompressedImageData>());
+}
+
+/*
+** Decodes @data straight into the upload memory of a new Texture, so that no ImageData
+** (and no heap copy of the pixels) is made. Returns false if the decoder or settings
+** need the regular ImageData path.
+*/
+static bool newTextureFromEncoded(lua_State* L, Data* data, Texture<>::Settings settings,
+                                  StrongReference<Texture<Console::Which>>& texture)
+{
+    if (settings.type != Texture<>::TEXTURE_2D || settings.mipmaps != Texture<>::MIPMAPS_NONE)
+        return false;
+
+    if (settings.renderTarget || settings.msaa > 1 || settings.dpiScale != 1.0f)
+        return false;
+
+    if (settings.readable.has_value() && !settings.readable.value())
+        return false;
+
+    auto* module = Module::GetInstance<ImageModule>(Module::M_IMAGE);
+
+    if (module == nullptr || module->IsCompressed(data))
+        return false;
+
+    auto* decoder = FormatHandler::Find(module->GetFormatHandlers(), data, false);
+
+    if (decoder == nullptr)
+        return false;
+
+    const auto target = [&](const FormatHandler::DecodedImage& info, size_t& pitch) {
+        settings.width  = info.width;
+        settings.height = info.height;
+        settings.format = info.format;
+        settings.clear  = false;
+
+        texture.Set(instance()->NewTexture(settings, nullptr), Acquire::NORETAIN);
+
+        if (texture->GetPixelFormat() != info.format)
+            throw love::Exception("Pixel formats must match.");
+
+        return texture->LockPixels({ 0, 0, info.width, info.height }, pitch);
+    };
+
+    bool decoded = false;
+
+    // clang-format off
+    luax::CatchException(L,
+        [&]() { if ((decoded = decoder->DecodeInto(data, target))) texture->UnlockPixels(); },
+        [&](bool failed) { if (failed) texture.Set(nullptr); }
+    );
+    // clang-format on
+
+    return decoded;
 }
 
 static int pushNewTexture(lua_State* L, Texture<>::Slices* slices,
@@ -805,7 +878,27 @@ int Wrap_Graphics::NewTexture(lua_State* L)
         }
         else
         {
-            auto data = getImageData(L, 1, true, autoDpiScale);
+            ImageDataPair data;
+
+            if (isEncodedImage(L, 1))
+            {
+                StrongReference<Data> encoded(Wrap_Filesystem::GetData(L, 1), Acquire::NORETAIN);
+
+                if (autoDpiScale != nullptr)
+                    parseDPIScale(encoded, autoDpiScale);
+
+                StrongReference<Texture<Console::Which>> texture;
+
+                if (newTextureFromEncoded(L, encoded, settings, texture))
+                {
+                    luax::PushType(L, texture);
+                    return 1;
+                }
+
+                data = getImageData(L, encoded, true);
+            }
+            else
+                data = getImageData(L, 1, true, autoDpiScale);
 
             if (data.first.Get())
                 slices.Set(0, 0, data.first);
@@ -1066,10 +1159,7 @@ int Wrap_Graphics::Rectangle(lua_State* L)
     if (!(mode = Graphics<>::drawModes.Find(name)))
         return luax::EnumError(L, "draw mode", Graphics<>::drawModes, name);
 
-    float x      = luaL_checknumber(L, 2);
-    float y      = luaL_checknumber(L, 3);
-    float width  = luaL_checknumber(L, 4);
-    float height = luaL_checknumber(L, 5);
+    auto [x, y, width, height] = luax::CheckArguments<float, float, float, float>(L, 2);
 
     if (lua_isnoneornil(L, 6))
     {
@@ -1101,9 +1191,7 @@ int Wrap_Graphics::Circle(lua_State* L)
     if (!(mode = Graphics<>::drawModes.Find(name)))
         return luax::EnumError(L, "draw mode", Graphics<>::drawModes, name);
 
-    float x      = luaL_checknumber(L, 2);
-    float y      = luaL_checknumber(L, 3);
-    float radius = luaL_checknumber(L, 4);
+    auto [x, y, radius] = luax::CheckArguments<float, float, float>(L, 2);
 
     if (lua_isnoneornil(L, 5))
         luax::CatchException(L, [&]() { instance()->Circle(*mode, x, y, radius); });
@@ -1124,10 +1212,8 @@ int Wrap_Graphics::Ellipse(lua_State* L)
     if (!(mode = Graphics<>::drawModes.Find(name)))
         return luax::EnumError(L, "draw mode", Graphics<>::drawModes, name);
 
-    float x = luaL_checknumber(L, 2);
-    float y = luaL_checknumber(L, 3);
-    float a = luaL_checknumber(L, 4);
-    float b = luaL_optnumber(L, 5, a);
+    auto [x, y, a] = luax::CheckArguments<float, float, float>(L, 2);
+    float b        = luaL_optnumber(L, 5, a);
 
     if (lua_isnoneornil(L, 6))
         luax::CatchException(L, [&]() { instance()->Ellipse(*mode, x, y, a, b); });
@@ -1581,6 +1667,86 @@ int Wrap_Graphics::NewSpriteBatch(lua_State* L)
     return 1;
 }
 
+int Wrap_Graphics::NewAtlas(lua_State* L)
+{
+    checkGraphicsCreated(L);
+
+    if (!lua_isnoneornil(L, 1))
+        luaL_checktype(L, 1, LUA_TTABLE);
+
+    Atlas::Settings settings {};
+
+    if (lua_istable(L, 2))
+    {
+        settings.width   = luax::IntFlag(L, 2, "width", settings.width);
+        settings.height  = luax::IntFlag(L, 2, "height", settings.height);
+        settings.padding = luax::IntFlag(L, 2, "padding", settings.padding);
+        settings.extrude = luax::IntFlag(L, 2, "extrude", settings.extrude);
+
+        lua_getfield(L, 2, "format");
+        if (!lua_isnoneornil(L, -1))
+        {
+            const char* name = luaL_checkstring(L, -1);
+            std::optional<PixelFormat> format;
+
+            if (!(format = pixelFormats.Find(name)))
+                return luax::EnumError(L, "pixel format", pixelFormats, name);
+
+            settings.format = *format;
+        }
+        lua_pop(L, 1);
+    }
+    else if (!lua_isnoneornil(L, 2))
+        return luax::TypeError(L, 2, "table");
+
+    /* array entries keep their position and are named by filename; string keys name theirs */
+    std::vector<StrongReference<ImageData<Console::Which>>> images;
+    std::vector<Atlas::Source> sources;
+
+    const auto addSource = [&](int index, std::string name) {
+        images.push_back(Wrap_Atlas::CheckImage(L, index, name));
+        sources.push_back({ name, images.back().Get() });
+    };
+
+    if (lua_istable(L, 1))
+    {
+        const int count = (int)lua_objlen(L, 1);
+
+        for (int index = 1; index <= count; index++)
+        {
+            lua_rawgeti(L, 1, index);
+            addSource(-1, "");
+            lua_pop(L, 1);
+        }
+
+        lua_pushnil(L);
+        while (lua_next(L, 1) != 0)
+        {
+            if (lua_type(L, -2) == LUA_TSTRING)
+                addSource(-1, lua_tostring(L, -2));
+
+            lua_pop(L, 1);
+        }
+    }
+
+    Atlas* atlas = nullptr;
+    luax::CatchException(L, [&]() { atlas = instance()->NewAtlas(settings); });
+
+    std::vector<int> indices;
+
+    luax::CatchException(
+        L, [&]() { atlas->Add(sources, indices); },
+        [&](bool error) {
+            if (error)
+                atlas->Release();
+        });
+
+    luax::PushType(L, atlas);
+    atlas->Release();
+
+    return 1;
+}
+
 static PrimitiveType checkMeshDrawMode(lua_State* L, int index)
 {
     std::optional<PrimitiveType> mode;
@@ -2061,7 +2227,7 @@ int Wrap_Graphics::GetStats(lua_State* L)
     if (lua_istable(L, 1))
         lua_pushvalue(L, 1);
     else
-        lua_createtable(L, 0, 5);
+        lua_createtable(L, 0, 12);
 
     lua_pushinteger(L, stats.drawCalls);
     lua_setfield(L, -2, "drawcalls");
@@ -2078,6 +2244,18 @@ int Wrap_Graphics::GetStats(lua_State* L)
     lua_pushinteger(L, stats.textureMemory);
     lua_setfield(L, -2, "texturememory");
 
+    lua_pushinteger(L, stats.renderTargetMemory);
+    lua_setfield(L, -2, "rendertargetmemory");
+
+    lua_pushinteger(L, stats.fontMemory);
+    lua_setfield(L, -2, "fontmemory");
+
+    lua_pushinteger(L, stats.vertexMemory);
+    lua_setfield(L, -2, "vertexmemory");
+
+    lua_pushinteger(L, stats.stagingMemory);
+    lua_setfield(L, -2, "stagingmemory");
+
     lua_pushnumber(L, stats.cpuTime);
     lua_setfield(L, -2, "cputime");
 
@@ -2164,6 +2342,7 @@ static constexpr luaL_Reg functions[] =
     { "getWidth",              Wrap_Graphics::GetWidth              },
     { "getHeight",             Wrap_Graphics::GetHeight             },
     { "getDimensions",         Wrap_Graphics::GetDimensions         },
+    { "newAtlas",              Wrap_Graphics::NewAtlas              },
     { "newFont",               Wrap_Graphics::NewFont               },
     { "newMesh",               Wrap_Graphics::NewMesh               },
     { "newQuad",               Wrap_Graphics::NewQuad               },
@@ -2189,6 +2368,7 @@ static constexpr lua_CFunction types[] =
     Wrap_Quad::Register,
     Wrap_TextBatch::Register,
     Wrap_SpriteBatch::Register,
+    Wrap_Atlas::Register,
     Wrap_Mesh::Register,
     nullptr
 };
@@ -37,11 +37,5 @@ const std::list<love::FormatHandler*>& ImageModule::GetFormatHandlers() const
 
 bool ImageModule::IsCompressed(Data* data) const
 {
-    for (auto* handler : this->formatHandlers)
-    {
-        if (handler->CanParseCompressed(data))
-            return true;
-    }
-
-    return false;
+    return FormatHandler::Find(this->formatHandlers, data, true) != nullptr;
 }
@@ -36,6 +36,7 @@ static constexpr char nogame_lua[] = {
 #include <modules/keyboard/wrap_keyboard.hpp>
 #include <modules/math/wrap_math.hpp>
 #include <modules/physics/wrap_physics.hpp>
+#include <modules/profiler/wrap_profiler.hpp>
 #include <modules/sensor/wrap_sensor.hpp>
 #include <modules/sound/wrap_sound.hpp>
 #include <modules/system/wrap_system.hpp>
@@ -61,6 +62,7 @@ static constexpr luaL_Reg modules[] =
     { "love.math",       Wrap_Math::Register           },
     { "love.image",      Wrap_ImageModule::Register    },
     { "love.physics",    Wrap_Physics::Register        },
+    { "love.profiler",   Wrap_Profiler::Register       },
     { "love.sensor",     Wrap_Sensor::Register         },
     { "love.sound",      Wrap_Sound::Register          },
     { "love.system",     Wrap_System::Register         },
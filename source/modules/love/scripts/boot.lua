@@ -178,6 +178,7 @@ function love.init()
             audio = true,
             math = true,
             physics = true,
+            profiler = true,
             sensor = true,
             sound = true,
             system = true,
@@ -295,6 +296,7 @@ function love.init()
     -- Gets desired modules.
     for k, v in ipairs {
         "data",
+        "profiler",
         "thread",
         "timer",
         "event",
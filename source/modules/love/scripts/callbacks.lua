@@ -163,6 +163,16 @@ function love.createhandlers()
                 return love.threaderror(thread, error)
             end
         end,
+        filerequest = function(request)
+            if love.filerequest then
+                return love.filerequest(request)
+            end
+        end,
+        replayfinished = function()
+            if love.replayfinished then
+                return love.replayfinished()
+            end
+        end,
         resize = function(width, height)
             if love.resize then
                 return love.resize(width, height)
@@ -0,0 +1,234 @@
+#include <modules/profiler/profiler.hpp>
+#include <modules/timer_ext.hpp>
+
+#include <algorithm>
+#include <format>
+
+using namespace love;
+
+namespace
+{
+    struct OpenZone
+    {
+        const char* name;
+        double begin;
+    };
+
+    /* zones pushed from Lua on this thread; a null name was pushed while disabled */
+    thread_local std::vector<OpenZone> openZones;
+
+    /* a name given before the thread's first zone, so naming alone allocates nothing */
+    thread_local std::string pendingName;
+} // namespace
+
+static void appendEscaped(std::string& output, std::string_view string)
+{
+    for (char character : string)
+    {
+        switch (character)
+        {
+            case '"':
+                output += "\\\"";
+                break;
+            case '\\':
+                output += "\\\\";
+                break;
+            default:
+            {
+                if ((unsigned char)character < 0x20)
+                    output += std::format("\\u{:04x}", (unsigned)character);
+                else
+                    output += character;
+
+                break;
+            }
+        }
+    }
+}
+
+thread_local Profiler::RingOwner Profiler::threadRing;
+
+Profiler::RingOwner::~RingOwner()
+{
+    if (this->ring == nullptr)
+        return;
+
+    std::unique_lock lock(ringsMutex);
+    freeRings.push_back(this->ring);
+}
+
+Profiler::Ring& Profiler::GetRing()
+{
+    if (threadRing.ring != nullptr)
+        return *threadRing.ring;
+
+    std::unique_lock lock(ringsMutex);
+
+    Ring* ring = nullptr;
+
+    if (!freeRings.empty())
+    {
+        ring = freeRings.back();
+        freeRings.pop_back();
+
+        /* the previous thread's zones and names go with it */
+        ring->tail.store(ring->head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        ring->names.clear();
+    }
+    else
+    {
+        auto& created = rings.emplace_back(std::make_unique<Ring>());
+
+        created->samples = std::make_unique<Sample[]>(RING_SIZE);
+        created->head    = 0;
+        created->tail    = 0;
+
+        ring = created.get();
+    }
+
+    ring->id = nextId++;
+
+    if (pendingName.empty())
+        ring->threadName = std::format("thread {}", ring->id);
+    else
+        ring->threadName = std::move(pendingName);
+
+    threadRing.ring = ring;
+
+    return *ring;
+}
+
+void Profiler::SetEnabled(bool enable)
+{
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const std::string& name)
+{
+    if (threadRing.ring == nullptr)
+    {
+        pendingName = name;
+        return;
+    }
+
+    std::unique_lock lock(ringsMutex);
+    threadRing.ring->threadName = name;
+}
+
+double Profiler::GetTime()
+{
+    return Timer<Console::Which>::GetTime();
+}
+
+void Profiler::Emit(const char* name, double begin, double end)
+{
+    Ring& ring = Profiler::GetRing();
+
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+
+    ring.samples[head % RING_SIZE] = { name, begin, end };
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::Push(const char* name)
+{
+    if (!Profiler::IsEnabled())
+    {
+        openZones.push_back({ nullptr, 0 });
+        return;
+    }
+
+    Ring& ring = Profiler::GetRing();
+
+    const char* interned = "(other zones)";
+
+    if (ring.names.size() < MAX_NAMES)
+        interned = ring.names.emplace(name).first->c_str();
+    else if (auto found = ring.names.find(name); found != ring.names.end())
+        interned = found->c_str();
+
+    openZones.push_back({ interned, Profiler::GetTime() });
+}
+
+bool Profiler::Pop()
+{
+    if (openZones.empty())
+        return false;
+
+    const OpenZone zone = openZones.back();
+    openZones.pop_back();
+
+    if (zone.name != nullptr)
+        Profiler::Emit(zone.name, zone.begin, Profiler::GetTime());
+
+    return true;
+}
+
+void Profiler::Clear()
+{
+    std::unique_lock lock(ringsMutex);
+
+    for (auto& ring : rings)
+        ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+std::string Profiler::ExportTrace()
+{
+    std::unique_lock lock(ringsMutex);
+
+    std::string output = "{\"traceEvents\":[";
+    std::vector<Sample> samples;
+
+    bool first = true;
+
+    const auto separate = [&]() {
+        if (!first)
+            output += ',';
+
+        first = false;
+    };
+
+    for (const auto& ring : rings)
+    {
+        separate();
+
+        output += std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},"
+                              "\"args\":{{\"name\":\"",
+                              ring->id);
+        appendEscaped(output, ring->threadName);
+        output += "\"}}";
+
+        const uint64_t head  = ring->head.load(std::memory_order_acquire);
+        const uint64_t start = head > RING_SIZE ? head - RING_SIZE : 0;
+
+        uint64_t index = std::max(start, ring->tail.load(std::memory_order_relaxed));
+
+        samples.clear();
+
+        for (uint64_t at = index; at < head; at++)
+            samples.push_back(ring->samples[at % RING_SIZE]);
+
+        /* drop whatever the thread wrote over while we were copying */
+        const uint64_t after = ring->head.load(std::memory_order_acquire);
+        const uint64_t stale = after >= RING_SIZE ? after - RING_SIZE + 1 : 0;
+
+        for (const auto& sample : samples)
+        {
+            if (index++ < stale)
+                continue;
+
+            separate();
+
+            output += "{\"name\":\"";
+            appendEscaped(output, sample.name);
+            output += std::format("\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},"
+                                  "\"dur\":{:.3f}}}",
+                                  ring->id, sample.begin * 1000000.0,
+                                  (sample.end - sample.begin) * 1000000.0);
+        }
+    }
+
+    output += "]}";
+
+    return output;
+}
@@ -0,0 +1,87 @@
+#include <modules/profiler/wrap_profiler.hpp>
+
+using namespace love;
+
+#define instance() (Module::GetInstance<Profiler>(Module::M_PROFILER))
+
+int Wrap_Profiler::Clear(lua_State* L)
+{
+    Profiler::Clear();
+
+    return 0;
+}
+
+int Wrap_Profiler::ExportTrace(lua_State* L)
+{
+    std::string trace;
+    luax::CatchException(L, [&]() { trace = Profiler::ExportTrace(); });
+
+    luax::PushString(L, trace);
+
+    return 1;
+}
+
+int Wrap_Profiler::IsEnabled(lua_State* L)
+{
+    luax::PushBoolean(L, Profiler::IsEnabled());
+
+    return 1;
+}
+
+int Wrap_Profiler::Pop(lua_State* L)
+{
+    if (!Profiler::Pop())
+        return luaL_error(L, "No profiler zone to pop.");
+
+    return 0;
+}
+
+int Wrap_Profiler::Push(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+
+    luax::CatchException(L, [&]() { Profiler::Push(name); });
+
+    return 0;
+}
+
+int Wrap_Profiler::SetEnabled(lua_State* L)
+{
+    bool enable = luax::CheckBoolean(L, 1);
+
+    Profiler::SetEnabled(enable);
+
+    return 0;
+}
+
+// clang-format off
+static constexpr luaL_Reg functions[] =
+{
+    { "clear",       Wrap_Profiler::Clear       },
+    { "exportTrace", Wrap_Profiler::ExportTrace },
+    { "isEnabled",   Wrap_Profiler::IsEnabled   },
+    { "pop",         Wrap_Profiler::Pop         },
+    { "push",        Wrap_Profiler::Push        },
+    { "setEnabled",  Wrap_Profiler::SetEnabled  }
+};
+// clang-format on
+
+int Wrap_Profiler::Register(lua_State* L)
+{
+    auto* instance = instance();
+
+    if (instance == nullptr)
+        luax::CatchException(L, [&]() { instance = new Profiler(); });
+    else
+        instance->Retain();
+
+    WrappedModule wrappedModule;
+
+    wrappedModule.instance  = instance;
+    wrappedModule.name      = "profiler";
+    wrappedModule.functions = functions;
+    wrappedModule.type      = &Module::type;
+    wrappedModule.types     = nullptr;
+
+    return luax::RegisterModule(L, wrappedModule);
+}
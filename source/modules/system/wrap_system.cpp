@@ -1,6 +1,8 @@
 #include <modules/system/wrap_system.hpp>
 #include <modules/system_ext.hpp>
 
+#include <common/memorystats.hpp>
+
 #if !defined(__3DS__)
 std::span<const luaL_Reg> Wrap_System::extensions;
 #endif
@@ -120,18 +122,65 @@ int Wrap_System::GetSystemTheme(lua_State* L)
     return 1;
 }
 
+int Wrap_System::GetMemoryStats(lua_State* L)
+{
+    if (lua_istable(L, 1))
+        lua_pushvalue(L, 1);
+    else
+        lua_createtable(L, 0, MemoryStats::CATEGORY_MAX_ENUM);
+
+    for (int index = 0; index < MemoryStats::CATEGORY_MAX_ENUM; index++)
+    {
+        const auto category = (MemoryStats::Category)index;
+        const auto usage    = MemoryStats::Get(category);
+
+        const char* name = *MemoryStats::categories.ReverseFind(category);
+
+        /* reuse the subtables of a table passed back in, so polling doesn't make garbage */
+        lua_getfield(L, -1, name);
+
+        if (!lua_istable(L, -1))
+        {
+            lua_pop(L, 1);
+            lua_createtable(L, 0, 2);
+
+            lua_pushvalue(L, -1);
+            lua_setfield(L, -3, name);
+        }
+
+        lua_pushinteger(L, usage.current);
+        lua_setfield(L, -2, "current");
+
+        lua_pushinteger(L, usage.peak);
+        lua_setfield(L, -2, "peak");
+
+        lua_pop(L, 1);
+    }
+
+    return 1;
+}
+
+int Wrap_System::ResetMemoryPeaks(lua_State*)
+{
+    MemoryStats::ResetPeaks();
+
+    return 0;
+}
+
 // clang-format off
 static constexpr luaL_Reg functions[] =
 {
     { "getColorTheme",       Wrap_System::GetSystemTheme      },
     { "getFriendInfo",       Wrap_System::GetFriendInfo       },
+    { "getMemoryStats",      Wrap_System::GetMemoryStats      },
     { "getPreferredLocales", Wrap_System::GetPreferredLocales },
     { "getModel",            Wrap_System::GetModel            },
     { "getNetworkInfo",      Wrap_System::GetNetworkInfo      },
     { "getOS",               Wrap_System::GetOS               },
     { "getPowerInfo",        Wrap_System::GetPowerInfo        },
     { "getProcessorCount",   Wrap_System::GetProcessorCount   },
-    { "getVersion",          Wrap_System::GetVersion          }
+    { "getVersion",          Wrap_System::GetVersion          },
+    { "resetMemoryPeaks",    Wrap_System::ResetMemoryPeaks    }
 };
 // clang-format on
 
@@ -1,6 +1,9 @@
 #include <modules/thread/threadmodule.hpp>
+#include <utilities/hashfunction/fnv1a.hpp>
 #include <utilities/threads/threads.hpp>
 
+#include <string_view>
+
 using namespace love;
 
 LuaThread* ThreadModule::NewThread(const std::string& name, Data* code) const
@@ -27,3 +30,62 @@ Channel* ThreadModule::GetChannel(const std::string& name)
 
     return channel;
 }
+
+uint64_t ThreadModule::GetBytecodeKey(const std::string& name, Data* code)
+{
+    /* FNV-1a over the chunk name and the source text */
+    uint64_t hash = love::FNV1a(name.data(), name.size());
+    hash          = love::FNV1a(code->GetData(), code->GetSize(), hash);
+
+    return hash ^ code->GetSize();
+}
+
+std::shared_ptr<const std::string> ThreadModule::GetBytecode(const std::string& name, Data* code)
+{
+    const uint64_t key = ThreadModule::GetBytecodeKey(name, code);
+    const std::string_view source((const char*)code->GetData(), code->GetSize());
+
+    std::unique_lock lock(this->bytecodeMutex);
+
+    auto iterator = this->bytecodeCache.find(key);
+
+    if (iterator == this->bytecodeCache.end())
+        return nullptr;
+
+    const auto& entry = iterator->second;
+
+    if (entry.name != name || entry.source != source)
+        return nullptr;
+
+    return entry.bytecode;
+}
+
+void ThreadModule::SetBytecode(const std::string& name, Data* code, std::string&& bytecode)
+{
+    const uint64_t key = ThreadModule::GetBytecodeKey(name, code);
+
+    CachedBytecode entry {};
+
+    entry.name     = name;
+    entry.source   = std::string((const char*)code->GetData(), code->GetSize());
+    entry.bytecode = std::make_shared<const std::string>(std::move(bytecode));
+
+    std::unique_lock lock(this->bytecodeMutex);
+
+    /* a colliding source takes the slot over */
+    if (auto iterator = this->bytecodeCache.find(key); iterator != this->bytecodeCache.end())
+    {
+        iterator->second = std::move(entry);
+        return;
+    }
+
+    /* threads already running keep their bytecode alive through the shared_ptr */
+    if (this->bytecodeCache.size() >= MAX_CACHED_BYTECODE)
+    {
+        this->bytecodeCache.erase(this->bytecodeOrder.front());
+        this->bytecodeOrder.pop_front();
+    }
+
+    this->bytecodeCache.emplace(key, std::move(entry));
+    this->bytecodeOrder.push_back(key);
+}
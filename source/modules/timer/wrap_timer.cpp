@@ -1,6 +1,8 @@
 #include <modules/timer/wrap_timer.hpp>
 #include <modules/timer_ext.hpp>
 
+#include <modules/event/event.hpp>
+
 using namespace love;
 
 #define instance() (Module::GetInstance<Timer<Console::Which>>(Module::M_TIMER))
@@ -54,6 +56,12 @@ int Wrap_Timer::Step(lua_State* L)
 {
     double dt = instance()->Step();
 
+    if (auto* event = Module::GetInstance<Event>(Module::M_EVENT))
+    {
+        luax::CatchException(L, [&]() { dt = event->Step(dt); });
+        instance()->SetDelta(dt);
+    }
+
     lua_pushnumber(L, dt);
 
     return 1;
@@ -0,0 +1,252 @@
+#include <objects/atlas/atlas.hpp>
+
+#include <common/exception.hpp>
+
+#include <modules/graphics_ext.hpp>
+#include <objects/texture_ext.hpp>
+
+#include <utilities/extrude.hpp>
+#include <utilities/pixelconverter.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace love;
+
+Type Atlas::type("Atlas", &Object::type);
+
+Atlas::Atlas(const Settings& settings) : settings(settings)
+{
+    if (settings.width <= 0 || settings.height <= 0)
+        throw love::Exception("Invalid atlas page dimensions.");
+
+    if (settings.padding < 0 || settings.extrude < 0)
+        throw love::Exception("Atlas padding and extrusion must not be negative.");
+
+    if (love::IsPixelFormatCompressed(settings.format) || love::IsPixelFormatDepth(settings.format))
+    {
+        const char* name = love::GetPixelFormatName(settings.format);
+        throw love::Exception("Atlas pages cannot use the %s pixel format.", name);
+    }
+}
+
+Atlas::~Atlas()
+{}
+
+void Atlas::CreatePage()
+{
+    auto* graphics = Module::GetInstance<Graphics<Console::Which>>(Module::M_GRAPHICS);
+
+    if (graphics == nullptr)
+        throw love::Exception("love.graphics must be loaded in order to create an Atlas page.");
+
+    Texture<>::Settings settings {};
+    settings.width  = this->settings.width;
+    settings.height = this->settings.height;
+    settings.format = this->settings.format;
+
+    SkylinePacker packer(this->settings.width, this->settings.height, this->settings.padding);
+
+    Page page { StrongReference<Texture<Console::Which>>(), packer };
+    page.texture.Set(graphics->NewTexture(settings, nullptr), Acquire::NORETAIN);
+
+    this->pages.push_back(std::move(page));
+}
+
+void Atlas::Check(ImageData<Console::Which>* data) const
+{
+    if (data == nullptr)
+        throw love::Exception("Cannot add a null ImageData to an Atlas.");
+
+    const auto format = data->GetFormat();
+
+    if (format != this->settings.format &&
+        PixelConverter::GetRowFunction(format, this->settings.format) == nullptr)
+    {
+        const char* formatName = love::GetPixelFormatName(format);
+        throw love::Exception("Cannot add %s ImageData to an Atlas.", formatName);
+    }
+
+    const int border = this->settings.extrude * 2 + this->settings.padding * 2;
+
+    if (data->GetWidth() + border > this->settings.width ||
+        data->GetHeight() + border > this->settings.height)
+    {
+        throw love::Exception("ImageData (%dx%d) is too large for an Atlas page (%dx%d).",
+                              data->GetWidth(), data->GetHeight(), this->settings.width,
+                              this->settings.height);
+    }
+}
+
+Atlas::Entry Atlas::Pack(ImageData<Console::Which>* data)
+{
+    const int width  = data->GetWidth();
+    const int height = data->GetHeight();
+
+    /* each cell holds the image and its extruded edges; the packer adds the padding */
+    const int border     = this->settings.extrude * 2;
+    const int cellWidth  = width + border;
+    const int cellHeight = height + border;
+
+    Rect cell {};
+    size_t pageIndex = 0;
+
+    for (; pageIndex < this->pages.size(); pageIndex++)
+    {
+        if (this->pages[pageIndex].packer.Insert(cellWidth, cellHeight, cell))
+            break;
+    }
+
+    if (pageIndex == this->pages.size())
+    {
+        this->CreatePage();
+        this->pages.back().packer.Insert(cellWidth, cellHeight, cell);
+    }
+
+    this->Upload(this->pages[pageIndex], cell, data);
+
+    const int x = cell.x + this->settings.extrude;
+    const int y = cell.y + this->settings.extrude;
+
+    const Quad::Viewport viewport { (double)x, (double)y, (double)width, (double)height };
+
+    Entry entry {};
+    entry.quad.Set(new Quad(viewport, this->settings.width, this->settings.height),
+                   Acquire::NORETAIN);
+    entry.page = (int)pageIndex;
+    entry.rect = { x, y, width, height };
+
+    return entry;
+}
+
+int Atlas::Insert(Entry&& entry, const std::string& name)
+{
+    this->entries.push_back(std::move(entry));
+
+    const int index = (int)this->entries.size() - 1;
+
+    if (!name.empty())
+        this->names[name] = index;
+
+    return index;
+}
+
+int Atlas::Add(ImageData<Console::Which>* data, const std::string& name)
+{
+    this->Check(data);
+
+    return this->Insert(this->Pack(data), name);
+}
+
+void Atlas::Add(const std::vector<Source>& sources, std::vector<int>& indices)
+{
+    for (const auto& source : sources)
+        this->Check(source.data);
+
+    std::vector<size_t> order(sources.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    /* skylines pack best tallest-first */
+    std::stable_sort(order.begin(), order.end(), [&sources](size_t a, size_t b) {
+        const auto* first  = sources[a].data;
+        const auto* second = sources[b].data;
+
+        if (first->GetHeight() != second->GetHeight())
+            return first->GetHeight() > second->GetHeight();
+
+        return first->GetWidth() > second->GetWidth();
+    });
+
+    std::vector<Entry> packed(sources.size());
+
+    for (const size_t index : order)
+        packed[index] = this->Pack(sources[index].data);
+
+    /* entries are numbered in the order given, not the order packed */
+    indices.resize(sources.size());
+
+    for (size_t index = 0; index < sources.size(); index++)
+        indices[index] = this->Insert(std::move(packed[index]), sources[index].name);
+}
+
+void Atlas::Upload(Page& page, const Rect& cell, ImageData<Console::Which>* data)
+{
+    const int extrude = this->settings.extrude;
+    const int width   = data->GetWidth();
+    const int height  = data->GetHeight();
+
+    const size_t pixelSize  = love::GetPixelFormatBlockSize(this->settings.format);
+    const size_t sourceSize = data->GetPixelSize();
+
+    PixelConverter::RowFunction convertRow = nullptr;
+
+    if (data->GetFormat() != this->settings.format)
+        convertRow = PixelConverter::GetRowFunction(data->GetFormat(), this->settings.format);
+
+    std::vector<uint8_t> gathered(width * sourceSize);
+    std::vector<uint8_t> converted(width * pixelSize);
+
+    size_t pitch    = 0;
+    uint8_t* pixels = page.texture->LockPixels(cell, pitch);
+
+    std::unique_lock lock(data->GetMutex());
+
+    Extrude::WriteCell(pixels, pitch, width, height, extrude, pixelSize, [&](int y) {
+        const uint8_t* source = data->GetPixelAddress(0, y);
+
+        /* tiled rows aren't contiguous */
+        if (Console::Is(Console::CTR))
+        {
+            for (int x = 0; x < width; x++)
+                std::memcpy(&gathered[x * sourceSize], data->GetPixelAddress(x, y), sourceSize);
+
+            source = gathered.data();
+        }
+
+        if (convertRow != nullptr)
+        {
+            convertRow(source, converted.data(), width);
+            source = converted.data();
+        }
+
+        return source;
+    });
+
+    lock.unlock();
+
+    page.texture->UnlockPixels();
+}
+
+const Atlas::Entry& Atlas::GetEntry(int index) const
+{
+    if (index < 0 || index >= (int)this->entries.size())
+        throw love::Exception("Invalid Atlas entry index: %d", index + 1);
+
+    return this->entries[index];
+}
+
+std::optional<int> Atlas::FindEntry(const std::string& name) const
+{
+    const auto iterator = this->names.find(name);
+
+    if (iterator == this->names.end())
+        return std::nullopt;
+
+    return iterator->second;
+}
+
+Texture<Console::Which>* Atlas::GetTexture(int page) const
+{
+    if (page < 0 || page >= (int)this->pages.size())
+        throw love::Exception("Invalid Atlas page index: %d", page + 1);
+
+    return this->pages[page].texture.Get();
+}
+
+float Atlas::GetOccupancy(int page) const
+{
+    if (page < 0 || page >= (int)this->pages.size())
+        throw love::Exception("Invalid Atlas page index: %d", page + 1);
+
+    return this->pages[page].packer.GetOccupancy();
+}
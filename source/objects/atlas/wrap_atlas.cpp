@@ -0,0 +1,189 @@
+#include <objects/atlas/wrap_atlas.hpp>
+
+#include <modules/filesystem/wrap_filesystem.hpp>
+#include <modules/image/imagemodule.hpp>
+
+#include <objects/imagedata/wrap_imagedata.hpp>
+#include <objects/texture_ext.hpp>
+
+using namespace love;
+
+Atlas* Wrap_Atlas::CheckAtlas(lua_State* L, int index)
+{
+    return luax::CheckType<Atlas>(L, index);
+}
+
+StrongReference<ImageData<Console::Which>> Wrap_Atlas::CheckImage(lua_State* L, int index,
+                                                                  std::string& name)
+{
+    StrongReference<ImageData<Console::Which>> image;
+
+    if (luax::IsType(L, index, ImageData<>::type))
+    {
+        image.Set(Wrap_ImageData::CheckImageData(L, index));
+        return image;
+    }
+
+    if (lua_type(L, index) == LUA_TSTRING)
+        name = lua_tostring(L, index);
+
+    auto* module = Module::GetInstance<ImageModule>(Module::M_IMAGE);
+
+    if (module == nullptr)
+        luaL_error(L, "Cannot load images without the image module.");
+
+    StrongReference<Data> data(Wrap_Filesystem::GetData(L, index), Acquire::NORETAIN);
+
+    luax::CatchException(L, [&]() { image.Set(module->NewImageData(data), Acquire::NORETAIN); });
+
+    return image;
+}
+
+static void pushEntry(lua_State* L, Atlas* self, int index)
+{
+    const auto& entry = self->GetEntry(index);
+
+    luax::PushType(L, entry.quad.Get());
+    luax::PushType(L, self->GetTexture(entry.page));
+}
+
+static int checkEntry(lua_State* L, Atlas* self, int index)
+{
+    if (lua_type(L, index) == LUA_TSTRING)
+    {
+        const char* name = lua_tostring(L, index);
+        const auto entry = self->FindEntry(name);
+
+        if (!entry)
+            return luaL_error(L, "No Atlas entry named '%s'.", name);
+
+        return *entry;
+    }
+
+    const int entry = luaL_checkinteger(L, index) - 1;
+
+    if (entry < 0 || entry >= self->GetEntryCount())
+        return luaL_error(L, "Invalid Atlas entry index: %d", entry + 1);
+
+    return entry;
+}
+
+int Wrap_Atlas::Add(lua_State* L)
+{
+    auto* self = Wrap_Atlas::CheckAtlas(L, 1);
+
+    std::string name {};
+    auto image = Wrap_Atlas::CheckImage(L, 2, name);
+
+    if (!lua_isnoneornil(L, 3))
+        name = luaL_checkstring(L, 3);
+
+    int index = 0;
+    luax::CatchException(L, [&]() { index = self->Add(image, name); });
+
+    lua_pushinteger(L, index + 1);
+    pushEntry(L, self, index);
+
+    return 3;
+}
+
+int Wrap_Atlas::GetQuad(lua_State* L)
+{
+    auto* self = Wrap_Atlas::CheckAtlas(L, 1);
+    int index  = checkEntry(L, self, 2);
+
+    pushEntry(L, self, index);
+
+    return 2;
+}
+
+int Wrap_Atlas::GetIndex(lua_State* L)
+{
+    auto* self       = Wrap_Atlas::CheckAtlas(L, 1);
+    const char* name = luaL_checkstring(L, 2);
+
+    if (auto index = self->FindEntry(name))
+        lua_pushinteger(L, *index + 1);
+    else
+        lua_pushnil(L);
+
+    return 1;
+}
+
+int Wrap_Atlas::GetCount(lua_State* L)
+{
+    auto* self = Wrap_Atlas::CheckAtlas(L, 1);
+
+    lua_pushinteger(L, self->GetEntryCount());
+
+    return 1;
+}
+
+int Wrap_Atlas::GetTexture(lua_State* L)
+{
+    auto* self = Wrap_Atlas::CheckAtlas(L, 1);
+    int page   = luaL_optinteger(L, 2, 1) - 1;
+
+    Texture<Console::Which>* texture = nullptr;
+    luax::CatchException(L, [&]() { texture = self->GetTexture(page); });
+
+    luax::PushType(L, texture);
+
+    return 1;
+}
+
+int Wrap_Atlas::GetTextures(lua_State* L)
+{
+    auto* self = Wrap_Atlas::CheckAtlas(L, 1);
+
+    lua_createtable(L, self->GetPageCount(), 0);
+
+    for (int page = 0; page < self->GetPageCount(); page++)
+    {
+        luax::PushType(L, self->GetTexture(page));
+        lua_rawseti(L, -2, page + 1);
+    }
+
+    return 1;
+}
+
+int Wrap_Atlas::GetPageCount(lua_State* L)
+{
+    auto* self = Wrap_Atlas::CheckAtlas(L, 1);
+
+    lua_pushinteger(L, self->GetPageCount());
+
+    return 1;
+}
+
+int Wrap_Atlas::GetOccupancy(lua_State* L)
+{
+    auto* self = Wrap_Atlas::CheckAtlas(L, 1);
+    int page   = luaL_optinteger(L, 2, 1) - 1;
+
+    float occupancy = 0.0f;
+    luax::CatchException(L, [&]() { occupancy = self->GetOccupancy(page); });
+
+    lua_pushnumber(L, occupancy);
+
+    return 1;
+}
+
+// clang-format off
+static constexpr luaL_Reg functions[] =
+{
+    { "add",          Wrap_Atlas::Add          },
+    { "getCount",     Wrap_Atlas::GetCount     },
+    { "getIndex",     Wrap_Atlas::GetIndex     },
+    { "getOccupancy", Wrap_Atlas::GetOccupancy },
+    { "getPageCount", Wrap_Atlas::GetPageCount },
+    { "getQuad",      Wrap_Atlas::GetQuad      },
+    { "getTexture",   Wrap_Atlas::GetTexture   },
+    { "getTextures",  Wrap_Atlas::GetTextures  }
+};
+// clang-format on
+
+int Wrap_Atlas::Register(lua_State* L)
+{
+    return luax::RegisterType(L, &Atlas::type, functions);
+}
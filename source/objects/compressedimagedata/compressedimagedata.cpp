@@ -9,19 +9,19 @@ CompressedImageData::CompressedImageData(const std::list<FormatHandler*>& format
     format(PIXELFORMAT_UNKNOWN),
     sRGB(false)
 {
-    FormatHandler* parser = nullptr;
+    FormatHandler* parser = FormatHandler::Find(formats, fileData, true);
 
-    for (auto* handler : formats)
+    if (parser == nullptr)
     {
-        if (handler->CanParseCompressed(fileData))
-        {
-            parser = handler;
-            break;
-        }
-    }
+        const auto signature = FormatHandler::Sniff(fileData);
 
-    if (parser == nullptr)
-        throw love::Exception("Could not parse compressed data: Unknown format.");
+        if (signature == FormatHandler::SIGNATURE_UNKNOWN)
+            throw love::Exception("Could not parse compressed data: Unknown format.");
+
+        throw love::Exception("Could not parse compressed data: %s data is not a supported "
+                              "compressed format.",
+                              FormatHandler::GetSignatureName(signature));
+    }
 
     this->memory = parser->ParseCompressed(fileData, this->images, this->format, this->sRGB);
 
@@ -35,6 +35,26 @@ CompressedImageData::CompressedImageData(const std::list<FormatHandler*>& format
         throw love::Exception("Could not parse compressed data: No valid data?");
 }
 
+CompressedImageData::CompressedImageData(PixelFormat format, int width, int height,
+                                         ByteData* memory, bool sRGB) :
+    format(format),
+    sRGB(sRGB),
+    memory(memory)
+{
+    if (!love::IsPixelFormatCompressed(format))
+        throw love::Exception("CompressedImageData requires a compressed pixel format.");
+
+    const size_t size = love::GetPixelFormatSliceSize(format, width, height, false);
+
+    if (memory == nullptr || memory->GetSize() < size)
+        throw love::Exception("Could not create CompressedImageData: not enough data.");
+
+    auto slice = new CompressedSlice(format, width, height, memory, 0, size);
+
+    this->images.push_back(slice);
+    slice->Release();
+}
+
 CompressedImageData::CompressedImageData(const CompressedImageData& data) :
     format(data.format),
     sRGB(data.sRGB)
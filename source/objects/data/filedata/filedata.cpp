@@ -12,8 +12,8 @@ Type FileData::type("FileData", &Data::type);
 
 FileData::FileData(uint64_t size, const std::string& filename) :
     data(nullptr),
-    size((size_t)size),
-    filename(filename)
+    pointer(nullptr),
+    size((size_t)size)
 {
     try
     {
@@ -24,6 +24,26 @@ FileData::FileData(uint64_t size, const std::string& filename) :
         throw love::Exception("Out of memory.");
     }
 
+    this->pointer = this->data.get();
+    this->SetFilename(filename);
+}
+
+FileData::FileData(Data* source, size_t offset, size_t size, const std::string& filename) :
+    data(nullptr),
+    source(source),
+    pointer(nullptr),
+    size(size)
+{
+    if (offset > source->GetSize() || size > source->GetSize() - offset)
+        throw love::Exception("FileData view is out of its source's range.");
+
+    this->pointer = (char*)source->GetData() + offset;
+    this->SetFilename(filename);
+}
+
+void FileData::SetFilename(const std::string& filename)
+{
+    this->filename  = filename;
     const auto path = std::filesystem::path(filename);
 
     if (path.has_extension())
@@ -37,6 +57,7 @@ FileData::FileData(uint64_t size, const std::string& filename) :
 
 FileData::FileData(const FileData& content) :
     data(nullptr),
+    pointer(nullptr),
     size(content.size),
     filename(content.filename),
     extension(content.extension),
@@ -51,7 +72,9 @@ FileData::FileData(const FileData& content) :
         throw love::Exception("Out of memory.");
     }
 
-    std::copy_n(content.data.get(), this->size, this->data.get());
+    /* views are copied into memory of their own */
+    std::copy_n(content.pointer, this->size, this->data.get());
+    this->pointer = this->data.get();
 }
 
 FileData* FileData::Clone() const
@@ -61,7 +84,7 @@ FileData* FileData::Clone() const
 
 void* FileData::GetData() const
 {
-    return this->data.get();
+    return this->pointer;
 }
 
 size_t FileData::GetSize() const
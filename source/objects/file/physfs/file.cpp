@@ -7,6 +7,15 @@
 
 using namespace love::physfs;
 
+/* what the filesystem cached about @filename is out of date once it has been written */
+static void invalidatePath(const std::string& filename)
+{
+    if (auto* filesystem = love::Module::GetInstance<Filesystem>(love::Module::M_FILESYSTEM))
+        filesystem->InvalidatePath(filename.c_str());
+    else
+        love::Filesystem::Invalidate();
+}
+
 File::File(const std::string& filename, Mode mode) :
     filename(filename),
     file(nullptr),
@@ -96,6 +105,10 @@ bool File::Open(Mode mode)
     this->file     = handle;
     this->fileMode = mode;
 
+    /* a newly written file may shadow (or be) a module that failed to resolve before */
+    if (mode == MODE_APPEND || mode == MODE_WRITE)
+        invalidatePath(this->filename);
+
     if (this->file != nullptr && this->SetBuffer(this->bufferMode, this->bufferSize))
     {
         this->bufferMode = BUFFER_NONE;
@@ -110,6 +123,10 @@ bool File::Close()
     if (!this->file || !PHYSFS_close(this->file))
         return false;
 
+    /* sizes and times cached while it was being written are out of date now */
+    if (this->fileMode == MODE_APPEND || this->fileMode == MODE_WRITE)
+        invalidatePath(this->filename);
+
     this->fileMode = MODE_CLOSED;
     this->file     = nullptr;
 
@@ -5,8 +5,13 @@
 #include <modules/data/data.hpp>
 #include <modules/data/wrap_data.hpp>
 
+#include <objects/data/bytedata/bytedata.hpp>
 #include <objects/file/wrap_file.hpp>
 
+#include <utilities/linereader.hpp>
+
+#include <cstring>
+
 using namespace love;
 
 int Wrap_File::Close(lua_State* L)
@@ -121,113 +126,127 @@ int Wrap_File::IsOpen(lua_State* L)
     return 1;
 }
 
+/* lines() reads this much at a time, and only grows past it for longer lines */
+static constexpr size_t LINES_BUFFER_SIZE = 0x10000;
+
 /*
 ** See: https://github.com/love2d/love/blob/master/src/modules/filesystem/wrap_File.cpp#L239
+**
+** Lines are found with memchr in a large reusable buffer and only the returned line becomes
+** a Lua string. In slices mode not even that: the iterator returns the buffer as ByteData
+** with the line's offset and size, valid until the next call.
 **/
 int Wrap_File::Lines_I(lua_State* L)
 {
     /*
     ** The upvalues:
     ** File
-    ** read buffer (string)
-    ** read buffer offset (number)
-    ** file position (number, optional)
-    ** restore userpos (bool, optional)
+    ** read buffer (ByteData)
+    ** reader state (LineReader userdata)
     */
 
-    auto* self = luax::CheckType<File>(L, lua_upvalueindex(1));
+    auto* self   = luax::CheckType<File>(L, lua_upvalueindex(1));
+    auto* buffer = luax::CheckType<ByteData>(L, lua_upvalueindex(2));
+    auto* reader = (LineReader*)lua_touserdata(L, lua_upvalueindex(3));
 
     if (self->GetMode() != File::MODE_READ)
         return luaL_error(L, "File needs to stay in read mode.");
 
-    size_t length      = 0;
-    const char* buffer = lua_tolstring(L, lua_upvalueindex(2), &length);
-    int offset         = lua_tointeger(L, lua_upvalueindex(3));
-
-    const char* start = buffer + offset;
-    const char* end   = reinterpret_cast<const char*>(memchr(start, '\n', length - offset));
+    /* the start of a line that didn't fit in the buffer, in string mode */
+    luaL_Buffer spill;
+    bool spilled = false;
 
-    bool seekBack = lua_toboolean(L, lua_upvalueindex(5));
-
-    while (!end && !self->IsEOF())
+    while (true)
     {
-        const int bufferSize = 0x400;
-        char readBuffer[bufferSize];
-
-        // new buffer
-        luaL_Buffer storage;
-        luaL_buffinit(L, &storage);
-        luaL_addlstring(&storage, start, length - offset);
+        char* data    = (char*)buffer->GetData();
+        size_t offset = 0;
+        size_t length = 0;
 
-        // seek back if the user changed the position
-        int64_t position    = self->Tell();
-        int64_t userPostion = -1;
-
-        if (seekBack)
+        switch (reader->Next(data, buffer->GetSize(), offset, length))
         {
-            userPostion = position;
-            position    = lua_tonumber(L, lua_upvalueindex(4));
+            case LineReader::STEP_LINE:
+            {
+                if (reader->slices)
+                {
+                    lua_pushvalue(L, lua_upvalueindex(2));
+                    lua_pushinteger(L, offset);
+                    lua_pushinteger(L, length);
+
+                    return 3;
+                }
+
+                if (!spilled)
+                {
+                    lua_pushlstring(L, data + offset, length);
+                    return 1;
+                }
+
+                luaL_addlstring(&spill, data + offset, length);
+                luaL_pushresult(&spill);
+
+                return 1;
+            }
+            case LineReader::STEP_END:
+            {
+                if (spilled)
+                {
+                    luaL_pushresult(&spill);
+                    return 1;
+                }
+
+                self->Close();
+                return 0;
+            }
+            case LineReader::STEP_FULL:
+            {
+                if (reader->slices)
+                {
+                    /* a slice must be contiguous, so grow the buffer to fit the line */
+                    auto* larger = new ByteData(buffer->GetSize() * 2, false);
+                    std::memcpy(larger->GetData(), data, reader->end);
+
+                    luax::PushType(L, larger);
+                    larger->Release();
+                    lua_replace(L, lua_upvalueindex(2));
+
+                    buffer = larger;
+                }
+                else
+                {
+                    if (!spilled)
+                        luaL_buffinit(L, &spill);
+
+                    spilled = true;
+
+                    const size_t moved = reader->GetSpillSize(data);
+
+                    luaL_addlstring(&spill, data, moved);
+                    reader->Discard(data, moved);
+                }
 
-            if (userPostion != position)
-                self->Seek(position);
-        }
-
-        // keep reading until EOF
-        while (!self->IsEOF())
-        {
-            int read = (int)self->Read(readBuffer, bufferSize);
-
-            if (read < 0)
-                return luaL_error(L, "Could not read from file.");
-
-            luaL_addlstring(&storage, readBuffer, read);
-
-            // break at a newline, if found
-            if (memchr(readBuffer, '\n', read))
+                break;
+            }
+            case LineReader::STEP_REFILL:
                 break;
         }
 
-        // possibly seek back and save our target position too
-        if (seekBack)
-        {
-            lua_pushnumber(L, self->Tell());
-            lua_replace(L, lua_upvalueindex(4));
-
-            self->Seek(userPostion);
-        }
-
-        luaL_pushresult(&storage);
-        lua_replace(L, lua_upvalueindex(2));
-
-        buffer = lua_tolstring(L, lua_upvalueindex(2), &length);
-        offset = 0;
-        start  = buffer;
-        end    = reinterpret_cast<const char*>(memchr(start, '\n', length));
-    }
-
-    if (!end)
-        end = buffer + length - 1;
-
-    offset = end - buffer + 1;
-    lua_pushinteger(L, offset);
-    lua_replace(L, lua_upvalueindex(3));
-
-    if (start == buffer + length)
-    {
-        self->Close();
-
-        return 0;
+        if (!reader->Refill(self, (char*)buffer->GetData(), buffer->GetSize()))
+            return luaL_error(L, "Could not read from file.");
     }
+}
 
-    if (end >= start && *end == '\n')
-        --end;
+void Wrap_File::PushLinesIterator(lua_State* L, int index, bool seekBack, bool slices)
+{
+    lua_pushvalue(L, index);
 
-    if (end >= start && *end == '\r')
-        --end;
+    auto* buffer = new ByteData(LINES_BUFFER_SIZE, false);
+    luax::PushType(L, buffer);
+    buffer->Release();
 
-    lua_pushlstring(L, start, end - start + 1);
+    auto* reader = (LineReader*)lua_newuserdata(L, sizeof(LineReader));
+    *reader      = LineReader { 0, 0, 0, seekBack, slices, false };
 
-    return 1;
+    lua_pushcclosure(L, Wrap_File::Lines_I, 3);
 }
 
 /*
@@ -237,12 +256,13 @@ int Wrap_File::Lines(lua_State* L)
 {
     auto* self = Wrap_File::CheckFile(L, 1);
 
-    lua_pushstring(L, "");
-    lua_pushnumber(L, 0);
-    lua_pushnumber(L, 0);
-    lua_pushboolean(L, self->GetMode() != File::MODE_CLOSED);
+    bool slices = false;
+
+    if (!lua_isnoneornil(L, 2))
+        slices = Wrap_DataModule::CheckContainerType(L, 2) == DataModule::CONTAINER_DATA;
 
     File::Mode currentMode = self->GetMode();
+    const bool seekBack    = currentMode != File::MODE_CLOSED;
 
     if (currentMode != File::MODE_READ)
     {
@@ -257,7 +277,7 @@ int Wrap_File::Lines(lua_State* L)
             return luaL_error(L, "Could not open file.");
     }
 
-    lua_pushcclosure(L, Wrap_File::Lines_I, 5);
+    Wrap_File::PushLinesIterator(L, 1, seekBack, slices);
 
     return 1;
 }
@@ -0,0 +1,94 @@
+#include <objects/filerequest/filerequest.hpp>
+
+#include <chrono>
+
+using namespace love;
+
+Type FileRequest::type("FileRequest", &Object::type);
+
+FileRequest::FileRequest(Operation operation, const std::string& filename, int priority,
+                         uint64_t sequence) :
+    operation(operation),
+    filename(filename),
+    sequence(sequence),
+    priority(priority),
+    status(STATUS_PENDING)
+{}
+
+FileRequest::FileRequest(Operation operation, const std::string& filename, const void* contents,
+                         size_t size, int priority, uint64_t sequence) :
+    FileRequest(operation, filename, priority, sequence)
+{
+    const auto* bytes = (const uint8_t*)contents;
+    this->contents.assign(bytes, bytes + size);
+}
+
+FileRequest::~FileRequest()
+{}
+
+bool FileRequest::IsComplete() const
+{
+    const Status status = this->status;
+    return status != STATUS_PENDING && status != STATUS_RUNNING;
+}
+
+bool FileRequest::Begin()
+{
+    Status expected = STATUS_PENDING;
+    return this->status.compare_exchange_strong(expected, STATUS_RUNNING);
+}
+
+bool FileRequest::Cancel()
+{
+    Status expected = STATUS_PENDING;
+
+    if (!this->status.compare_exchange_strong(expected, STATUS_CANCELLED))
+        return false;
+
+    std::unique_lock lock(this->mutex);
+    this->condition.notify_all();
+
+    return true;
+}
+
+void FileRequest::Complete(Status status)
+{
+    std::unique_lock lock(this->mutex);
+
+    this->status = status;
+    this->condition.notify_all();
+}
+
+void FileRequest::Finish(FileData* data)
+{
+    this->data.Set(data);
+    this->Complete(STATUS_DONE);
+}
+
+void FileRequest::Fail(const std::string& error)
+{
+    this->error = error;
+    this->Complete(STATUS_FAILED);
+}
+
+bool FileRequest::Wait(double timeout)
+{
+    std::unique_lock lock(this->mutex);
+    const auto complete = [this]() { return this->IsComplete(); };
+
+    if (timeout < 0)
+    {
+        this->condition.wait(lock, complete);
+        return true;
+    }
+
+    return this->condition.wait_for(lock, std::chrono::duration<double>(timeout), complete);
+}
+
+FileData* FileRequest::GetData() const
+{
+    if (this->status != STATUS_DONE)
+        return nullptr;
+
+    return this->data.Get();
+}
@@ -0,0 +1,154 @@
+#include <objects/filerequest/wrap_filerequest.hpp>
+
+#include <modules/data/data.hpp>
+#include <modules/data/wrap_data.hpp>
+
+using namespace love;
+
+FileRequest* Wrap_FileRequest::CheckFileRequest(lua_State* L, int index)
+{
+    return luax::CheckType<FileRequest>(L, index);
+}
+
+int Wrap_FileRequest::Cancel(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+
+    luax::PushBoolean(L, self->Cancel());
+
+    return 1;
+}
+
+int Wrap_FileRequest::GetData(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+    auto type  = DataModule::CONTAINER_DATA;
+
+    if (!lua_isnoneornil(L, 2))
+        type = Wrap_DataModule::CheckContainerType(L, 2);
+
+    FileData* data = self->GetData();
+
+    if (data == nullptr)
+    {
+        lua_pushnil(L);
+        return 1;
+    }
+
+    if (type == DataModule::CONTAINER_DATA)
+        luax::PushType(L, data);
+    else
+        lua_pushlstring(L, (const char*)data->GetData(), data->GetSize());
+
+    lua_pushinteger(L, data->GetSize());
+
+    return 2;
+}
+
+int Wrap_FileRequest::GetError(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+
+    if (self->GetStatus() != FileRequest::STATUS_FAILED)
+        lua_pushnil(L);
+    else
+        luax::PushString(L, self->GetError());
+
+    return 1;
+}
+
+int Wrap_FileRequest::GetFilename(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+
+    luax::PushString(L, self->GetFilename());
+
+    return 1;
+}
+
+int Wrap_FileRequest::GetOperation(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+
+    std::optional<const char*> operation;
+
+    if (!(operation = FileRequest::operations.ReverseFind(self->GetOperation())))
+        return luaL_error(L, "Unknown file request operation.");
+
+    lua_pushstring(L, *operation);
+
+    return 1;
+}
+
+int Wrap_FileRequest::GetPriority(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+
+    lua_pushinteger(L, self->GetPriority());
+
+    return 1;
+}
+
+int Wrap_FileRequest::SetPriority(lua_State* L)
+{
+    auto* self   = Wrap_FileRequest::CheckFileRequest(L, 1);
+    int priority = luaL_checkinteger(L, 2);
+
+    self->SetPriority(priority);
+
+    return 0;
+}
+
+int Wrap_FileRequest::GetStatus(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+
+    std::optional<const char*> status;
+
+    if (!(status = FileRequest::statuses.ReverseFind(self->GetStatus())))
+        return luaL_error(L, "Unknown file request status.");
+
+    lua_pushstring(L, *status);
+
+    return 1;
+}
+
+int Wrap_FileRequest::IsComplete(lua_State* L)
+{
+    auto* self = Wrap_FileRequest::CheckFileRequest(L, 1);
+
+    luax::PushBoolean(L, self->IsComplete());
+
+    return 1;
+}
+
+int Wrap_FileRequest::Wait(lua_State* L)
+{
+    auto* self     = Wrap_FileRequest::CheckFileRequest(L, 1);
+    double timeout = luaL_optnumber(L, 2, -1.0);
+
+    luax::PushBoolean(L, self->Wait(timeout));
+
+    return 1;
+}
+
+// clang-format off
+static constexpr luaL_Reg functions[] =
+{
+    { "cancel",       Wrap_FileRequest::Cancel       },
+    { "getData",      Wrap_FileRequest::GetData      },
+    { "getError",     Wrap_FileRequest::GetError     },
+    { "getFilename",  Wrap_FileRequest::GetFilename  },
+    { "getOperation", Wrap_FileRequest::GetOperation },
+    { "getPriority",  Wrap_FileRequest::GetPriority  },
+    { "getStatus",    Wrap_FileRequest::GetStatus    },
+    { "isComplete",   Wrap_FileRequest::IsComplete   },
+    { "setPriority",  Wrap_FileRequest::SetPriority  },
+    { "wait",         Wrap_FileRequest::Wait         }
+};
+// clang-format on
+
+int Wrap_FileRequest::Register(lua_State* L)
+{
+    return luax::RegisterType(L, &FileRequest::type, functions);
+}
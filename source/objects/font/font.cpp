@@ -154,6 +154,7 @@ void Font::CreateTexture()
     /* create the new texture */
     texture = graphics->NewTexture(settings, nullptr);
     texture->SetSamplerState(this->samplerState);
+    texture->SetMemoryCategory(MemoryStats::CATEGORY_FONT);
 
     {
         /* replace the pixels in the Texture accordingly */
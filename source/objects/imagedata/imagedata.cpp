@@ -3,12 +3,14 @@
 #include <modules/filesystem/physfs/filesystem.hpp>
 #include <modules/image/imagemodule.hpp>
 
+#include <objects/compressedimagedata/compressedimagedata.hpp>
+#include <utilities/blockcompressor.hpp>
+
 using namespace love;
 
 template<>
 void ImageData<Console::ALL>::Decode(Data* data)
 {
-    FormatHandler* decoder = nullptr;
     FormatHandler::DecodedImage image {};
 
     auto module = Module::GetInstance<ImageModule>(Module::M_IMAGE);
@@ -16,35 +18,43 @@ void ImageData<Console::ALL>::Decode(Data* data)
     if (module == nullptr)
         throw love::Exception("love.image must be loaded in order to decode an ImageData.");
 
-    for (auto* handler : module->GetFormatHandlers())
+    FormatHandler* decoder = FormatHandler::Find(module->GetFormatHandlers(), data, false);
+    auto* fileData         = dynamic_cast<FileData*>(data);
+
+    const auto decodeError = [&](const char* reason) {
+        if (fileData == nullptr)
+            return love::Exception("Could not decode data to ImageData: %s", reason);
+
+        const auto& filename = fileData->GetFilename();
+        return love::Exception("Could not decode file '%s' to ImageData: %s", filename.c_str(),
+                               reason);
+    };
+
+    if (decoder == nullptr)
     {
-        if (handler->CanDecode(data))
-        {
-            decoder = handler;
-            break;
-        }
+        const auto signature = FormatHandler::Sniff(data);
+        const char* name     = FormatHandler::GetSignatureName(signature);
+
+        std::string reason = "unsupported file format";
+        if (signature != FormatHandler::SIGNATURE_UNKNOWN)
+            reason = std::string(name) + " images cannot be decoded to ImageData on this system";
+
+        throw decodeError(reason.c_str());
     }
 
-    if (decoder)
+    /* handlers are picked by signature alone, so corrupt data is reported by the decoder */
+    try
+    {
         image = decoder->Decode(data);
-
-    if (image.data == nullptr)
+    }
+    catch (love::Exception& e)
     {
-        auto* fileData = (FileData*)data;
-
-        if (fileData != nullptr)
-        {
-            const auto& name = fileData->GetFilename();
-            throw love::Exception(
-                "Could not decode file '%s' to ImageData: unsupported file format", name.c_str());
-        }
-        else
-        {
-            throw love::Exception("Could not decode data to ImageData: unsupported "
-                                  "encoded format");
-        }
+        throw decodeError(e.what());
     }
 
+    if (image.data == nullptr)
+        throw decodeError("the image data is corrupt");
+
     const auto sliceSize =
         love::GetPixelFormatSliceSize(image.format, image.width, image.height, false);
 
@@ -64,80 +74,193 @@ void ImageData<Console::ALL>::Decode(Data* data)
 
 template<>
 FileData* ImageData<Console::ALL>::Encode(FormatHandler::EncodedFormat encodedFormat,
-                                          const char* filename, bool writeFile) const
+                                          const char* filename, bool writeFile,
+                                          const FormatHandler::EncodeSettings& settings) const
 {
     FormatHandler* encoder = nullptr;
     FormatHandler::EncodedImage image {};
     FormatHandler::DecodedImage rawImage {};
 
-    rawImage.width  = width;
-    rawImage.height = height;
-    rawImage.size   = this->GetSize();
-
-    rawImage.data = std::make_unique<uint8_t[]>(rawImage.size);
-    std::memcpy(rawImage.data.get(), this->data.get(), rawImage.size);
-
-    rawImage.format = this->format;
-
     auto module = Module::GetInstance<ImageModule>(Module::M_IMAGE);
     if (module == nullptr)
         throw love::Exception("love.image must be loaded in order to encode an ImageData.");
 
-    for (auto* handler : module->GetFormatHandlers())
-    {
-        if (handler->CanEncode(this->format, encodedFormat))
+    const auto findEncoder = [&](PixelFormat format) -> FormatHandler* {
+        for (auto* handler : module->GetFormatHandlers())
         {
-            encoder = handler;
-            break;
+            if (handler->CanEncode(format, encodedFormat))
+                return handler;
         }
-    }
 
-    if (encoder)
+        return nullptr;
+    };
+
+    rawImage.width  = width;
+    rawImage.height = height;
+    rawImage.format = this->format;
+
+    /* formats the encoders can't take directly are converted to RGBA8 first */
+    if (!(encoder = findEncoder(this->format)) &&
+        PixelConverter::GetRowFunction(this->format, PIXELFORMAT_RGBA8_UNORM) != nullptr)
     {
-        std::unique_lock lock(this->mutex);
-        image = encoder->Encode(rawImage, encodedFormat);
+        encoder         = findEncoder(PIXELFORMAT_RGBA8_UNORM);
+        rawImage.format = PIXELFORMAT_RGBA8_UNORM;
     }
 
-    if (encoder == nullptr || image.data == nullptr)
+    if (encoder == nullptr)
     {
         const char* formatName = love::GetPixelFormatName(this->format);
         throw love::Exception("No suitable image encoder for the %s format.", formatName);
     }
 
-    FileData* fileData = nullptr;
+    const size_t sourcePitch = width * this->GetPixelSize();
+    const size_t pitch       = width * love::GetPixelFormatBlockSize(rawImage.format);
 
-    try
-    {
-        fileData = new FileData(image.size, filename);
-    }
-    catch (love::Exception&)
+    rawImage.size = pitch * height;
+
+    /* borrowed pixels stay locked for the whole encode, so no write lands halfway through */
+    std::unique_lock lock(this->mutex, std::defer_lock);
+
+    if (rawImage.format == this->format)
+        rawImage.view = this->data.get();
+    else
     {
-        throw;
+        std::unique_lock convertLock(this->mutex);
+
+        rawImage.data = std::make_unique<uint8_t[]>(rawImage.size);
+        PixelConverter::Convert(this->format, this->data.get(), sourcePitch, rawImage.format,
+                                rawImage.data.get(), pitch, width, height);
     }
 
-    std::memcpy(fileData->GetData(), image.data.get(), image.size);
+    Filesystem* filesystem = nullptr;
+    StrongReference<File> file;
 
     if (writeFile)
     {
-        auto filesystem = Module::GetInstance<Filesystem>(Module::M_FILESYSTEM);
+        filesystem = Module::GetInstance<Filesystem>(Module::M_FILESYSTEM);
 
         if (filesystem == nullptr)
         {
-            fileData->Release();
             throw love::Exception(
                 "love.filesystem must be loaded in order to encode an ImageData.");
         }
 
-        try
+        file.Set(filesystem->OpenFile(filename, File::MODE_WRITE), Acquire::NORETAIN);
+    }
+
+    const auto write = [&](const uint8_t* bytes, size_t size) {
+        if (file.Get() != nullptr && !file->Write(bytes, (int64_t)size))
+            throw love::Exception("Data could not be written.");
+    };
+
+    try
+    {
+        /* the file is written while the rest of the image is still being compressed */
+        image.Reserve(rawImage.size / 4);
+
+        const auto target = [&](const uint8_t* bytes, size_t size) {
+            image.Append(bytes, size);
+            write(bytes, size);
+        };
+
+        if (rawImage.view != nullptr)
+            lock.lock();
+
+        if (!encoder->EncodeInto(rawImage, encodedFormat, settings, target))
         {
-            filesystem->Write(filename, fileData->GetData(), fileData->GetSize());
+            image = encoder->Encode(rawImage, encodedFormat, settings);
+            write(image.data.get(), image.size);
         }
-        catch (love::Exception&)
+
+        if (lock.owns_lock())
+            lock.unlock();
+
+        if (file.Get() != nullptr && !file->Close())
+            throw love::Exception("Data could not be written.");
+    }
+    catch (...)
+    {
+        /* don't leave a truncated image behind */
+        if (file.Get() != nullptr)
         {
-            fileData->Release();
-            throw;
+            file->Close();
+            filesystem->Remove(filename);
         }
+
+        throw;
     }
 
-    return fileData;
+    /* the FileData takes over the encoded bytes instead of copying them */
+    const size_t size = image.size;
+    StrongReference<ByteData> bytes(new ByteData(image.data.release(), size, true),
+                                    Acquire::NORETAIN);
+
+    return new FileData(bytes, 0, size, filename);
+}
+
+template<>
+CompressedImageData* ImageData<Console::ALL>::Compress(PixelFormat compressedFormat) const
+{
+    if (!BlockCompressor::IsSupported(compressedFormat))
+    {
+        const char* formatName = love::GetPixelFormatName(compressedFormat);
+        throw love::Exception("ImageData cannot be compressed to the %s format.", formatName);
+    }
+
+    const auto convertRow = PixelConverter::GetRowFunction(this->format, PIXELFORMAT_RGBA8_UNORM);
+
+    if (this->format != PIXELFORMAT_RGBA8_UNORM && convertRow == nullptr)
+    {
+        const char* formatName = love::GetPixelFormatName(this->format);
+        throw love::Exception("ImageData:compress does not support the %s pixel format",
+                              formatName);
+    }
+
+    const size_t pixelSize = this->GetPixelSize();
+    const size_t pitch     = this->width * love::GetPixelFormatBlockSize(PIXELFORMAT_RGBA8_UNORM);
+
+    const size_t size =
+        love::GetPixelFormatSliceSize(compressedFormat, this->width, this->height, false);
+
+    StrongReference<ByteData> memory(new ByteData(size, false), Acquire::NORETAIN);
+
+    /* the encoder wants linear RGBA8 rows, which also lets it run without the lock */
+    auto pixels = std::make_unique<uint8_t[]>(pitch * this->height);
+    auto row    = std::make_unique<uint8_t[]>(this->width * pixelSize);
+
+    std::unique_lock lock(this->mutex);
+
+    for (int y = 0; y < this->height; y++)
+    {
+        const uint8_t* source = this->GetPixelAddress(0, y);
+
+        /* tiled rows aren't contiguous, and RGBA8 pixels are stored as packed ABGR */
+        if (Console::Is(Console::CTR))
+        {
+            for (int x = 0; x < this->width; x++)
+            {
+                uint8_t* pixel = row.get() + x * pixelSize;
+                std::memcpy(pixel, this->GetPixelAddress(x, y), pixelSize);
+
+                if (this->format == PIXELFORMAT_RGBA8_UNORM)
+                    std::reverse(pixel, pixel + pixelSize);
+            }
+
+            source = row.get();
+        }
+
+        uint8_t* destination = pixels.get() + y * pitch;
+
+        if (this->format == PIXELFORMAT_RGBA8_UNORM)
+            std::memcpy(destination, source, pitch);
+        else
+            convertRow(source, destination, this->width);
+    }
+
+    lock.unlock();
+
+    BlockCompressor::Compress(compressedFormat, pixels.get(), this->width, this->height, pitch,
+                              (uint8_t*)memory->GetData());
+
+    return new CompressedImageData(compressedFormat, this->width, this->height, memory);
 }
@@ -1,5 +1,6 @@
 #include <objects/imagedata/wrap_imagedata.hpp>
 
+#include <objects/compressedimagedata/compressedimagedata.hpp>
 #include <objects/data/wrap_data.hpp>
 
 using namespace love;
@@ -168,8 +169,20 @@ int Wrap_ImageData::Encode(lua_State* L)
         filename    = luax::CheckString(L, 3);
     }
 
+    FormatHandler::EncodeSettings settings {};
+
+    if (lua_istable(L, 4))
+    {
+        settings.compressionLevel = luax::IntFlag(L, 4, "level", settings.compressionLevel);
+        settings.fastFilters      = luax::BoolFlag(L, 4, "fast", settings.fastFilters);
+    }
+    else if (!lua_isnoneornil(L, 4))
+        return luaL_argerror(L, 4, "expected table");
+
     FileData* data = nullptr;
-    luax::CatchException(L, [&]() { data = self->Encode(*format, filename.c_str(), hasFilename); });
+    luax::CatchException(L, [&]() {
+        data = self->Encode(*format, filename.c_str(), hasFilename, settings);
+    });
 
     luax::PushType(L, data);
     data->Release();
@@ -177,6 +190,190 @@ int Wrap_ImageData::Encode(lua_State* L)
     return 1;
 }
 
+int Wrap_ImageData::Compress(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+
+    std::optional<PixelFormat> format;
+    const char* formatName = luaL_checkstring(L, 2);
+
+    if (!(format = pixelFormats.Find(formatName)))
+        return luax::EnumError(L, "pixel format", pixelFormats, formatName);
+
+    CompressedImageData* data = nullptr;
+    luax::CatchException(L, [&]() { data = self->Compress(*format); });
+
+    luax::PushType(L, data);
+    data->Release();
+
+    return 1;
+}
+
+static Rect checkRegion(lua_State* L, int index, ::ImageData* self)
+{
+    Rect rect {};
+
+    rect.x = luaL_optinteger(L, index + 0, 0);
+    rect.y = luaL_optinteger(L, index + 1, 0);
+    rect.w = luaL_optinteger(L, index + 2, self->GetWidth() - rect.x);
+    rect.h = luaL_optinteger(L, index + 3, self->GetHeight() - rect.y);
+
+    return rect;
+}
+
+int Wrap_ImageData::Fill(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+
+    Color color {};
+    color.r = luaL_checknumber(L, 2);
+    color.g = luaL_checknumber(L, 3);
+    color.b = luaL_checknumber(L, 4);
+    color.a = luaL_optnumber(L, 5, 1.0f);
+
+    Rect rect = checkRegion(L, 6, self);
+    luax::CatchException(L, [&]() { self->Fill(color, rect); });
+
+    return 0;
+}
+
+int Wrap_ImageData::PremultiplyAlpha(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+    Rect rect  = checkRegion(L, 2, self);
+
+    luax::CatchException(L, [&]() { self->PremultiplyAlpha(rect); });
+
+    return 0;
+}
+
+int Wrap_ImageData::UnpremultiplyAlpha(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+    Rect rect  = checkRegion(L, 2, self);
+
+    luax::CatchException(L, [&]() { self->UnpremultiplyAlpha(rect); });
+
+    return 0;
+}
+
+int Wrap_ImageData::TransformColor(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    std::array<float, 16> matrix {};
+
+    for (int index = 0; index < 16; index++)
+    {
+        lua_rawgeti(L, 2, index + 1);
+        matrix[index] = luaL_checknumber(L, -1);
+        lua_pop(L, 1);
+    }
+
+    Rect rect = checkRegion(L, 3, self);
+    luax::CatchException(L, [&]() { self->TransformColor(matrix, rect); });
+
+    return 0;
+}
+
+int Wrap_ImageData::Swizzle(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+
+    size_t length      = 0;
+    const char* string = luaL_checklstring(L, 2, &length);
+
+    static constexpr std::string_view channels = "rgba";
+    std::array<int, 4> order {};
+
+    if (length != order.size())
+        return luaL_error(L, "Invalid channel order '%s', expected four of 'rgba'.", string);
+
+    for (size_t index = 0; index < order.size(); index++)
+    {
+        const auto position = channels.find(string[index]);
+
+        if (position == std::string_view::npos)
+            return luaL_error(L, "Invalid channel order '%s', expected four of 'rgba'.", string);
+
+        order[index] = (int)position;
+    }
+
+    Rect rect = checkRegion(L, 3, self);
+    luax::CatchException(L, [&]() { self->SwizzleChannels(order, rect); });
+
+    return 0;
+}
+
+int Wrap_ImageData::Flip(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+
+    bool horizontal = luax::OptBoolean(L, 2, true);
+    bool vertical   = luax::OptBoolean(L, 3, false);
+
+    Rect rect = checkRegion(L, 4, self);
+    luax::CatchException(L, [&]() { self->Flip(horizontal, vertical, rect); });
+
+    return 0;
+}
+
+int Wrap_ImageData::Rotate(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+    int angle  = luaL_checkinteger(L, 2);
+
+    if (angle % 90 != 0)
+        return luaL_error(L, "Invalid rotation %d, expected a multiple of 90 degrees.", angle);
+
+    const int turns     = ((angle / 90) % 4 + 4) % 4;
+    const bool sideways = turns % 2 != 0;
+
+    const int width  = sideways ? self->GetHeight() : self->GetWidth();
+    const int height = sideways ? self->GetWidth() : self->GetHeight();
+
+    StrongReference<::ImageData> rotated;
+
+    luax::CatchException(L, [&]() {
+        rotated.Set(new ::ImageData(width, height, self->GetFormat()), Acquire::NORETAIN);
+        self->Rotate(turns, rotated);
+    });
+
+    luax::PushType(L, rotated);
+
+    return 1;
+}
+
+int Wrap_ImageData::Downscale(lua_State* L)
+{
+    auto* self = Wrap_ImageData::CheckImageData(L, 1);
+    int factor = luaL_checkinteger(L, 2);
+
+    const char* filterName = luaL_optstring(L, 3, "box");
+    std::optional<::ImageData::DownscaleFilter> filter;
+
+    if (!(filter = ::ImageData::downscaleFilters.Find(filterName)))
+        return luax::EnumError(L, "downscale filter", ::ImageData::downscaleFilters, filterName);
+
+    if (factor < 1)
+        return luaL_error(L, "Invalid downscale factor %d, expected at least 1.", factor);
+
+    const int width  = std::max(self->GetWidth() / factor, 1);
+    const int height = std::max(self->GetHeight() / factor, 1);
+
+    StrongReference<::ImageData> downscaled;
+
+    luax::CatchException(L, [&]() {
+        downscaled.Set(new ::ImageData(width, height, self->GetFormat()), Acquire::NORETAIN);
+        self->Downscale(factor, *filter, downscaled);
+    });
+
+    luax::PushType(L, downscaled);
+
+    return 1;
+}
+
 // To do
 int Wrap_ImageData::__PerformAtomic(lua_State* L)
 {
@@ -197,15 +394,24 @@ int Wrap_ImageData::__PerformAtomic(lua_State* L)
 // clang-format off
 static constexpr luaL_Reg functions[] =
 {
-    { "clone",         Wrap_ImageData::Clone         },
-    { "getFormat",     Wrap_ImageData::GetFormat     },
-    { "getWidth",      Wrap_ImageData::GetWidth      },
-    { "getHeight",     Wrap_ImageData::GetHeight     },
-    { "getDimensions", Wrap_ImageData::GetDimensions },
-    { "getPixel",      Wrap_ImageData::GetPixel      },
-    { "setPixel",      Wrap_ImageData::SetPixel      },
-    { "paste",         Wrap_ImageData::Paste         },
-    { "encode",        Wrap_ImageData::Encode        },
+    { "clone",              Wrap_ImageData::Clone              },
+    { "getFormat",          Wrap_ImageData::GetFormat          },
+    { "getWidth",           Wrap_ImageData::GetWidth           },
+    { "getHeight",          Wrap_ImageData::GetHeight          },
+    { "getDimensions",      Wrap_ImageData::GetDimensions      },
+    { "getPixel",           Wrap_ImageData::GetPixel           },
+    { "setPixel",           Wrap_ImageData::SetPixel           },
+    { "paste",              Wrap_ImageData::Paste              },
+    { "encode",             Wrap_ImageData::Encode             },
+    { "compress",           Wrap_ImageData::Compress           },
+    { "fill",               Wrap_ImageData::Fill               },
+    { "premultiplyAlpha",   Wrap_ImageData::PremultiplyAlpha   },
+    { "unpremultiplyAlpha", Wrap_ImageData::UnpremultiplyAlpha },
+    { "transformColor",     Wrap_ImageData::TransformColor     },
+    { "swizzle",            Wrap_ImageData::Swizzle            },
+    { "flip",               Wrap_ImageData::Flip               },
+    { "rotate",             Wrap_ImageData::Rotate             },
+    { "downscale",          Wrap_ImageData::Downscale          },
     /* spacing */
     { "_performAtomic",  Wrap_ImageData::__PerformAtomic  }
 };
@@ -0,0 +1,154 @@
+#include <objects/savewriter/savewriter.hpp>
+
+#include <common/exception.hpp>
+
+#include <modules/filesystem/filesystem.hpp>
+
+using namespace love;
+
+Type SaveWriter::type("SaveWriter", &Object::type);
+
+SaveWriter::SaveWriter(Filesystem* filesystem, const std::string& filename,
+                       const Settings& settings) :
+    filesystem(filesystem),
+    filename(filename),
+    settings(settings),
+    buffer(),
+    bufferedSince(),
+    dirty(false),
+    flushRequested(false),
+    closed(false),
+    written(0),
+    flushes(0),
+    commits(0)
+{
+    if (settings.mode == MODE_APPEND)
+    {
+        if (settings.blockSize == 0)
+            throw love::Exception("Save writer block size must be greater than zero.");
+
+        if (settings.bufferSize < settings.blockSize)
+            throw love::Exception("Save writer buffer size must be at least its block size.");
+    }
+}
+
+SaveWriter::~SaveWriter()
+{}
+
+bool SaveWriter::Write(const void* data, size_t size)
+{
+    std::unique_lock lock(this->mutex);
+
+    if (this->buffer.empty())
+        this->bufferedSince = Clock::now();
+
+    const auto* bytes = (const uint8_t*)data;
+    this->buffer.insert(this->buffer.end(), bytes, bytes + size);
+
+    this->dirty = true;
+
+    return this->settings.mode == MODE_APPEND && this->buffer.size() >= this->settings.bufferSize;
+}
+
+void SaveWriter::RequestFlush()
+{
+    std::unique_lock lock(this->mutex);
+    this->flushRequested = true;
+}
+
+size_t SaveWriter::GetDueSize(bool force) const
+{
+    if (this->settings.mode == MODE_ATOMIC)
+        return (force && this->dirty) ? this->buffer.size() : 0;
+
+    if (this->buffer.empty())
+        return 0;
+
+    const auto age     = std::chrono::duration<double>(Clock::now() - this->bufferedSince);
+    const bool expired = this->settings.interval > 0 && age.count() >= this->settings.interval;
+
+    if (force || expired)
+        return this->buffer.size();
+
+    if (this->buffer.size() < this->settings.bufferSize)
+        return 0;
+
+    return this->buffer.size() - this->buffer.size() % this->settings.blockSize;
+}
+
+void SaveWriter::Poll(bool force)
+{
+    std::unique_lock io(this->ioMutex);
+    std::vector<uint8_t> data;
+
+    {
+        std::unique_lock lock(this->mutex);
+
+        force                = force || this->flushRequested;
+        this->flushRequested = false;
+
+        const size_t size = this->GetDueSize(force);
+
+        /* an atomic commit of nothing still empties the file */
+        const bool commit = this->settings.mode == MODE_ATOMIC && this->dirty && force;
+
+        if (size == 0 && !commit)
+            return;
+
+        if (size == this->buffer.size())
+            data.swap(this->buffer);
+        else
+        {
+            data.assign(this->buffer.begin(), this->buffer.begin() + size);
+            this->buffer.erase(this->buffer.begin(), this->buffer.begin() + size);
+        }
+
+        this->dirty         = !this->buffer.empty();
+        this->bufferedSince = Clock::now();
+    }
+
+    try
+    {
+        if (this->settings.mode == MODE_ATOMIC)
+        {
+            this->filesystem->Replace(this->filename.c_str(), data.data(), data.size());
+            this->commits++;
+        }
+        else
+            this->filesystem->Append(this->filename.c_str(), data.data(), data.size());
+
+        this->flushes++;
+        this->written += data.size();
+    }
+    catch (love::Exception& e)
+    {
+        std::unique_lock lock(this->mutex);
+
+        this->error = e.what();
+
+        /* try again later, ahead of anything written since, so no promised byte is lost */
+        this->buffer.insert(this->buffer.begin(), data.begin(), data.end());
+
+        this->dirty = true;
+    }
+}
+
+SaveWriter::Stats SaveWriter::GetStats() const
+{
+    std::unique_lock lock(this->mutex);
+
+    Stats stats {};
+
+    stats.buffered = this->buffer.size();
+    stats.written  = this->written;
+    stats.flushes  = this->flushes;
+    stats.commits  = this->commits;
+
+    return stats;
+}
+
+std::string SaveWriter::GetError() const
+{
+    std::unique_lock lock(this->mutex);
+    return this->error;
+}
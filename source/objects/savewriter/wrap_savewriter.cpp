@@ -0,0 +1,163 @@
+#include <objects/savewriter/wrap_savewriter.hpp>
+
+#include <common/data.hpp>
+
+#include <modules/filesystem/filesystem.hpp>
+
+using namespace love;
+
+#define instance() (Module::GetInstance<Filesystem>(Module::M_FILESYSTEM))
+
+SaveWriter* Wrap_SaveWriter::CheckSaveWriter(lua_State* L, int index)
+{
+    return luax::CheckType<SaveWriter>(L, index);
+}
+
+int Wrap_SaveWriter::Close(lua_State* L)
+{
+    auto* self = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+
+    luax::CatchException(L, [&]() { instance()->CloseSaveWriter(self); });
+
+    const auto error = self->GetError();
+
+    if (!error.empty())
+        return luax::IOError(L, "%s", error.c_str());
+
+    luax::PushBoolean(L, true);
+
+    return 1;
+}
+
+int Wrap_SaveWriter::Flush(lua_State* L)
+{
+    auto* self = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+
+    if (self->IsClosed())
+        return luaL_error(L, "Cannot flush a closed SaveWriter.");
+
+    self->RequestFlush();
+
+    luax::CatchException(L, [&]() { instance()->PollSaveWriters(); });
+
+    return 0;
+}
+
+int Wrap_SaveWriter::GetError(lua_State* L)
+{
+    auto* self       = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+    const auto error = self->GetError();
+
+    if (error.empty())
+        lua_pushnil(L);
+    else
+        luax::PushString(L, error);
+
+    return 1;
+}
+
+int Wrap_SaveWriter::GetFilename(lua_State* L)
+{
+    auto* self = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+
+    luax::PushString(L, self->GetFilename());
+
+    return 1;
+}
+
+int Wrap_SaveWriter::GetMode(lua_State* L)
+{
+    auto* self = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+
+    std::optional<const char*> mode;
+
+    if (!(mode = SaveWriter::modes.ReverseFind(self->GetMode())))
+        return luaL_error(L, "Unknown save writer mode.");
+
+    lua_pushstring(L, *mode);
+
+    return 1;
+}
+
+int Wrap_SaveWriter::GetStats(lua_State* L)
+{
+    auto* self       = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+    const auto stats = self->GetStats();
+
+    if (lua_istable(L, 2))
+        lua_pushvalue(L, 2);
+    else
+        lua_createtable(L, 0, 4);
+
+    lua_pushinteger(L, stats.buffered);
+    lua_setfield(L, -2, "buffered");
+
+    lua_pushinteger(L, stats.written);
+    lua_setfield(L, -2, "written");
+
+    lua_pushinteger(L, stats.flushes);
+    lua_setfield(L, -2, "flushes");
+
+    lua_pushinteger(L, stats.commits);
+    lua_setfield(L, -2, "commits");
+
+    return 1;
+}
+
+int Wrap_SaveWriter::IsClosed(lua_State* L)
+{
+    auto* self = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+
+    luax::PushBoolean(L, self->IsClosed());
+
+    return 1;
+}
+
+int Wrap_SaveWriter::Write(lua_State* L)
+{
+    auto* self = Wrap_SaveWriter::CheckSaveWriter(L, 1);
+
+    if (self->IsClosed())
+        return luaL_error(L, "Cannot write to a closed SaveWriter.");
+
+    const char* input = nullptr;
+    size_t length     = 0;
+
+    if (luax::IsType(L, 2, Data::type))
+    {
+        Data* data = luax::ToType<Data>(L, 2);
+
+        input  = (const char*)data->GetData();
+        length = data->GetSize();
+    }
+    else if (lua_isstring(L, 2))
+        input = lua_tolstring(L, 2, &length);
+    else
+        return luaL_argerror(L, 2, "string or Data expected");
+
+    luax::CatchException(L, [&]() {
+        if (self->Write(input, length))
+            instance()->PollSaveWriters();
+    });
+
+    return 0;
+}
+
+// clang-format off
+static constexpr luaL_Reg functions[] =
+{
+    { "close",       Wrap_SaveWriter::Close       },
+    { "flush",       Wrap_SaveWriter::Flush       },
+    { "getError",    Wrap_SaveWriter::GetError    },
+    { "getFilename", Wrap_SaveWriter::GetFilename },
+    { "getMode",     Wrap_SaveWriter::GetMode     },
+    { "getStats",    Wrap_SaveWriter::GetStats    },
+    { "isClosed",    Wrap_SaveWriter::IsClosed    },
+    { "write",       Wrap_SaveWriter::Write       }
+};
+// clang-format on
+
+int Wrap_SaveWriter::Register(lua_State* L)
+{
+    return luax::RegisterType(L, &SaveWriter::type, functions);
+}
@@ -56,17 +56,10 @@ int Wrap_TextBatch::Add(lua_State* L)
     }
     else
     {
-        float x  = luaL_optnumber(L, 3, 0.0);
-        float y  = luaL_optnumber(L, 4, 0.0);
-        float a  = luaL_optnumber(L, 5, 0.0);
-        float sx = luaL_optnumber(L, 6, 1.0);
-        float sy = luaL_optnumber(L, 7, sx);
-        float ox = luaL_optnumber(L, 8, 0.0);
-        float oy = luaL_optnumber(L, 9, 0.0);
-        float kx = luaL_optnumber(L, 10, 0.0);
-        float ky = luaL_optnumber(L, 11, 0.0);
-
-        Matrix4 matrix(x, y, a, sx, sy, ox, oy, kx, ky);
+        const auto args = luax::OptTransform(L, 3);
+
+        Matrix4 matrix(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7],
+                       args[8]);
         luax::CatchException(L, [&]() { index = self->Add(text, matrix); });
     }
 
@@ -100,17 +93,10 @@ int Wrap_TextBatch::Addf(lua_State* L)
     }
     else
     {
-        float x  = luaL_optnumber(L, 5, 0.0);
-        float y  = luaL_optnumber(L, 6, 0.0);
-        float a  = luaL_optnumber(L, 7, 0.0);
-        float sx = luaL_optnumber(L, 8, 1.0);
-        float sy = luaL_optnumber(L, 9, sx);
-        float ox = luaL_optnumber(L, 10, 0.0);
-        float oy = luaL_optnumber(L, 11, 0.0);
-        float kx = luaL_optnumber(L, 12, 0.0);
-        float ky = luaL_optnumber(L, 13, 0.0);
-
-        Matrix4 matrix(x, y, a, sx, sy, ox, oy, kx, ky);
+        const auto args = luax::OptTransform(L, 5);
+
+        Matrix4 matrix(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7],
+                       args[8]);
         luax::CatchException(L, [&]() { index = self->Addf(text, wrap, *align, matrix); });
     }
 
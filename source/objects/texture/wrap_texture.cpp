@@ -407,7 +407,20 @@ int Wrap_Texture::GenerateMipmaps(lua_State* L)
 {
     auto* self = Wrap_Texture::CheckTexture(L, 1);
 
-    luax::CatchException(L, [&]() { self->GenerateMipmaps(); });
+    auto filter = Mipmapper::FILTER_BOX;
+
+    if (!lua_isnoneornil(L, 2))
+    {
+        const char* name = luaL_checkstring(L, 2);
+        std::optional<Mipmapper::Filter> value;
+
+        if (!(value = Mipmapper::filters.Find(name)))
+            return luax::EnumError(L, "mipmap filter", Mipmapper::filters, name);
+
+        filter = *value;
+    }
+
+    luax::CatchException(L, [&]() { self->GenerateMipmaps(filter); });
 
     return 0;
 }
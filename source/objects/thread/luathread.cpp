@@ -3,6 +3,7 @@
 #include <modules/event/event.hpp>
 #include <modules/event/wrap_event.hpp>
 #include <modules/love/love.hpp>
+#include <modules/thread/threadmodule.hpp>
 
 #include <objects/thread/luathread.hpp>
 
@@ -20,7 +21,7 @@ void LuaThread::ThreadFunction()
     this->error.clear();
     this->hasError = false;
 
-    lua_State* L = luaL_newstate();
+    lua_State* L = luax::NewState();
     luaL_openlibs(L);
 
     luax::Preload(L, love::Initialize, "love");
@@ -36,8 +37,7 @@ void LuaThread::ThreadFunction()
     lua_pushcfunction(L, luax::Traceback);
     int tracebackIndex = lua_gettop(L);
 
-    if (luaL_loadbuffer(L, (const char*)this->code->GetData(), this->code->GetSize(),
-                        this->name.c_str()) != 0)
+    if (this->Load(L) != 0)
     {
         this->error    = luax::ToString(L, -1);
         this->hasError = true;
@@ -64,6 +64,37 @@ void LuaThread::ThreadFunction()
         this->OnError();
 }
 
+static int writeBytecode(lua_State*, const void* data, size_t size, void* userdata)
+{
+    ((std::string*)userdata)->append((const char*)data, size);
+    return 0;
+}
+
+int LuaThread::Load(lua_State* L)
+{
+    auto* module = Module::GetInstance<ThreadModule>(Module::M_THREAD);
+
+    if (module == nullptr)
+    {
+        return luaL_loadbuffer(L, (const char*)this->code->GetData(), this->code->GetSize(),
+                               this->name.c_str());
+    }
+
+    /* skip the parser when this code has already been compiled by another thread */
+    if (auto cached = module->GetBytecode(this->name, this->code))
+        return luaL_loadbuffer(L, cached->data(), cached->size(), this->name.c_str());
+
+    int status = luaL_loadbuffer(L, (const char*)this->code->GetData(), this->code->GetSize(),
+                                 this->name.c_str());
+
+    std::string bytecode {};
+
+    if (status == 0 && lua_dump(L, writeBytecode, &bytecode) == 0)
+        module->SetBytecode(this->name, this->code, std::move(bytecode));
+
+    return status;
+}
+
 bool LuaThread::Start(const std::vector<Variant>& args)
 {
     if (this->IsRunning())
@@ -95,6 +126,6 @@ void LuaThread::OnError()
         Variant(this->error.c_str(), this->error.length())
     };
 
-    StrongReference<Message> message(new Message("threaderror", variantArgs), Acquire::NORETAIN);
+    StrongReference<Message> message(new Message("threaderror", std::move(variantArgs)), Acquire::NORETAIN);
     event->Push(message);
 }
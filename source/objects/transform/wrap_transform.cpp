@@ -120,17 +120,10 @@ int Wrap_Transform::SetTransformation(lua_State* L)
 {
     auto* self = Wrap_Transform::CheckTransform(L, 1);
 
-    float x  = luaL_optnumber(L, 2, 0.0);
-    float y  = luaL_optnumber(L, 3, 0.0);
-    float a  = luaL_optnumber(L, 4, 0.0);
-    float sx = luaL_optnumber(L, 5, 1.0);
-    float sy = luaL_optnumber(L, 6, sx);
-    float ox = luaL_optnumber(L, 7, 0.0);
-    float oy = luaL_optnumber(L, 8, 0.0);
-    float kx = luaL_optnumber(L, 9, 0.0);
-    float ky = luaL_optnumber(L, 10, 0.0);
-
-    self->SetTransformation(x, y, a, sx, sy, ox, oy, kx, ky);
+    const auto args = luax::OptTransform(L, 2);
+
+    self->SetTransformation(args[0], args[1], args[2], args[3], args[4], args[5], args[6],
+                            args[7], args[8]);
 
     lua_pushvalue(L, 1);
 
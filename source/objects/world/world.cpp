@@ -4,6 +4,7 @@
 #include <objects/shape/shape.hpp>
 
 #include <modules/physics/physics.hpp>
+#include <modules/profiler/profiler.hpp>
 
 #include <objects/joint/wrap_joint.hpp>
 #include <objects/shape/wrap_shape.hpp>
@@ -338,7 +339,10 @@ void World::Update(float delta)
 
 void World::Update(float delta, int velocityIterations, int positionIterations)
 {
-    this->world->Step(delta, velocityIterations, positionIterations);
+    {
+        Profiler::Zone zone("physics.step");
+        this->world->Step(delta, velocityIterations, positionIterations);
+    }
 
     for (auto* body : this->destructBodies)
     {
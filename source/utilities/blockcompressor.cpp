@@ -0,0 +1,623 @@
+#include <common/exception.hpp>
+
+#include <utilities/blockcompressor.hpp>
+#include <utilities/threads/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using namespace love;
+
+namespace
+{
+    static constexpr int BLOCK_SIZE   = 0x04;
+    static constexpr int BLOCK_PIXELS = BLOCK_SIZE * BLOCK_SIZE;
+
+    /* RGBA8 pixels of one block, row-major (pixel index = y * 4 + x) */
+    using Block = std::array<std::array<uint8_t, 4>, BLOCK_PIXELS>;
+
+    // clang-format off
+    static constexpr int etcModifiers[8][2] =
+    {
+        {  2,   8 }, {  5,  17 }, {  9,  29 }, { 13,  42 },
+        { 18,  60 }, { 24,  80 }, { 33, 106 }, { 47, 183 }
+    };
+
+    static constexpr int eacModifiers[16][8] =
+    {
+        { -3, -6,  -9, -15, 2, 5, 8, 14 },
+        { -3, -7, -10, -13, 2, 6, 9, 12 },
+        { -2, -5,  -8, -13, 1, 4, 7, 12 },
+        { -2, -4,  -6, -13, 1, 3, 5, 12 },
+        { -3, -6,  -8, -12, 2, 5, 7, 11 },
+        { -3, -7,  -9, -11, 2, 6, 8, 10 },
+        { -4, -7,  -8, -11, 3, 6, 7, 10 },
+        { -3, -5,  -8, -11, 2, 4, 7, 10 },
+        { -2, -6,  -8, -10, 1, 5, 7,  9 },
+        { -2, -5,  -8, -10, 1, 4, 7,  9 },
+        { -2, -4,  -8, -10, 1, 3, 7,  9 },
+        { -2, -5,  -7, -10, 1, 4, 6,  9 },
+        { -3, -4,  -7, -10, 2, 3, 6,  9 },
+        { -1, -2,  -3, -10, 0, 1, 2,  9 },
+        { -4, -6,  -8,  -9, 3, 5, 7,  8 },
+        { -3, -5,  -7,  -9, 2, 4, 6,  8 }
+    };
+    // clang-format on
+
+    /* the EAC table with a zero modifier, used for blocks of constant alpha */
+    static constexpr int EAC_CONSTANT_TABLE = 0x0D;
+    static constexpr int EAC_CONSTANT_INDEX = 0x04;
+
+    inline int clampByte(int value)
+    {
+        return std::clamp(value, 0, 0xFF);
+    }
+
+    inline int square(int value)
+    {
+        return value * value;
+    }
+
+    inline void storeBigEndian(uint64_t value, uint8_t* destination)
+    {
+        for (int index = 0; index < 8; index++)
+            destination[index] = (uint8_t)(value >> (56 - index * 8));
+    }
+
+    inline void storeLittleEndian(uint64_t value, uint8_t* destination)
+    {
+        for (int index = 0; index < 8; index++)
+            destination[index] = (uint8_t)(value >> (index * 8));
+    }
+
+    void loadBlock(const uint8_t* source, int width, int height, size_t pitch, int blockX,
+                   int blockY, Block& block)
+    {
+        for (int y = 0; y < BLOCK_SIZE; y++)
+        {
+            const int sourceY  = std::min(blockY * BLOCK_SIZE + y, height - 1);
+            const uint8_t* row = source + sourceY * pitch;
+
+            for (int x = 0; x < BLOCK_SIZE; x++)
+            {
+                const int sourceX = std::min(blockX * BLOCK_SIZE + x, width - 1);
+                std::copy_n(row + sourceX * 4, 4, block[y * BLOCK_SIZE + x].begin());
+            }
+        }
+    }
+
+    /* ETC1 / ETC2 RGB */
+
+    struct EtcFit
+    {
+        int table;
+        uint32_t indices;
+        int error;
+    };
+
+    /* ETC subblocks: 2x4 side by side when @flip is false, 4x2 stacked when it is true */
+    inline bool inSubblock(bool flip, int subblock, int x, int y)
+    {
+        return ((flip ? y : x) < 2) == (subblock == 0);
+    }
+
+    /*
+    ** Finds the best table and per-pixel modifiers for one subblock around @base. A modifier
+    ** moves all three channels by the same amount, so each pixel takes the one closest to
+    ** its mean offset from @base and only that choice is measured.
+    */
+    EtcFit fitSubblock(const Block& block, bool flip, int subblock, const int base[3])
+    {
+        int offsets[BLOCK_PIXELS] {};
+
+        for (int x = 0; x < BLOCK_SIZE; x++)
+        {
+            for (int y = 0; y < BLOCK_SIZE; y++)
+            {
+                const auto& pixel = block[y * BLOCK_SIZE + x];
+                const int sum     = pixel[0] + pixel[1] + pixel[2] - base[0] - base[1] - base[2];
+
+                offsets[x * BLOCK_SIZE + y] = sum;
+            }
+        }
+
+        EtcFit best { 0, 0, std::numeric_limits<int>::max() };
+
+        for (int table = 0; table < 8; table++)
+        {
+            /* thresholds between the modifiers, in units of the three-channel offset sum */
+            const int small = etcModifiers[table][0];
+            const int large = etcModifiers[table][1];
+            const int split = (small + large) * 3 / 2;
+
+            EtcFit fit { table, 0, 0 };
+
+            for (int x = 0; x < BLOCK_SIZE && fit.error < best.error; x++)
+            {
+                for (int y = 0; y < BLOCK_SIZE; y++)
+                {
+                    if (!inSubblock(flip, subblock, x, y))
+                        continue;
+
+                    /* index values: 0 = +small, 1 = +large, 2 = -small, 3 = -large */
+                    const int offset = offsets[x * BLOCK_SIZE + y];
+                    const int index  = offset >= 0 ? (offset > split ? 1 : 0)
+                                                   : (offset < -split ? 3 : 2);
+
+                    const int modifier = (index & 0x01) ? large : small;
+                    const int signed_  = (index & 0x02) ? -modifier : modifier;
+
+                    const auto& pixel = block[y * BLOCK_SIZE + x];
+
+                    for (int c = 0; c < 3; c++)
+                        fit.error += square(clampByte(base[c] + signed_) - pixel[c]);
+
+                    /* index bits are column-major: lsb at bit i, msb at bit 16 + i */
+                    const int bit        = x * BLOCK_SIZE + y;
+                    const uint32_t value = index;
+                    fit.indices |= ((value & 0x01) << bit) | ((value >> 1) << (16 + bit));
+                }
+            }
+
+            if (fit.error < best.error)
+                best = fit;
+
+            if (best.error == 0)
+                break;
+        }
+
+        return best;
+    }
+
+    uint64_t encodeEtc1(const Block& block)
+    {
+        uint64_t bestBits = 0;
+        int bestError     = std::numeric_limits<int>::max();
+
+        for (int flip = 0; flip < 2; flip++)
+        {
+            int average[2][3] {};
+
+            for (int subblock = 0; subblock < 2; subblock++)
+            {
+                int sum[3] {};
+
+                for (int y = 0; y < BLOCK_SIZE; y++)
+                {
+                    for (int x = 0; x < BLOCK_SIZE; x++)
+                    {
+                        if (!inSubblock(flip, subblock, x, y))
+                            continue;
+
+                        for (int c = 0; c < 3; c++)
+                            sum[c] += block[y * BLOCK_SIZE + x][c];
+                    }
+                }
+
+                for (int c = 0; c < 3; c++)
+                    average[subblock][c] = (sum[c] + 4) / 8;
+            }
+
+            const auto tryMode = [&](bool differential) {
+                const int levels = differential ? 31 : 15;
+
+                uint32_t quantized[2][3] {};
+                int base[2][3] {};
+
+                for (int subblock = 0; subblock < 2; subblock++)
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        const uint32_t value   = (average[subblock][c] * levels + 127) / 255;
+                        quantized[subblock][c] = value;
+
+                        base[subblock][c] = differential ? (value << 3) | (value >> 2)
+                                                         : (value << 4) | value;
+                    }
+                }
+
+                if (differential)
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        const int delta = (int)quantized[1][c] - (int)quantized[0][c];
+                        if (delta < -4 || delta > 3)
+                            return;
+                    }
+                }
+
+                const EtcFit first  = fitSubblock(block, flip, 0, base[0]);
+                const EtcFit second = fitSubblock(block, flip, 1, base[1]);
+
+                const int error = first.error + second.error;
+                if (error >= bestError)
+                    return;
+
+                uint32_t high = 0;
+
+                for (int c = 0; c < 3; c++)
+                {
+                    const int shift = 24 - c * 8;
+
+                    if (differential)
+                    {
+                        const uint32_t delta = (quantized[1][c] - quantized[0][c]) & 0x07;
+                        high |= (quantized[0][c] << (shift + 3)) | (delta << shift);
+                    }
+                    else
+                        high |= (quantized[0][c] << (shift + 4)) | (quantized[1][c] << shift);
+                }
+
+                high |= (first.table << 5) | (second.table << 2) | (differential << 1) | flip;
+
+                bestError = error;
+                bestBits  = ((uint64_t)high << 32) | first.indices | second.indices;
+            };
+
+            tryMode(true);
+            tryMode(false);
+        }
+
+        return bestBits;
+    }
+
+    /* ETC2 EAC alpha */
+
+    uint64_t encodeEac(const Block& block)
+    {
+        int minimum = 0xFF;
+        int maximum = 0x00;
+
+        for (const auto& pixel : block)
+        {
+            minimum = std::min<int>(minimum, pixel[3]);
+            maximum = std::max<int>(maximum, pixel[3]);
+        }
+
+        if (minimum == maximum)
+        {
+            uint64_t bits = ((uint64_t)minimum << 56) | (1ull << 52) |
+                            ((uint64_t)EAC_CONSTANT_TABLE << 48);
+
+            for (int index = 0; index < BLOCK_PIXELS; index++)
+                bits |= (uint64_t)EAC_CONSTANT_INDEX << (45 - index * 3);
+
+            return bits;
+        }
+
+        uint64_t bestBits = 0;
+        int bestError     = std::numeric_limits<int>::max();
+
+        for (int table = 0; table < 16; table++)
+        {
+            const int* modifiers = eacModifiers[table];
+            const int span       = modifiers[7] - modifiers[3];
+
+            const int estimate = (maximum - minimum + span / 2) / span;
+
+            for (int multiplier = estimate - 1; multiplier <= estimate + 1; multiplier++)
+            {
+                if (multiplier < 1 || multiplier > 15)
+                    continue;
+
+                const int center = (minimum + maximum) / 2;
+                const int offset = multiplier * (modifiers[7] + modifiers[3]) / 2;
+                const int base   = clampByte(center - offset);
+
+                uint64_t indices = 0;
+                int error        = 0;
+
+                for (int x = 0; x < BLOCK_SIZE && error < bestError; x++)
+                {
+                    for (int y = 0; y < BLOCK_SIZE; y++)
+                    {
+                        const int alpha = block[y * BLOCK_SIZE + x][3];
+
+                        int bestIndex      = 0;
+                        int bestPixelError = std::numeric_limits<int>::max();
+
+                        for (int index = 0; index < 8; index++)
+                        {
+                            const int value = clampByte(base + modifiers[index] * multiplier);
+                            const int delta = square(value - alpha);
+
+                            if (delta < bestPixelError)
+                            {
+                                bestPixelError = delta;
+                                bestIndex      = index;
+                            }
+                        }
+
+                        indices |= (uint64_t)bestIndex << (45 - (x * BLOCK_SIZE + y) * 3);
+                        error += bestPixelError;
+                    }
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestBits  = ((uint64_t)base << 56) | ((uint64_t)multiplier << 52) |
+                               ((uint64_t)table << 48) | indices;
+                }
+            }
+        }
+
+        return bestBits;
+    }
+
+    /* DXT1 / DXT5 */
+
+    inline uint16_t packRGB565(const float color[3])
+    {
+        const int r = (int)std::lround(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f);
+        const int g = (int)std::lround(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f);
+        const int b = (int)std::lround(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f);
+
+        return (uint16_t)((r << 11) | (g << 5) | b);
+    }
+
+    inline void unpackRGB565(uint16_t packed, int color[3])
+    {
+        const int r = (packed >> 11) & 0x1F;
+        const int g = (packed >> 5) & 0x3F;
+        const int b = packed & 0x1F;
+
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    /* endpoints at the extremes of the block along its principal axis */
+    void findEndpoints(const Block& block, float first[3], float second[3])
+    {
+        float mean[3] {};
+
+        for (const auto& pixel : block)
+        {
+            for (int c = 0; c < 3; c++)
+                mean[c] += pixel[c];
+        }
+
+        for (int c = 0; c < 3; c++)
+            mean[c] /= BLOCK_PIXELS;
+
+        float covariance[6] {};
+
+        for (const auto& pixel : block)
+        {
+            const float r = pixel[0] - mean[0];
+            const float g = pixel[1] - mean[1];
+            const float b = pixel[2] - mean[2];
+
+            covariance[0] += r * r;
+            covariance[1] += r * g;
+            covariance[2] += r * b;
+            covariance[3] += g * g;
+            covariance[4] += g * b;
+            covariance[5] += b * b;
+        }
+
+        /* a few power iterations are plenty for a 3x3 matrix */
+        float axis[3] = { 1.0f, 1.0f, 1.0f };
+
+        for (int iteration = 0; iteration < 4; iteration++)
+        {
+            const float x = covariance[0] * axis[0] + covariance[1] * axis[1] +
+                            covariance[2] * axis[2];
+            const float y = covariance[1] * axis[0] + covariance[3] * axis[1] +
+                            covariance[4] * axis[2];
+            const float z = covariance[2] * axis[0] + covariance[4] * axis[1] +
+                            covariance[5] * axis[2];
+
+            const float length = std::max({ std::fabs(x), std::fabs(y), std::fabs(z) });
+
+            if (length <= 0.0f)
+                break;
+
+            axis[0] = x / length;
+            axis[1] = y / length;
+            axis[2] = z / length;
+        }
+
+        float low  = std::numeric_limits<float>::max();
+        float high = std::numeric_limits<float>::lowest();
+
+        for (const auto& pixel : block)
+        {
+            const float projection = (pixel[0] - mean[0]) * axis[0] +
+                                     (pixel[1] - mean[1]) * axis[1] +
+                                     (pixel[2] - mean[2]) * axis[2];
+
+            low  = std::min(low, projection);
+            high = std::max(high, projection);
+        }
+
+        const float lengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+        if (lengthSquared > 0.0f)
+        {
+            low /= lengthSquared;
+            high /= lengthSquared;
+        }
+
+        for (int c = 0; c < 3; c++)
+        {
+            first[c]  = mean[c] + axis[c] * high;
+            second[c] = mean[c] + axis[c] * low;
+        }
+    }
+
+    uint64_t encodeDxtColor(const Block& block)
+    {
+        float first[3], second[3];
+        findEndpoints(block, first, second);
+
+        uint16_t color0 = packRGB565(first);
+        uint16_t color1 = packRGB565(second);
+
+        /* four-color mode needs color0 > color1 */
+        if (color0 < color1)
+            std::swap(color0, color1);
+
+        uint32_t indices = 0;
+
+        if (color0 != color1)
+        {
+            int palette[4][3];
+            unpackRGB565(color0, palette[0]);
+            unpackRGB565(color1, palette[1]);
+
+            for (int c = 0; c < 3; c++)
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+
+            for (int index = 0; index < BLOCK_PIXELS; index++)
+            {
+                const auto& pixel = block[index];
+
+                int bestIndex = 0;
+                int bestError = std::numeric_limits<int>::max();
+
+                for (int entry = 0; entry < 4; entry++)
+                {
+                    const int error = square(palette[entry][0] - pixel[0]) +
+                                      square(palette[entry][1] - pixel[1]) +
+                                      square(palette[entry][2] - pixel[2]);
+
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = entry;
+                    }
+                }
+
+                indices |= (uint32_t)bestIndex << (index * 2);
+            }
+        }
+
+        return color0 | ((uint64_t)color1 << 16) | ((uint64_t)indices << 32);
+    }
+
+    uint64_t encodeDxtAlpha(const Block& block)
+    {
+        int alpha0 = 0x00;
+        int alpha1 = 0xFF;
+
+        for (const auto& pixel : block)
+        {
+            alpha0 = std::max<int>(alpha0, pixel[3]);
+            alpha1 = std::min<int>(alpha1, pixel[3]);
+        }
+
+        uint64_t indices = 0;
+
+        /* with alpha0 > alpha1 the block uses eight interpolated values */
+        if (alpha0 != alpha1)
+        {
+            int palette[8] = { alpha0, alpha1 };
+
+            for (int entry = 2; entry < 8; entry++)
+                palette[entry] = ((8 - entry) * alpha0 + (entry - 1) * alpha1) / 7;
+
+            for (int index = 0; index < BLOCK_PIXELS; index++)
+            {
+                int bestIndex = 0;
+                int bestError = std::numeric_limits<int>::max();
+
+                for (int entry = 0; entry < 8; entry++)
+                {
+                    const int error = square(palette[entry] - block[index][3]);
+
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = entry;
+                    }
+                }
+
+                indices |= (uint64_t)bestIndex << (index * 3);
+            }
+        }
+
+        return alpha0 | (alpha1 << 8) | (indices << 16);
+    }
+
+    void encodeBlock(PixelFormat format, const Block& block, uint8_t* destination)
+    {
+        switch (format)
+        {
+            case PIXELFORMAT_ETC1_UNORM:
+            case PIXELFORMAT_ETC2_RGB_UNORM:
+                storeBigEndian(encodeEtc1(block), destination);
+                break;
+            case PIXELFORMAT_ETC2_RGBA_UNORM:
+                storeBigEndian(encodeEac(block), destination);
+                storeBigEndian(encodeEtc1(block), destination + 8);
+                break;
+            case PIXELFORMAT_DXT1_UNORM:
+                storeLittleEndian(encodeDxtColor(block), destination);
+                break;
+            case PIXELFORMAT_DXT5_UNORM:
+                storeLittleEndian(encodeDxtAlpha(block), destination);
+                storeLittleEndian(encodeDxtColor(block), destination + 8);
+                break;
+            default:
+                break;
+        }
+    }
+} // namespace
+
+namespace love::BlockCompressor
+{
+    bool IsSupported(PixelFormat format)
+    {
+        switch (format)
+        {
+            case PIXELFORMAT_ETC1_UNORM:
+            case PIXELFORMAT_ETC2_RGB_UNORM:
+            case PIXELFORMAT_ETC2_RGBA_UNORM:
+            case PIXELFORMAT_DXT1_UNORM:
+            case PIXELFORMAT_DXT5_UNORM:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void Compress(PixelFormat format, const uint8_t* source, int width, int height, size_t pitch,
+                  uint8_t* destination)
+    {
+        if (!IsSupported(format))
+        {
+            const char* name = love::GetPixelFormatName(format);
+            throw love::Exception("Cannot compress to the %s pixel format.", name);
+        }
+
+        const int blocksWide = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const int blocksHigh = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+        const size_t blockSize = love::GetPixelFormatBlockSize(format);
+        const size_t rowSize   = blocksWide * blockSize;
+
+        const auto run = [=](int first, int last) {
+            Block block {};
+
+            for (int blockY = first; blockY < last; blockY++)
+            {
+                uint8_t* row = destination + blockY * rowSize;
+
+                for (int blockX = 0; blockX < blocksWide; blockX++)
+                {
+                    loadBlock(source, width, height, pitch, blockX, blockY, block);
+                    encodeBlock(format, block, row + blockX * blockSize);
+                }
+            }
+        };
+
+        love::ParallelFor(blocksHigh, width * height >= THREAD_THRESHOLD, run);
+    }
+} // namespace love::BlockCompressor
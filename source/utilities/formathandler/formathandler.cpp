@@ -2,8 +2,104 @@
 
 #include <utilities/formathandler/formathandler.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+
 using namespace love;
 
+// clang-format off
+static constexpr uint8_t PNG_MAGIC[]  = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+static constexpr uint8_t JPG_MAGIC[]  = { 0xFF, 0xD8, 0xFF };
+static constexpr uint8_t DDS_MAGIC[]  = { 'D', 'D', 'S', ' ' };
+static constexpr uint8_t KTX_MAGIC[]  = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB,
+                                          '\r', '\n', 0x1A, '\n' };
+static constexpr uint8_t PKM_MAGIC[]  = { 'P', 'K', 'M', ' ' };
+static constexpr uint8_t ASTC_MAGIC[] = { 0x13, 0xAB, 0xA1, 0x5C };
+// clang-format on
+
+template<size_t N>
+static bool hasMagic(const uint8_t* data, size_t size, const uint8_t (&magic)[N])
+{
+    return size >= N && std::memcmp(data, magic, N) == 0;
+}
+
+FormatHandler::Signature FormatHandler::Sniff(Data* data)
+{
+    const auto* bytes = (const uint8_t*)data->GetData();
+    const size_t size = data->GetSize();
+
+    if (bytes == nullptr || size == 0)
+        return SIGNATURE_UNKNOWN;
+
+    /* the first byte alone tells every supported signature apart */
+    switch (bytes[0])
+    {
+        case 0x89:
+            return hasMagic(bytes, size, PNG_MAGIC) ? SIGNATURE_PNG : SIGNATURE_UNKNOWN;
+        case 0xFF:
+            return hasMagic(bytes, size, JPG_MAGIC) ? SIGNATURE_JPG : SIGNATURE_UNKNOWN;
+        case 'D':
+            return hasMagic(bytes, size, DDS_MAGIC) ? SIGNATURE_DDS : SIGNATURE_UNKNOWN;
+        case 0xAB:
+            return hasMagic(bytes, size, KTX_MAGIC) ? SIGNATURE_KTX : SIGNATURE_UNKNOWN;
+        case 'P':
+            return hasMagic(bytes, size, PKM_MAGIC) ? SIGNATURE_PKM : SIGNATURE_UNKNOWN;
+        case 0x13:
+            return hasMagic(bytes, size, ASTC_MAGIC) ? SIGNATURE_ASTC : SIGNATURE_UNKNOWN;
+        default:
+            return SIGNATURE_UNKNOWN;
+    }
+}
+
+const char* FormatHandler::GetSignatureName(Signature signature)
+{
+    switch (signature)
+    {
+        case SIGNATURE_PNG:
+            return "PNG";
+        case SIGNATURE_JPG:
+            return "JPEG";
+        case SIGNATURE_DDS:
+            return "DDS";
+        case SIGNATURE_KTX:
+            return "KTX";
+        case SIGNATURE_PKM:
+            return "PKM";
+        case SIGNATURE_ASTC:
+            return "ASTC";
+        default:
+            return "unknown";
+    }
+}
+
+FormatHandler* FormatHandler::Find(const std::list<FormatHandler*>& handlers, Data* data,
+                                   bool compressed)
+{
+    const auto accepts = [&](FormatHandler* handler) {
+        return compressed ? handler->CanParseCompressed(data) : handler->CanDecode(data);
+    };
+
+    const auto signature = FormatHandler::Sniff(data);
+
+    if (signature != SIGNATURE_UNKNOWN)
+    {
+        for (auto* handler : handlers)
+        {
+            if (handler->GetSignature() == signature)
+                return accepts(handler) ? handler : nullptr;
+        }
+    }
+
+    for (auto* handler : handlers)
+    {
+        if (handler->GetSignature() == SIGNATURE_UNKNOWN && accepts(handler))
+            return handler;
+    }
+
+    return nullptr;
+}
+
 bool FormatHandler::CanDecode(Data* data)
 {
     return false;
@@ -14,17 +110,56 @@ FormatHandler::DecodedImage FormatHandler::Decode(Data* /* data */)
     throw love::Exception("Image decoding is not implemented for this format backend.");
 }
 
+bool FormatHandler::DecodeInto(Data* /* data */, const DecodeTarget& /* target */)
+{
+    return false;
+}
+
 bool FormatHandler::CanEncode(PixelFormat /*format*/, EncodedFormat /*encodedFormat*/)
 {
     return false;
 }
 
 FormatHandler::EncodedImage FormatHandler::Encode(const DecodedImage& /*image*/,
-                                                  EncodedFormat /*format*/)
+                                                  EncodedFormat /*format*/,
+                                                  const EncodeSettings& /*settings*/)
 {
     throw love::Exception("Image encoding is not implemented for this format backend.");
 }
 
+bool FormatHandler::EncodeInto(const DecodedImage& /*image*/, EncodedFormat /*format*/,
+                               const EncodeSettings& /*settings*/,
+                               const EncodeTarget& /*target*/)
+{
+    return false;
+}
+
+void FormatHandler::EncodedImage::Reserve(size_t capacity)
+{
+    if (capacity <= this->capacity)
+        return;
+
+    uint8_t* data = new (std::nothrow) uint8_t[capacity];
+
+    if (data == nullptr)
+        throw love::Exception("Out of memory.");
+
+    if (this->size > 0)
+        std::memcpy(data, this->data.get(), this->size);
+
+    this->data.reset(data);
+    this->capacity = capacity;
+}
+
+void FormatHandler::EncodedImage::Append(const uint8_t* bytes, size_t count)
+{
+    if (count > this->capacity - this->size)
+        this->Reserve(std::max(this->capacity + this->capacity / 2, this->size + count));
+
+    std::memcpy(this->data.get() + this->size, bytes, count);
+    this->size += count;
+}
+
 bool FormatHandler::CanParseCompressed(Data* /*data*/)
 {
     return false;
@@ -8,31 +8,29 @@ using namespace love;
 
 bool JPGHandler::CanDecode(Data* data)
 {
-    auto handle = tjInitDecompress();
+    return FormatHandler::Sniff(data) == SIGNATURE_JPG;
+}
 
-    if (!handle)
-        return false;
+JPGHandler::DecodedImage JPGHandler::Decode(Data* data)
+{
+    DecodedImage decoded {};
 
-    int samples = 0;
-    int width   = 0;
-    int height  = 0;
+    this->DecodeInto(data, [&](const DecodedImage& info, size_t&) {
+        decoded.width  = info.width;
+        decoded.height = info.height;
+        decoded.format = info.format;
+        decoded.size   = info.size;
+        decoded.data   = std::make_unique<uint8_t[]>(info.size);
 
-    if (tjDecompressHeader2(handle, (uint8_t*)data->GetData(), data->GetSize(), &width, &height,
-                            &samples) < 0)
-    {
-        tjDestroy(handle);
-        return false;
-    }
+        return decoded.data.get();
+    });
 
-    tjDestroy(handle);
-
-    return true;
+    return decoded;
 }
 
-JPGHandler::DecodedImage JPGHandler::Decode(Data* data)
+bool JPGHandler::DecodeInto(Data* data, const DecodeTarget& target)
 {
     auto handle = tjInitDecompress();
-    DecodedImage decoded {};
 
     if (handle == NULL)
         throw love::Exception("Failed to initialize JPG decompressor.");
@@ -46,18 +44,31 @@ JPGHandler::DecodedImage JPGHandler::Decode(Data* data)
                             &samples) < 0)
     {
         tjDestroy(handle);
-        throw love::Exception("Failed to read JPG header.");
+        throw love::Exception("Could not read JPG header (%s)", tjGetErrorStr());
     }
 
-    decoded.width  = width;
-    decoded.height = height;
-    decoded.format = PIXELFORMAT_RGBA8_UNORM;
-    decoded.size   = width * height * 4;
+    DecodedImage info {};
 
-    decoded.data = std::make_unique<uint8_t[]>(decoded.size);
+    info.width  = width;
+    info.height = height;
+    info.format = PIXELFORMAT_RGBA8_UNORM;
+    info.size   = width * height * 4;
+
+    size_t pitch         = width * 4;
+    uint8_t* destination = nullptr;
+
+    try
+    {
+        destination = target(info, pitch);
+    }
+    catch (...)
+    {
+        tjDestroy(handle);
+        throw;
+    }
 
-    if (tjDecompress2(handle, (uint8_t*)data->GetData(), data->GetSize(), decoded.data.get(), width,
-                      0, height, TJPF_RGBA, TJFLAG_ACCURATEDCT) == -1)
+    if (tjDecompress2(handle, (uint8_t*)data->GetData(), data->GetSize(), destination, width,
+                      (int)pitch, height, TJPF_RGBA, TJFLAG_ACCURATEDCT) == -1)
     {
         tjDestroy(handle);
         throw love::Exception("Could not decode JPG image (%s)", tjGetErrorStr());
@@ -65,5 +76,5 @@ JPGHandler::DecodedImage JPGHandler::Decode(Data* data)
 
     tjDestroy(handle);
 
-    return decoded;
+    return true;
 }
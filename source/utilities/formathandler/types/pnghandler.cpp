@@ -1,34 +1,41 @@
 #include <utilities/formathandler/types/pnghandler.hpp>
 
+#include <common/console.hpp>
 #include <common/exception.hpp>
 
 #include <algorithm>
+#include <exception>
 
 #include <libpng16/png.h>
+#include <zlib.h>
 
 using namespace love;
 
 bool PNGHandler::CanDecode(Data* data)
 {
-    png_image image {};
-    image.version = PNG_IMAGE_VERSION;
-
-    png_image_begin_read_from_memory(&image, data->GetData(), data->GetSize());
-
-    if (PNG_IMAGE_FAILED(image))
-    {
-        png_image_free(&image);
-        return false;
-    }
-
-    png_image_free(&image);
-    return true;
+    /* header errors are reported by Decode, no need to spin up libpng twice */
+    return FormatHandler::Sniff(data) == SIGNATURE_PNG;
 }
 
 PNGHandler::DecodedImage PNGHandler::Decode(Data* data)
 {
     DecodedImage decoded {};
 
+    this->DecodeInto(data, [&](const DecodedImage& info, size_t&) {
+        decoded.width  = info.width;
+        decoded.height = info.height;
+        decoded.format = info.format;
+        decoded.size   = info.size;
+        decoded.data   = std::make_unique<uint8_t[]>(info.size);
+
+        return decoded.data.get();
+    });
+
+    return decoded;
+}
+
+bool PNGHandler::DecodeInto(Data* data, const DecodeTarget& target)
+{
     png_image image {};
     image.version = PNG_IMAGE_VERSION;
 
@@ -42,15 +49,28 @@ PNGHandler::DecodedImage PNGHandler::Decode(Data* data)
 
     image.format = PNG_FORMAT_RGBA;
 
-    decoded.width  = image.width;
-    decoded.height = image.height;
-    decoded.format = PIXELFORMAT_RGBA8_UNORM;
-    decoded.size   = (image.width * image.height) * sizeof(uint32_t);
+    DecodedImage info {};
+
+    info.width  = image.width;
+    info.height = image.height;
+    info.format = PIXELFORMAT_RGBA8_UNORM;
+    info.size   = (image.width * image.height) * sizeof(uint32_t);
+
+    /* one byte per component, so the stride in bytes is also the stride in components */
+    size_t pitch         = PNG_IMAGE_ROW_STRIDE(image);
+    uint8_t* destination = nullptr;
 
-    decoded.data = std::make_unique<uint8_t[]>(decoded.size);
+    try
+    {
+        destination = target(info, pitch);
+    }
+    catch (...)
+    {
+        png_image_free(&image);
+        throw;
+    }
 
-    png_image_finish_read(&image, nullptr, decoded.data.get(), PNG_IMAGE_ROW_STRIDE(image),
-                          nullptr);
+    png_image_finish_read(&image, nullptr, destination, (png_int_32)pitch, nullptr);
 
     if (PNG_IMAGE_FAILED(image))
     {
@@ -60,7 +80,7 @@ PNGHandler::DecodedImage PNGHandler::Decode(Data* data)
 
     png_image_free(&image);
 
-    return decoded;
+    return true;
 }
 
 bool PNGHandler::CanEncode(PixelFormat format, EncodedFormat encodedFormat)
@@ -71,33 +91,118 @@ bool PNGHandler::CanEncode(PixelFormat format, EncodedFormat encodedFormat)
     return encodedFormat == ENCODED_PNG && (isRGBA8 || isRGBA16);
 }
 
-PNGHandler::EncodedImage PNGHandler::Encode(const DecodedImage& decoded, EncodedFormat format)
+namespace
+{
+    /* lives on the frame that calls setjmp, so it survives a longjmp out of libpng */
+    struct WriteTarget
+    {
+        const FormatHandler::EncodeTarget* target;
+        std::exception_ptr error;
+    };
+
+    void writeTarget(png_structp png, png_bytep bytes, png_size_t length)
+    {
+        auto* output = (WriteTarget*)png_get_io_ptr(png);
+
+        try
+        {
+            (*output->target)(bytes, length);
+        }
+        catch (...)
+        {
+            output->error = std::current_exception();
+        }
+
+        /* png_error longjmps, so it can't be called from the catch block */
+        if (output->error)
+            png_error(png, "Could not write the PNG image.");
+    }
+
+    void flushTarget(png_structp)
+    {}
+} // namespace
+
+PNGHandler::EncodedImage PNGHandler::Encode(const DecodedImage& decoded, EncodedFormat format,
+                                            const EncodeSettings& settings)
+{
+    EncodedImage encoded {};
+
+    /* compressed output is usually well under half of the raw size */
+    encoded.Reserve(std::max<size_t>(decoded.size / 2, 0x400));
+
+    this->EncodeInto(decoded, format, settings, [&](const uint8_t* bytes, size_t size) {
+        encoded.Append(bytes, size);
+    });
+
+    return encoded;
+}
+
+bool PNGHandler::EncodeInto(const DecodedImage& decoded, EncodedFormat format,
+                            const EncodeSettings& settings, const EncodeTarget& target)
 {
     if (!this->CanEncode(decoded.format, format))
         throw love::Exception("PNG encoder cannot encode to non-PNG format.");
 
-    EncodedImage encoded {};
+    const bool is16Bit    = (decoded.format == PIXELFORMAT_RGBA16_UNORM);
+    const size_t pitch    = decoded.width * (is16Bit ? 8 : 4);
+    const uint8_t* pixels = decoded.GetPixels();
 
-    png_image image {};
+    if (settings.compressionLevel < -1 || settings.compressionLevel > 9)
+        throw love::Exception("Invalid PNG compression level: %d.", settings.compressionLevel);
 
-    image.width   = decoded.width;
-    image.height  = decoded.height;
-    image.version = PNG_IMAGE_VERSION;
-    image.format  = PNG_FORMAT_RGBA;
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
 
-    bool success = png_image_write_get_memory_size(image, encoded.size, 1, decoded.data.get(),
-                                                   PNG_IMAGE_ROW_STRIDE(image), NULL);
+    if (png == nullptr)
+        throw love::Exception("Could not create PNG encoder.");
 
-    if (!success)
-        throw love::Exception("Failed to get memory size for PNG.");
+    png_infop info = png_create_info_struct(png);
 
-    encoded.data = std::make_unique<uint8_t[]>(encoded.size);
+    if (info == nullptr)
+    {
+        png_destroy_write_struct(&png, nullptr);
+        throw love::Exception("Could not create PNG encoder.");
+    }
 
-    success = png_image_write_to_memory(&image, encoded.data.get(), &encoded.size, 1,
-                                        decoded.data.get(), PNG_IMAGE_ROW_STRIDE(image), NULL);
+    WriteTarget output { &target, nullptr };
 
-    if (!success)
-        throw love::Exception("An error occurred on png_image_write_to_memory!");
+    if (setjmp(png_jmpbuf(png)))
+    {
+        png_destroy_write_struct(&png, &info);
 
-    return encoded;
+        if (output.error)
+            std::rethrow_exception(output.error);
+
+        throw love::Exception("An error occurred while encoding the PNG image.");
+    }
+
+    png_set_write_fn(png, &output, writeTarget, flushTarget);
+
+    png_set_IHDR(png, info, decoded.width, decoded.height, is16Bit ? 16 : 8,
+                 PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+                 PNG_FILTER_TYPE_DEFAULT);
+
+    if (settings.compressionLevel >= 0)
+        png_set_compression_level(png, settings.compressionLevel);
+
+    /* adaptive filtering tries all five filters on every row; Sub and Up do almost as well */
+    if (settings.fastFilters)
+    {
+        png_set_compression_strategy(png, Z_FILTERED);
+        png_set_filter(png, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB | PNG_FILTER_UP);
+    }
+
+    png_write_info(png, info);
+
+    /* PNG stores 16-bit samples big-endian */
+    if (is16Bit && !Console::IsBigEndian())
+        png_set_swap(png);
+
+    /* rows are compressed straight from the source, in a single pass */
+    for (int y = 0; y < decoded.height; y++)
+        png_write_row(png, (png_const_bytep)(pixels + y * pitch));
+
+    png_write_end(png, nullptr);
+    png_destroy_write_struct(&png, &info);
+
+    return true;
 }
@@ -1,3 +1,4 @@
+#include <modules/profiler/profiler.hpp>
 #include <modules/timer_ext.hpp>
 #include <utilities/pool/poolthread.hpp>
 
@@ -32,6 +33,8 @@ void PoolThread::ThreadFunction()
 
         if (this->sources)
         {
+            Profiler::Zone zone("audio.update");
+
             this->sources->Update();
             DSP<Console::Which>::Instance().Update();
         }
@@ -1,6 +1,8 @@
 #include <utilities/threads/thread.hpp>
 #include <utilities/threads/threadable.hpp>
 
+#include <modules/profiler/profiler.hpp>
+
 love::Thread::Thread(Threadable* threadable) : threadable(threadable), running(false), thread {}
 {}
 
@@ -48,6 +50,9 @@ int love::Thread::Runner(void* data)
 {
     love::Thread* self = (love::Thread*)data;
 
+    if (const char* name = self->threadable->GetThreadName())
+        love::Profiler::SetThreadName(name);
+
     self->threadable->ThreadFunction();
     self->running = false;
 
@@ -0,0 +1,165 @@
+#include <common/pixelformat.hpp>
+
+#include <utilities/extrude.hpp>
+#include <utilities/skylinepacker.hpp>
+#include <utilities/swizzle.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+
+using namespace love;
+
+/*
+** Uploads an atlas cell the way a 3DS page does: Texture::LockPixels hands out a linear
+** staging buffer and its pitch, Atlas::Upload fills it with Extrude::WriteCell, and
+** Texture::UnlockPixels tiles the buffer into the page with a pitch of the cell width.
+** Cells are sprite width + 2 * extrude wide, so odd-width sprites catch any pitch mismatch.
+** The SkylinePacker that places the cells is checked on its own: every rectangle it places
+** must lie on the page and keep the padding from the page edges and from every other one.
+*/
+
+static constexpr int PAGE_SIZE = 0x80;
+
+static uint32_t spritePixel(int x, int y)
+{
+    return 0xFF000000u | (uint32_t)y << 8 | (uint32_t)x;
+}
+
+/* the staging buffer and pitch Texture<Console::CTR>::LockPixels returns */
+static std::vector<uint8_t> lockPixels(const Rect& rect, size_t& pitch)
+{
+    const auto format = PIXELFORMAT_RGBA8_UNORM;
+
+    pitch = rect.w * GetPixelFormatBlockSize(format);
+    return std::vector<uint8_t>(GetPixelFormatSliceSize(format, rect.w, rect.h, false));
+}
+
+/* what Atlas::Upload writes for a sprite of spritePixel values */
+static void upload(uint8_t* pixels, size_t pitch, int width, int height, int extrude)
+{
+    std::vector<uint32_t> source(width);
+
+    Extrude::WriteCell(pixels, pitch, width, height, extrude, sizeof(uint32_t), [&](int y) {
+        for (int x = 0; x < width; x++)
+            source[x] = spritePixel(x, y);
+
+        return (const uint8_t*)source.data();
+    });
+}
+
+static void testOddWidthCell(int width, int height, int extrude, int cellX, int cellY)
+{
+    const Rect cell { cellX, cellY, width + extrude * 2, height + extrude * 2 };
+
+    size_t pitch = 0;
+    auto staging = lockPixels(cell, pitch);
+
+    CHECK(pitch * cell.h <= staging.size(), "pitch %zu overruns a %zu byte staging buffer", pitch,
+          staging.size());
+
+    upload(staging.data(), pitch, width, height, extrude);
+
+    /* Texture::UnlockPixels */
+    std::vector<uint32_t> page(PAGE_SIZE * PAGE_SIZE);
+    Swizzle::LinearToTiled((const uint32_t*)staging.data(), cell.w, page.data(), PAGE_SIZE, cell);
+
+    std::vector<uint32_t> linear(PAGE_SIZE * PAGE_SIZE);
+    Swizzle::TiledToLinear(page.data(), PAGE_SIZE, { 0, 0, PAGE_SIZE, PAGE_SIZE }, linear.data(),
+                           PAGE_SIZE);
+
+    for (int y = 0; y < cell.h; y++)
+    {
+        for (int x = 0; x < cell.w; x++)
+        {
+            const int spriteX = std::clamp(x - extrude, 0, width - 1);
+            const int spriteY = std::clamp(y - extrude, 0, height - 1);
+
+            const uint32_t expected = spritePixel(spriteX, spriteY);
+            const uint32_t actual   = linear[(cellY + y) * PAGE_SIZE + cellX + x];
+
+            CHECK(expected == actual,
+                  "%dx%d sprite, extrude %d at (%d, %d): pixel (%d, %d) = %08x, expected %08x",
+                  width, height, extrude, cellX, cellY, x, y, actual, expected);
+        }
+    }
+}
+
+/* packs random rectangles until the page is full; each must be on it and clear of the rest */
+static void testPacker(int size, int padding, std::mt19937& random)
+{
+    SkylinePacker packer(size, size, padding);
+    std::vector<Rect> placed;
+
+    for (int misses = 0; misses < 20;)
+    {
+        const int width  = 1 + random() % (size / 4);
+        const int height = 1 + random() % (size / 4);
+
+        Rect rect {};
+
+        if (!packer.Insert(width, height, rect))
+        {
+            misses++;
+            continue;
+        }
+
+        CHECK(rect.w == width && rect.h == height, "asked for %dx%d, got %dx%d", width, height,
+              rect.w, rect.h);
+
+        CHECK(rect.x >= padding && rect.y >= padding && rect.x + rect.w <= size - padding &&
+                  rect.y + rect.h <= size - padding,
+              "padding %d: %dx%d at (%d, %d) is not within the page", padding, rect.w, rect.h,
+              rect.x, rect.y);
+
+        for (const auto& other : placed)
+        {
+            const bool apart = rect.x + rect.w + padding <= other.x ||
+                               other.x + other.w + padding <= rect.x ||
+                               rect.y + rect.h + padding <= other.y ||
+                               other.y + other.h + padding <= rect.y;
+
+            CHECK(apart, "padding %d: %dx%d at (%d, %d) is too close to %dx%d at (%d, %d)",
+                  padding, rect.w, rect.h, rect.x, rect.y, other.w, other.h, other.x, other.y);
+        }
+
+        placed.push_back(rect);
+    }
+
+    CHECK(packer.GetOccupancy() > 0.5f && packer.GetOccupancy() <= 1.0f,
+          "padding %d: a full %dx%d page is %.2f occupied", padding, size, size,
+          packer.GetOccupancy());
+
+    Rect rect {};
+
+    CHECK(!packer.Insert(0, 1, rect), "an empty rectangle was placed");
+    CHECK(!packer.Insert(size, size, rect), "a rectangle larger than the page was placed");
+
+    packer.Reset();
+
+    CHECK(packer.Insert(size - padding * 2, size - padding * 2, rect) && rect.x == padding &&
+              rect.y == padding,
+          "padding %d: a rectangle filling the page was not placed at its corner", padding);
+}
+
+int main()
+{
+    std::mt19937 random(0xA71A5);
+
+    for (int padding : { 0, 1, 3 })
+    {
+        testPacker(0x80, padding, random);
+        testPacker(0x400, padding, random);
+    }
+
+    testOddWidthCell(13, 9, 1, 0, 0);
+    testOddWidthCell(13, 9, 1, 5, 3);
+    testOddWidthCell(31, 17, 2, 17, 40);
+    testOddWidthCell(1, 1, 0, 63, 63);
+    testOddWidthCell(7, 33, 3, 90, 11);
+
+    return finish();
+}
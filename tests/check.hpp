@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdio>
+
+/*
+** The checks shared by the host tests. A failed CHECK prints its message and is counted, so
+** one run reports every failure; main returns finish() as the exit code ctest looks at.
+*/
+
+static int failures = 0;
+
+#define CHECK(condition, ...)              \
+    do                                     \
+    {                                      \
+        if (!(condition))                  \
+        {                                  \
+            std::printf(__VA_ARGS__);      \
+            std::printf("\n");             \
+            failures++;                    \
+        }                                  \
+    } while (0)
+
+/* prints how many checks failed, if any, and returns the exit code for main */
+static int finish()
+{
+    if (failures == 0)
+        return 0;
+
+    std::printf("%d failures\n", failures);
+    return 1;
+}
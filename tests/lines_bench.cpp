@@ -0,0 +1,229 @@
+#include <utilities/linereader.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace love;
+
+/*
+** Times File:lines over a generated log (100 MB unless a size in MB is given), comparing the
+** LineReader loop Wrap_File::Lines_I now runs against a port of the iterator it replaced,
+** which read 1 KiB at a time and rebuilt its buffer string whenever no newline was left.
+**
+** Both read the file with plain read(2), as PhysFS does for files on disk, and both build a
+** std::string per line where the engine pushes a Lua string, so the difference is in the
+** reading and buffering alone. Not run by ctest.
+*/
+
+static constexpr size_t LINES_BUFFER_SIZE = 0x10000;
+static constexpr size_t OLD_READ_SIZE     = 0x400;
+
+struct PosixFile
+{
+    int descriptor;
+    int64_t size;
+    int64_t position;
+
+    int64_t Read(void* destination, int64_t count)
+    {
+        const ssize_t read = ::read(this->descriptor, destination, count);
+
+        if (read > 0)
+            this->position += read;
+
+        return read;
+    }
+
+    bool IsEOF() const
+    {
+        return this->position >= this->size;
+    }
+
+    int64_t Tell() const
+    {
+        return this->position;
+    }
+
+    bool Seek(int64_t position)
+    {
+        this->position = position;
+        return ::lseek(this->descriptor, position, SEEK_SET) == position;
+    }
+};
+
+/* the lines() iterator as it was, with std::string standing in for the Lua strings */
+static size_t oldLines(PosixFile& file)
+{
+    std::string buffer;
+    size_t offset = 0;
+    size_t total  = 0;
+
+    while (true)
+    {
+        const char* start = buffer.data() + offset;
+        const char* end   = (const char*)std::memchr(start, '\n', buffer.size() - offset);
+
+        while (end == nullptr && !file.IsEOF())
+        {
+            char readBuffer[OLD_READ_SIZE];
+            std::string storage(start, buffer.size() - offset);
+
+            while (!file.IsEOF())
+            {
+                const int64_t read = file.Read(readBuffer, OLD_READ_SIZE);
+
+                if (read < 0)
+                    return total;
+
+                storage.append(readBuffer, read);
+
+                if (std::memchr(readBuffer, '\n', read))
+                    break;
+            }
+
+            /* luaL_pushresult copies the luaL_Buffer into a new string */
+            buffer = std::string(storage);
+            offset = 0;
+            start  = buffer.data();
+            end    = (const char*)std::memchr(start, '\n', buffer.size());
+        }
+
+        if (end == nullptr)
+            end = buffer.data() + buffer.size() - 1;
+
+        offset = end - buffer.data() + 1;
+
+        if (start == buffer.data() + buffer.size())
+            return total;
+
+        if (end >= start && *end == '\n')
+            --end;
+
+        if (end >= start && *end == '\r')
+            --end;
+
+        total += std::string(start, end - start + 1).size();
+    }
+}
+
+/* the loop Wrap_File::Lines_I runs, in string mode */
+static size_t newLines(PosixFile& file)
+{
+    std::vector<char> buffer(LINES_BUFFER_SIZE);
+    LineReader reader { 0, 0, 0, false, false, false };
+
+    std::string spill;
+    size_t total = 0;
+
+    while (true)
+    {
+        char* data    = buffer.data();
+        size_t offset = 0;
+        size_t length = 0;
+
+        switch (reader.Next(data, buffer.size(), offset, length))
+        {
+            case LineReader::STEP_LINE:
+                total += (spill + std::string(data + offset, length)).size();
+                spill.clear();
+                continue;
+            case LineReader::STEP_END:
+                return total + spill.size();
+            case LineReader::STEP_FULL:
+            {
+                const size_t moved = reader.GetSpillSize(data);
+
+                spill.append(data, moved);
+                reader.Discard(data, moved);
+
+                break;
+            }
+            case LineReader::STEP_REFILL:
+                break;
+        }
+
+        if (!reader.Refill(&file, buffer.data(), buffer.size()))
+            return total;
+    }
+}
+
+static std::string writeLog(size_t size)
+{
+    char path[] = "/tmp/lines_bench_XXXXXX";
+    const int descriptor = ::mkstemp(path);
+
+    if (descriptor < 0)
+        return std::string();
+
+    std::string chunk;
+    unsigned seed = 1;
+
+    /* log-like lines of 40 to 200 bytes, some with CRLF endings */
+    while (chunk.size() < 0x100000)
+    {
+        seed = seed * 1103515245 + 12345;
+
+        const size_t length = 40 + (seed >> 16) % 160;
+        chunk += "[12:34:56.789] INFO  subsystem: ";
+        chunk += std::string(length, 'a' + (seed >> 8) % 26);
+        chunk += ((seed >> 4) % 4 == 0) ? "\r\n" : "\n";
+    }
+
+    for (size_t written = 0; written < size; written += chunk.size())
+    {
+        if (::write(descriptor, chunk.data(), chunk.size()) != (ssize_t)chunk.size())
+            break;
+    }
+
+    ::close(descriptor);
+
+    return path;
+}
+
+template<typename F>
+static void run(const char* name, const std::string& path, F lines)
+{
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    PosixFile file { descriptor, ::lseek(descriptor, 0, SEEK_END), 0 };
+
+    file.Seek(0);
+
+    const auto begin   = std::chrono::steady_clock::now();
+    const size_t total = lines(file);
+    const auto end     = std::chrono::steady_clock::now();
+
+    ::close(descriptor);
+
+    const double seconds = std::chrono::duration<double>(end - begin).count();
+    std::printf("%-4s %8.1f ms  %8.1f MB/s  (%zu bytes of lines)\n", name, seconds * 1000.0,
+                file.size / seconds / 1000000.0, total);
+}
+
+int main(int argc, char** argv)
+{
+    const size_t megabytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100;
+    const std::string path = writeLog(megabytes * 1000000);
+
+    if (path.empty())
+    {
+        std::printf("Could not write the log.\n");
+        return 1;
+    }
+
+    for (int pass = 0; pass < 3; pass++)
+    {
+        run("old", path, oldLines);
+        run("new", path, newLines);
+    }
+
+    ::unlink(path.c_str());
+
+    return 0;
+}
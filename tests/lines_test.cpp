@@ -0,0 +1,168 @@
+#include <utilities/linereader.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+
+using namespace love;
+
+/*
+** Splits random CR/LF-heavy input through LineReader with buffers only a few bytes long, the
+** way Wrap_File::Lines_I does in both of its modes, and checks it against a plain splitter.
+*/
+
+/* an in-memory File, whose position "the user" may move between reads */
+struct MemoryFile
+{
+    std::string contents;
+    int64_t position = 0;
+
+    int64_t Read(void* destination, int64_t size)
+    {
+        const int64_t count = std::min<int64_t>(size, this->contents.size() - this->position);
+
+        std::copy_n(this->contents.data() + this->position, count, (char*)destination);
+        this->position += count;
+
+        return count;
+    }
+
+    bool IsEOF() const
+    {
+        return this->position >= (int64_t)this->contents.size();
+    }
+
+    int64_t Tell() const
+    {
+        return this->position;
+    }
+
+    bool Seek(int64_t position)
+    {
+        this->position = position;
+        return true;
+    }
+};
+
+static std::vector<std::string> split(const std::string& contents)
+{
+    std::vector<std::string> lines;
+
+    for (size_t at = 0; at < contents.size();)
+    {
+        size_t newline = contents.find('\n', at);
+
+        if (newline == std::string::npos)
+            newline = contents.size();
+
+        std::string line = contents.substr(at, newline - at);
+
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        lines.push_back(line);
+        at = newline + 1;
+    }
+
+    return lines;
+}
+
+static std::vector<std::string> readLines(MemoryFile& file, size_t size, bool slices,
+                                          bool seekBack)
+{
+    std::vector<std::string> lines;
+    std::vector<char> buffer(size);
+
+    LineReader reader { 0, 0, 0, seekBack, slices, false };
+
+    std::string spill;
+    bool spilled = false;
+
+    while (true)
+    {
+        char* data    = buffer.data();
+        size_t offset = 0;
+        size_t length = 0;
+
+        bool done = false;
+
+        switch (reader.Next(data, buffer.size(), offset, length))
+        {
+            case LineReader::STEP_LINE:
+                lines.push_back(spill + std::string(data + offset, length));
+                spill.clear();
+                spilled = false;
+                continue;
+            case LineReader::STEP_END:
+                if (spilled)
+                    lines.push_back(spill);
+
+                done = true;
+                break;
+            case LineReader::STEP_FULL:
+                if (slices)
+                    buffer.resize(buffer.size() * 2);
+                else
+                {
+                    const size_t moved = reader.GetSpillSize(data);
+
+                    spill.append(data, moved);
+                    reader.Discard(data, moved);
+
+                    spilled = true;
+                }
+                break;
+            case LineReader::STEP_REFILL:
+                break;
+        }
+
+        if (done)
+            break;
+
+        /* code that opened the file itself keeps moving its own position */
+        if (seekBack)
+            file.Seek(file.Tell() / 2);
+
+        if (!reader.Refill(&file, buffer.data(), buffer.size()))
+            break;
+    }
+
+    return lines;
+}
+
+int main()
+{
+    std::mt19937 random(1);
+
+    const char alphabet[] = { 'a', 'b', '\r', '\n' };
+
+    for (int iteration = 0; iteration < 20000; iteration++)
+    {
+        std::string contents(random() % 60, ' ');
+
+        for (char& character : contents)
+            character = alphabet[random() % 4];
+
+        const auto expected = split(contents);
+        const size_t size   = 2 + random() % 8;
+
+        for (bool slices : { false, true })
+        {
+            for (bool seekBack : { false, true })
+            {
+                MemoryFile file { contents };
+                const auto lines = readLines(file, size, slices, seekBack);
+
+                CHECK(lines == expected,
+                      "iteration %d (buffer %zu, slices %d, seekBack %d): %zu lines, expected %zu",
+                      iteration, size, slices, seekBack, lines.size(), expected.size());
+            }
+        }
+    }
+
+    return finish();
+}
@@ -0,0 +1,192 @@
+#include <common/luax.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <string>
+
+using namespace love;
+
+/*
+** Times calls from Lua into C functions that decode their arguments as the hot wrap
+** functions do: once reading every argument by hand, and once through luax::CheckArguments
+** and luax::OptTransform. The wrap functions themselves need a console graphics module,
+** so only their argument decoding is timed; an empty function gives the cost of the call
+** itself. Not run by ctest.
+*/
+
+static volatile float sink = 0.0f;
+
+static int empty(lua_State*)
+{
+    return 0;
+}
+
+/* love.graphics.setColor(r, g, b, a) */
+static int setColorByHand(lua_State* L)
+{
+    const float r = luaL_checknumber(L, 1);
+    const float g = luaL_checknumber(L, 2);
+    const float b = luaL_checknumber(L, 3);
+    const float a = luaL_optnumber(L, 4, 1.0f);
+
+    sink = r + g + b + a;
+    return 0;
+}
+
+static int setColorChecked(lua_State* L)
+{
+    const auto [r, g, b] = luax::CheckArguments<float, float, float>(L, 1);
+    const float a        = luaL_optnumber(L, 4, 1.0f);
+
+    sink = r + g + b + a;
+    return 0;
+}
+
+/* love.graphics.rectangle(mode, x, y, width, height) */
+static int rectangleByHand(lua_State* L)
+{
+    const char* mode   = luaL_checkstring(L, 1);
+    const float x      = luaL_checknumber(L, 2);
+    const float y      = luaL_checknumber(L, 3);
+    const float width  = luaL_checknumber(L, 4);
+    const float height = luaL_checknumber(L, 5);
+
+    if (lua_isnoneornil(L, 6))
+        sink = mode[0] + x + y + width + height;
+
+    return 0;
+}
+
+static int rectangleChecked(lua_State* L)
+{
+    const char* mode = luaL_checkstring(L, 1);
+
+    const auto [x, y, width, height] = luax::CheckArguments<float, float, float, float>(L, 2);
+
+    if (lua_isnoneornil(L, 6))
+        sink = mode[0] + x + y + width + height;
+
+    return 0;
+}
+
+/* the transform of love.graphics.draw, print and SpriteBatch:add */
+static int transformByHand(lua_State* L)
+{
+    const float x  = luaL_optnumber(L, 1, 0.0);
+    const float y  = luaL_optnumber(L, 2, 0.0);
+    const float a  = luaL_optnumber(L, 3, 0.0);
+    const float sx = luaL_optnumber(L, 4, 1.0);
+    const float sy = luaL_optnumber(L, 5, sx);
+    const float ox = luaL_optnumber(L, 6, 0.0);
+    const float oy = luaL_optnumber(L, 7, 0.0);
+    const float kx = luaL_optnumber(L, 8, 0.0);
+    const float ky = luaL_optnumber(L, 9, 0.0);
+
+    sink = x + y + a + sx + sy + ox + oy + kx + ky;
+    return 0;
+}
+
+static int transformOptTransform(lua_State* L)
+{
+    const auto args = luax::OptTransform(L, 1);
+
+    sink = std::accumulate(args.begin(), args.end(), 0.0f);
+    return 0;
+}
+
+/*
+** Calls the global @name @count times with @arguments, five times over, and returns the
+** fastest run in nanoseconds per call.
+*/
+static double timeCalls(lua_State* L, const char* name, const char* arguments, int count)
+{
+    const std::string chunk = "local f = " + std::string(name) + " for i = 1, " +
+                              std::to_string(count) + " do f(" + arguments + ") end";
+
+    if (luaL_loadstring(L, chunk.c_str()) != 0)
+    {
+        std::printf("%s\n", lua_tostring(L, -1));
+        std::exit(1);
+    }
+
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < 5; run++)
+    {
+        lua_pushvalue(L, -1);
+
+        const auto begin = std::chrono::steady_clock::now();
+
+        if (lua_pcall(L, 0, 0, 0) != 0)
+        {
+            std::printf("%s\n", lua_tostring(L, -1));
+            std::exit(1);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count());
+    }
+
+    lua_pop(L, 1);
+
+    return best / count;
+}
+
+int main(int argc, char** argv)
+{
+    const int count = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+
+    lua_register(L, "empty", empty);
+    lua_register(L, "setColorByHand", setColorByHand);
+    lua_register(L, "setColorChecked", setColorChecked);
+    lua_register(L, "rectangleByHand", rectangleByHand);
+    lua_register(L, "rectangleChecked", rectangleChecked);
+    lua_register(L, "transformByHand", transformByHand);
+    lua_register(L, "transformOptTransform", transformOptTransform);
+
+    struct Case
+    {
+        const char* label;
+        const char* byHand;
+        const char* helper;
+        const char* arguments;
+    };
+
+    const Case cases[] = {
+        { "setColor(r, g, b)", "setColorByHand", "setColorChecked", "1, 0.5, 0.25" },
+        { "setColor(r, g, b, a)", "setColorByHand", "setColorChecked", "1, 0.5, 0.25, 1" },
+        { "rectangle(mode, x, y, w, h)", "rectangleByHand", "rectangleChecked",
+          "'fill', i, 2, 3, 4" },
+        { "draw transform (x, y)", "transformByHand", "transformOptTransform", "i, 2" },
+        { "draw transform (x, y, r, s)", "transformByHand", "transformOptTransform",
+          "i, 2, 0.5, 2" },
+        { "draw transform (all nine)", "transformByHand", "transformOptTransform",
+          "i, 2, 0.5, 2, 2, 8, 8, 0, 0" }
+    };
+
+    /* warm up the interpreter and the caches */
+    timeCalls(L, "empty", "", count);
+
+    std::printf("%-30s %8.1f ns/call\n", "empty call", timeCalls(L, "empty", "", count));
+
+    for (const auto& current : cases)
+    {
+        const double call   = timeCalls(L, "empty", current.arguments, count);
+        const double byHand = timeCalls(L, current.byHand, current.arguments, count);
+        const double helper = timeCalls(L, current.helper, current.arguments, count);
+
+        std::printf("%-30s %8.1f ns/call by hand  %8.1f ns/call helper  (%.1f of it the call)\n",
+                    current.label, byHand, helper, call);
+    }
+
+    lua_close(L);
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include <utilities/mipmapper.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace love;
+
+/*
+** Times building a full mip chain for a square RGBA8 texture (2048 unless a size is given)
+** with each Mipmapper filter, in linear and sRGB, both through Downsample and with every
+** level filtered on the calling thread. A plain float box filter that converts sRGB with
+** std::pow per sample is timed alongside as the baseline, and its levels are compared with
+** the box filter's. Not run by ctest.
+*/
+
+using Bytes = std::vector<uint8_t>;
+
+static float toLinear(uint8_t value)
+{
+    const float x = value / 255.0f;
+    return x <= 0.04045f ? x / 12.92f : std::pow((x + 0.055f) / 1.055f, 2.4f);
+}
+
+static uint8_t toSRGB(float value)
+{
+    const float x =
+        value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1 / 2.4f) - 0.055f;
+
+    return (uint8_t)std::lround(std::clamp(x, 0.0f, 1.0f) * 255.0f);
+}
+
+/* the straightforward box filter */
+static void referenceBox(const Bytes& source, int width, int height, Bytes& destination,
+                         bool sRGB)
+{
+    const int destinationWidth  = Mipmapper::GetLevelSize(width);
+    const int destinationHeight = Mipmapper::GetLevelSize(height);
+
+    for (int y = 0; y < destinationHeight; y++)
+    {
+        for (int x = 0; x < destinationWidth; x++)
+        {
+            for (int c = 0; c < Mipmapper::CHANNELS; c++)
+            {
+                float sum = 0.0f;
+
+                for (int dy = 0; dy < 2; dy++)
+                {
+                    for (int dx = 0; dx < 2; dx++)
+                    {
+                        const int sourceX = std::min(x * 2 + dx, width - 1);
+                        const int sourceY = std::min(y * 2 + dy, height - 1);
+                        const uint8_t value =
+                            source[(sourceY * width + sourceX) * Mipmapper::CHANNELS + c];
+
+                        sum += (sRGB && c != 3) ? toLinear(value) : value / 255.0f;
+                    }
+                }
+
+                const float average = sum / 4.0f;
+                const size_t index  = (y * destinationWidth + x) * Mipmapper::CHANNELS + c;
+
+                if (sRGB && c != 3)
+                    destination[index] = toSRGB(average);
+                else
+                    destination[index] = (uint8_t)std::lround(average * 255.0f);
+            }
+        }
+    }
+}
+
+/* Downsample's filters with every row on the calling thread */
+static void singleThreaded(const Bytes& source, int width, int height, Bytes& destination,
+                           Mipmapper::Filter filter, bool sRGB)
+{
+    const int destinationWidth = Mipmapper::GetLevelSize(width);
+
+    const Mipmapper::detail::Job job { source.data(),
+                                       width,
+                                       height,
+                                       (size_t)width * Mipmapper::CHANNELS,
+                                       destination.data(),
+                                       destinationWidth,
+                                       (size_t)destinationWidth * Mipmapper::CHANNELS,
+                                       sRGB };
+
+    const int rows = Mipmapper::GetLevelSize(height);
+
+    if (filter == Mipmapper::FILTER_KAISER)
+        Mipmapper::detail::KaiserRows(job, 0, rows);
+    else
+        Mipmapper::detail::BoxRows(job, 0, rows);
+}
+
+/* builds every level below @base with @step, returning the time it took in milliseconds */
+template<typename F>
+static double chain(const Bytes& base, int size, std::vector<Bytes>& levels, F step)
+{
+    levels.clear();
+
+    /* enough for any int size, so the level being read from never moves */
+    levels.reserve(32);
+
+    const auto begin = std::chrono::steady_clock::now();
+
+    const Bytes* source = &base;
+
+    for (int width = size; width > 1; width = Mipmapper::GetLevelSize(width))
+    {
+        const int next = Mipmapper::GetLevelSize(width);
+
+        levels.emplace_back((size_t)next * next * Mipmapper::CHANNELS);
+        step(*source, width, levels.back());
+
+        source = &levels.back();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+int main(int argc, char** argv)
+{
+    const int size = (argc > 1) ? std::atoi(argv[1]) : 2048;
+
+    /* flat areas of colour with a little noise, as in most game art */
+    Bytes base((size_t)size * size * Mipmapper::CHANNELS);
+    std::mt19937 random(1);
+
+    for (int y = 0; y < size; y++)
+    {
+        for (int x = 0; x < size; x++)
+        {
+            uint8_t* pixel = &base[((size_t)y * size + x) * Mipmapper::CHANNELS];
+
+            for (int c = 0; c < 3; c++)
+                pixel[c] = (uint8_t)(((x / 16) * 37 + (y / 16) * 91 + c * 50) + random() % 8);
+
+            pixel[3] = (x / 32 + y / 32) % 4 == 0 ? 0 : 255;
+        }
+    }
+
+    std::vector<Bytes> levels;
+    std::vector<Bytes> reference;
+
+    for (bool sRGB : { false, true })
+    {
+        const char* space = sRGB ? "srgb" : "linear";
+
+        const double baseline = chain(base, size, reference, [&](auto& source, int w, auto& out) {
+            referenceBox(source, w, w, out, sRGB);
+        });
+
+        std::printf("%-6s reference box        %8.2f ms\n", space, baseline);
+
+        for (auto filter : { Mipmapper::FILTER_BOX, Mipmapper::FILTER_KAISER })
+        {
+            const char* name = (filter == Mipmapper::FILTER_BOX) ? "box" : "kaiser";
+
+            const double single = chain(base, size, levels, [&](auto& source, int w, auto& out) {
+                singleThreaded(source, w, w, out, filter, sRGB);
+            });
+
+            const double threaded = chain(base, size, levels, [&](auto& source, int w, auto& out) {
+                const size_t pitch = Mipmapper::GetLevelSize(w) * Mipmapper::CHANNELS;
+
+                Mipmapper::Downsample(source.data(), w, w, w * Mipmapper::CHANNELS, out.data(),
+                                      pitch, filter, sRGB);
+            });
+
+            std::printf("%-6s %-6s one thread %8.2f ms  Downsample %8.2f ms\n", space, name,
+                        single, threaded);
+
+            if (filter != Mipmapper::FILTER_BOX)
+                continue;
+
+            /*
+            ** Lookup tables and integer rounding may move a value by one, and each level is
+            ** built from the one above, so sRGB levels can drift a little further.
+            */
+            int difference = 0;
+
+            for (size_t level = 0; level < levels.size(); level++)
+            {
+                for (size_t index = 0; index < levels[level].size(); index++)
+                    difference = std::max(difference, std::abs(levels[level][index] -
+                                                                reference[level][index]));
+            }
+
+            std::printf("%-6s box differs from the reference by at most %d\n", space, difference);
+        }
+    }
+
+    return 0;
+}
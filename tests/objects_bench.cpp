@@ -0,0 +1,118 @@
+#include <common/luax.hpp>
+#include <common/object.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace love;
+
+/*
+** Times luax::PushType and luax::CheckType, which every object passed between Lua and C++
+** goes through. Objects are pushed again while their proxies are alive (a body or shape
+** handed to every contact callback), pushed for the first time, and checked against their
+** own type and a parent type. Fetching each proxy through its own registry reference is
+** timed alongside, as the floor for any cache of the proxy on the object. Not run by ctest.
+*/
+
+class Sprite : public Object
+{
+  public:
+    static Type type;
+};
+
+Type Sprite::type("Sprite", &Object::type);
+
+static constexpr int OBJECTS = 0x400;
+
+static volatile size_t sink = 0;
+
+/* runs @step @count times, returning nanoseconds per step */
+template<typename F>
+static double timeSteps(int count, F step)
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    for (int index = 0; index < count; index++)
+        step(index);
+
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / count;
+}
+
+int main(int argc, char** argv)
+{
+    const int count = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+
+    luax::RegisterTypeInit(L, &Sprite::type);
+    lua_pop(L, 1);
+
+    /* the proxies stay alive in a table, as they do while a game holds on to its objects */
+    std::vector<Sprite*> sprites(OBJECTS);
+    std::vector<int> references(OBJECTS);
+
+    lua_createtable(L, OBJECTS, 0);
+
+    for (int index = 0; index < OBJECTS; index++)
+    {
+        sprites[index] = new Sprite();
+
+        luax::PushType(L, sprites[index]);
+
+        lua_pushvalue(L, -1);
+        references[index] = luaL_ref(L, LUA_REGISTRYINDEX);
+
+        lua_rawseti(L, 1, index + 1);
+    }
+
+    const double existing = timeSteps(count, [&](int index) {
+        luax::PushType(L, sprites[index % OBJECTS]);
+        lua_pop(L, 1);
+    });
+
+    const double reference = timeSteps(count, [&](int index) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, references[index % OBJECTS]);
+        lua_pop(L, 1);
+    });
+
+    /* new objects, each released to its proxy as a getter returning a new object does */
+    const int fresh = count / 10;
+
+    const double created = timeSteps(fresh, [&](int) {
+        Sprite* sprite = new Sprite();
+
+        luax::PushType(L, sprite);
+        lua_pop(L, 1);
+
+        sprite->Release();
+    });
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    lua_rawgeti(L, 1, 1);
+
+    const double exact = timeSteps(count, [&](int) {
+        sink = sink + (size_t)luax::CheckType<Sprite>(L, 2);
+    });
+
+    const double parent = timeSteps(count, [&](int) {
+        sink = sink + (size_t)luax::CheckType<Object>(L, 2, Object::type);
+    });
+
+    std::printf("PushType, proxy alive     %8.1f ns\n", existing);
+    std::printf("registry reference        %8.1f ns\n", reference);
+    std::printf("PushType, new proxy       %8.1f ns\n", created);
+    std::printf("CheckType, same type      %8.1f ns\n", exact);
+    std::printf("CheckType, parent type    %8.1f ns\n", parent);
+
+    lua_close(L);
+
+    for (auto* sprite : sprites)
+        sprite->Release();
+
+    return 0;
+}
@@ -0,0 +1,288 @@
+#include <modules/filesystem/physfs/packarchive.hpp>
+
+#include <common/exception.hpp>
+
+#include <physfs.h>
+#include <zlib.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace love::physfs;
+
+/*
+** Times loading a game's assets from a pack made by PackArchive::Create against the same
+** files in a zip, both mounted through PhysFS: mounting, reading every file once, and
+** reading 4 KiB at random offsets in one large file, as a streaming audio decoder seeks.
+** The zip is deflated at zlib's default level, as most zip tools would. Not run by ctest.
+*/
+
+using Bytes = std::vector<uint8_t>;
+
+static std::string root;
+static std::vector<std::pair<std::string, Bytes>> files;
+
+static void writeFile(const std::string& path, const void* data, size_t size)
+{
+    for (size_t slash = path.find('/', root.size() + 1); slash != std::string::npos;
+         slash        = path.find('/', slash + 1))
+    {
+        ::mkdir(path.substr(0, slash).c_str(), 0755);
+    }
+
+    std::ofstream(path, std::ios::binary).write((const char*)data, size);
+}
+
+/* scripts and sprite sheets of 1 to 256 KiB, and 16 MB of 16-bit audio */
+static void generateFiles(size_t count)
+{
+    std::mt19937 random(1);
+
+    for (size_t index = 0; index < count; index++)
+    {
+        Bytes contents(0x400 + random() % 0x40000);
+
+        if (index % 3 == 0)
+        {
+            const std::string line = "local sprite = love.graphics.newImage(\"sprite.png\")\n";
+
+            for (size_t at = 0; at < contents.size(); at++)
+                contents[at] = line[(at + index) % line.size()];
+        }
+        else
+        {
+            /* flat runs of colour with some noise, like pixel art */
+            for (size_t at = 0; at < contents.size(); at++)
+                contents[at] = (uint8_t)((at / 64 * 37) ^ ((random() % 16 == 0) ? random() : 0));
+        }
+
+        const std::string name = "assets/" + std::to_string(index % 16) + "/" +
+                                 std::to_string(index) + ((index % 3 == 0) ? ".lua" : ".bin");
+
+        files.emplace_back(name, std::move(contents));
+    }
+
+    Bytes audio(0x1000000);
+
+    for (size_t at = 0; at + 1 < audio.size(); at += 2)
+    {
+        const auto sample = (int16_t)(std::sin(at * 0.001) * 12000 + (int)(random() % 256) - 128);
+
+        audio[at]     = (uint8_t)sample;
+        audio[at + 1] = (uint8_t)(sample >> 8);
+    }
+
+    files.emplace_back("assets/music.pcm", std::move(audio));
+
+    for (const auto& [name, contents] : files)
+        writeFile(root + "/" + name, contents.data(), contents.size());
+}
+
+static void put16(Bytes& bytes, uint16_t value)
+{
+    bytes.push_back((uint8_t)value);
+    bytes.push_back((uint8_t)(value >> 8));
+}
+
+static void put32(Bytes& bytes, uint32_t value)
+{
+    put16(bytes, (uint16_t)value);
+    put16(bytes, (uint16_t)(value >> 16));
+}
+
+/* a plain deflated zip of the same files, names relative to the assets directory */
+static void writeZip(const std::string& filename)
+{
+    Bytes zip;
+    Bytes directory;
+
+    for (const auto& [path, contents] : files)
+    {
+        const std::string name = path.substr(sizeof("assets/") - 1);
+
+        z_stream stream {};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                     Z_DEFAULT_STRATEGY);
+
+        Bytes packed(deflateBound(&stream, contents.size()));
+
+        stream.next_in   = (Bytef*)contents.data();
+        stream.avail_in  = contents.size();
+        stream.next_out  = packed.data();
+        stream.avail_out = packed.size();
+
+        deflate(&stream, Z_FINISH);
+        packed.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        const uint32_t crc    = crc32(0, contents.data(), contents.size());
+        const uint32_t offset = zip.size();
+
+        const auto putCommon = [&](Bytes& bytes) {
+            put16(bytes, 20);
+            put16(bytes, 0);
+            put16(bytes, 8);
+            put32(bytes, 0);
+            put32(bytes, crc);
+            put32(bytes, packed.size());
+            put32(bytes, contents.size());
+            put16(bytes, name.size());
+            put16(bytes, 0);
+        };
+
+        put32(zip, 0x04034B50);
+        putCommon(zip);
+        zip.insert(zip.end(), name.begin(), name.end());
+        zip.insert(zip.end(), packed.begin(), packed.end());
+
+        put32(directory, 0x02014B50);
+        put16(directory, 20);
+        putCommon(directory);
+        put16(directory, 0);
+        put16(directory, 0);
+        put16(directory, 0);
+        put32(directory, 0);
+        put32(directory, offset);
+        directory.insert(directory.end(), name.begin(), name.end());
+    }
+
+    const uint32_t start = zip.size();
+    zip.insert(zip.end(), directory.begin(), directory.end());
+
+    put32(zip, 0x06054B50);
+    put16(zip, 0);
+    put16(zip, 0);
+    put16(zip, files.size());
+    put16(zip, files.size());
+    put32(zip, directory.size());
+    put32(zip, start);
+    put16(zip, 0);
+
+    writeFile(filename, zip.data(), zip.size());
+}
+
+static double since(std::chrono::steady_clock::time_point begin)
+{
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+static void run(const char* label, const std::string& archive)
+{
+    struct stat info {};
+    ::stat(archive.c_str(), &info);
+
+    auto begin = std::chrono::steady_clock::now();
+
+    if (!PHYSFS_mount(archive.c_str(), "bench", 1))
+    {
+        std::printf("%-4s could not be mounted: %s\n", label,
+                    PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
+        return;
+    }
+
+    const double mount = since(begin);
+
+    begin = std::chrono::steady_clock::now();
+
+    Bytes contents;
+    size_t total = 0;
+
+    for (const auto& [path, expected] : files)
+    {
+        const std::string name = "bench/" + path.substr(sizeof("assets/") - 1);
+        PHYSFS_File* file      = PHYSFS_openRead(name.c_str());
+
+        contents.resize(PHYSFS_fileLength(file));
+        total += PHYSFS_readBytes(file, contents.data(), contents.size());
+
+        PHYSFS_close(file);
+    }
+
+    const double read = since(begin);
+
+    begin = std::chrono::steady_clock::now();
+
+    std::mt19937 random(2);
+    PHYSFS_File* file = PHYSFS_openRead("bench/music.pcm");
+    const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+
+    uint8_t chunk[0x1000];
+
+    for (int seek = 0; seek < 200; seek++)
+    {
+        PHYSFS_seek(file, random() % (length - sizeof(chunk)));
+        PHYSFS_readBytes(file, chunk, sizeof(chunk));
+    }
+
+    PHYSFS_close(file);
+
+    const double seeks = since(begin);
+
+    PHYSFS_unmount(archive.c_str());
+
+    std::printf("%-4s %6.1f MB  mount %7.2f ms  read all %8.1f ms  200 seeks %8.1f ms\n", label,
+                info.st_size / 1000000.0, mount, read, seeks);
+
+    if (total == 0)
+        std::printf("nothing was read\n");
+}
+
+int main(int argc, char** argv)
+{
+    const size_t count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 500;
+
+    char directory[] = "/tmp/pack_bench_XXXXXX";
+
+    if (::mkdtemp(directory) == nullptr)
+    {
+        std::printf("Could not create a directory to pack.\n");
+        return 1;
+    }
+
+    root = directory;
+
+    if (!PHYSFS_init(argv[0]) || !PHYSFS_setWriteDir(directory) ||
+        !PHYSFS_mount(directory, nullptr, 1) || !PackArchive::Register())
+    {
+        std::printf("Could not set up PhysFS: %s\n",
+                    PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
+        return 1;
+    }
+
+    generateFiles(count);
+
+    try
+    {
+        PackArchive::Create("assets", "assets.lpak", {});
+    }
+    catch (love::Exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return 1;
+    }
+
+    writeZip(root + "/assets.zip");
+
+    for (int pass = 0; pass < 3; pass++)
+    {
+        run("pack", root + "/assets.lpak");
+        run("zip", root + "/assets.zip");
+    }
+
+    PHYSFS_deinit();
+
+    const std::string command = "rm -rf " + root;
+    std::system(command.c_str());
+
+    return 0;
+}
@@ -0,0 +1,337 @@
+#include <modules/filesystem/physfs/packarchive.hpp>
+
+#include <common/exception.hpp>
+
+#include <physfs.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "check.hpp"
+
+using namespace love::physfs;
+
+/*
+** Packs a directory of generated files with PackArchive::Create, mounts the pack through
+** PhysFS and reads every file back, whole and from random offsets. Truncated copies of the
+** pack must be refused, and corrupted ones must fail cleanly rather than read out of bounds
+** (build with -fsanitize=address to catch the latter).
+*/
+
+using Bytes = std::vector<uint8_t>;
+
+static std::string root;
+static std::map<std::string, Bytes> files;
+
+static void writeFile(const std::string& path, const Bytes& contents)
+{
+    /* create the parent directories */
+    for (size_t slash = path.find('/', root.size() + 1); slash != std::string::npos;
+         slash        = path.find('/', slash + 1))
+    {
+        ::mkdir(path.substr(0, slash).c_str(), 0755);
+    }
+
+    std::ofstream(path, std::ios::binary).write((const char*)contents.data(), contents.size());
+}
+
+static Bytes readFile(const std::string& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    return Bytes(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+static void generateFiles(std::mt19937& random)
+{
+    Bytes text;
+
+    for (int line = 0; text.size() < 200000; line++)
+    {
+        const std::string row = "line " + std::to_string(line) + ": the quick brown fox\n";
+        text.insert(text.end(), row.begin(), row.end());
+    }
+
+    Bytes noise(5000);
+
+    for (auto& byte : noise)
+        byte = (uint8_t)random();
+
+    /* compressible and incompressible blocks, so some are kept raw inside an LZ4 entry */
+    Bytes mixed(text.begin(), text.begin() + 70000);
+
+    for (int index = 0; index < 80000; index++)
+        mixed.push_back((uint8_t)random());
+
+    files["text.txt"]          = text;
+    files["noise.bin"]         = noise;
+    files["sub/dir/mixed.bin"] = mixed;
+    files["sub/empty.txt"]     = {};
+    files["tiny.txt"]          = { 'h', 'i' };
+
+    for (const auto& [name, contents] : files)
+        writeFile(root + "/assets/" + name, contents);
+}
+
+/* reads @name from the search path in one go; false if it can't be opened or read */
+static bool readAll(const std::string& name, Bytes& contents)
+{
+    PHYSFS_File* file = PHYSFS_openRead(name.c_str());
+
+    if (file == nullptr)
+        return false;
+
+    const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+
+    contents.resize(length > 0 ? length : 0);
+
+    const bool success = length >= 0 && PHYSFS_readBytes(file, contents.data(), length) == length;
+    PHYSFS_close(file);
+
+    return success;
+}
+
+static void testRoundTrip(const PackArchive::Settings& settings, std::mt19937& random)
+{
+    const int count = PackArchive::Create("assets", "assets.lpak", settings);
+    CHECK(count == (int)files.size(), "packed %d files, expected %zu", count, files.size());
+
+    const std::string pack = root + "/assets.lpak";
+
+    if (!PHYSFS_mount(pack.c_str(), "packed", 1))
+    {
+        CHECK(false, "could not mount the pack (block size %u, compress %d, level %d)",
+              settings.blockSize, settings.compress, settings.level);
+        return;
+    }
+
+    for (const auto& [name, expected] : files)
+    {
+        Bytes contents;
+
+        CHECK(readAll("packed/" + name, contents) && contents == expected,
+              "%s did not survive packing (block size %u, compress %d, level %d)", name.c_str(),
+              settings.blockSize, settings.compress, settings.level);
+
+        PHYSFS_File* file = PHYSFS_openRead(("packed/" + name).c_str());
+
+        if (file == nullptr || expected.empty())
+        {
+            if (file != nullptr)
+                PHYSFS_close(file);
+
+            continue;
+        }
+
+        /* reads that start and end anywhere, including across block boundaries */
+        for (int read = 0; read < 50; read++)
+        {
+            const size_t offset = random() % expected.size();
+            const size_t length = std::min<size_t>(random() % 0x3000, expected.size() - offset);
+
+            Bytes slice(length);
+
+            const bool success = PHYSFS_seek(file, offset) &&
+                                 PHYSFS_readBytes(file, slice.data(), length) == (int64_t)length;
+
+            CHECK(success && std::equal(slice.begin(), slice.end(), expected.begin() + offset),
+                  "%s: reading %zu bytes at %zu failed", name.c_str(), length, offset);
+        }
+
+        PHYSFS_close(file);
+    }
+
+    std::vector<std::string> children;
+
+    if (char** items = PHYSFS_enumerateFiles("packed/sub"))
+    {
+        for (char** item = items; *item != nullptr; item++)
+            children.push_back(*item);
+
+        PHYSFS_freeList(items);
+    }
+
+    CHECK((children == std::vector<std::string> { "dir", "empty.txt" }),
+          "packed/sub lists %zu children", children.size());
+
+    CHECK(PHYSFS_openRead("packed/sub") == nullptr, "a directory opened as a file");
+    CHECK(PHYSFS_openRead("packed/missing.txt") == nullptr, "a missing file opened");
+
+    PHYSFS_unmount(pack.c_str());
+}
+
+static void testInvalidSettings()
+{
+    const auto rejects = [](PackArchive::Settings settings) {
+        try
+        {
+            PackArchive::Create("assets", "invalid.lpak", settings);
+        }
+        catch (love::Exception&)
+        {
+            return true;
+        }
+
+        return false;
+    };
+
+    CHECK(rejects({ .level = 0 }), "level 0 was accepted");
+    CHECK(rejects({ .level = 13 }), "level 13 was accepted");
+    CHECK(rejects({ .blockSize = 0x100 }), "a 256 byte block size was accepted");
+    CHECK(rejects({ .alignment = 3 }), "an alignment of 3 was accepted");
+}
+
+static void testTruncated(const Bytes& pack, std::mt19937& random)
+{
+    const std::string path = root + "/cut.lpak";
+
+    std::vector<size_t> lengths = { 0, 4, 0x1F, 0x20, pack.size() / 2, pack.size() - 1 };
+
+    for (int index = 0; index < 100; index++)
+        lengths.push_back(random() % pack.size());
+
+    /* the TOC is at the very end, so any cut loses part of it */
+    for (size_t length : lengths)
+    {
+        writeFile(path, Bytes(pack.begin(), pack.begin() + length));
+
+        const bool mounted = PHYSFS_mount(path.c_str(), "cut", 1);
+        CHECK(!mounted, "a pack cut to %zu of %zu bytes was mounted", length, pack.size());
+
+        if (mounted)
+            PHYSFS_unmount(path.c_str());
+    }
+}
+
+static void testCorrupt(const Bytes& pack, std::mt19937& random)
+{
+    const std::string path = root + "/corrupt.lpak";
+
+    /* a version this build doesn't know */
+    {
+        Bytes copy = pack;
+        copy[4]    = 2;
+
+        writeFile(path, copy);
+
+        const bool mounted = PHYSFS_mount(path.c_str(), "corrupt", 1);
+        CHECK(!mounted, "a pack of version 2 was mounted");
+
+        if (mounted)
+            PHYSFS_unmount(path.c_str());
+    }
+
+    /*
+    ** Bytes flipped in the header, the TOC and the first bytes of each entry, where the seek
+    ** tables are: whatever still mounts must read within its bounds.
+    */
+    const auto read32 = [&](size_t at) {
+        return pack[at] | pack[at + 1] << 8 | pack[at + 2] << 16 | (uint32_t)pack[at + 3] << 24;
+    };
+
+    const size_t count = read32(0x08);
+    const size_t toc   = read32(0x10);
+
+    std::vector<std::pair<size_t, size_t>> regions = { { 0, 0x20 }, { toc, pack.size() } };
+
+    for (size_t index = 0; index < count; index++)
+    {
+        const size_t offset = read32(toc + index * 0x30);
+        regions.emplace_back(offset, std::min<size_t>(offset + 0x40, toc));
+    }
+
+    for (int iteration = 0; iteration < 2000; iteration++)
+    {
+        Bytes copy = pack;
+
+        for (int flip = 1 + random() % 4; flip > 0; flip--)
+        {
+            const auto [start, end] = regions[random() % regions.size()];
+
+            if (start < end)
+                copy[start + random() % (end - start)] ^= (uint8_t)(1 + random() % 0xFF);
+        }
+
+        writeFile(path, copy);
+
+        if (!PHYSFS_mount(path.c_str(), "corrupt", 1))
+            continue;
+
+        for (const auto& [name, expected] : files)
+        {
+            PHYSFS_File* file = PHYSFS_openRead(("corrupt/" + name).c_str());
+
+            if (file == nullptr)
+                continue;
+
+            const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+            PHYSFS_sint64 total        = 0;
+
+            uint8_t chunk[0x1000];
+            PHYSFS_sint64 read = 0;
+
+            while ((read = PHYSFS_readBytes(file, chunk, sizeof(chunk))) > 0)
+                total += read;
+
+            CHECK(total <= length, "%s read %lld bytes of %lld", name.c_str(), (long long)total,
+                  (long long)length);
+
+            PHYSFS_close(file);
+        }
+
+        PHYSFS_unmount(path.c_str());
+    }
+}
+
+int main(int, char** argv)
+{
+    char directory[] = "/tmp/pack_test_XXXXXX";
+
+    if (::mkdtemp(directory) == nullptr)
+    {
+        std::printf("Could not create a directory to pack.\n");
+        return 1;
+    }
+
+    root = directory;
+
+    if (!PHYSFS_init(argv[0]) || !PHYSFS_setWriteDir(directory) ||
+        !PHYSFS_mount(directory, nullptr, 1) || !PackArchive::Register())
+    {
+        std::printf("Could not set up PhysFS: %s\n",
+                    PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
+        return 1;
+    }
+
+    std::mt19937 random(1);
+    generateFiles(random);
+
+    testRoundTrip({}, random);
+    testRoundTrip({ .blockSize = 0x400 }, random);
+    testRoundTrip({ .blockSize = 0x1000, .alignment = 0x1000, .level = 1 }, random);
+    testRoundTrip({ .level = 12 }, random);
+    testRoundTrip({ .compress = false }, random);
+
+    testInvalidSettings();
+
+    PackArchive::Create("assets", "assets.lpak", { .blockSize = 0x400 });
+    const Bytes pack = readFile(root + "/assets.lpak");
+
+    testTruncated(pack, random);
+    testCorrupt(pack, random);
+
+    PHYSFS_deinit();
+
+    const std::string command = "rm -rf " + root;
+    std::system(command.c_str());
+
+    return finish();
+}
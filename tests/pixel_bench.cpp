@@ -0,0 +1,145 @@
+#include <common/pixelformat.hpp>
+
+#include <utilities/pixelconverter.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace love;
+
+/*
+** Times converting a 4096x4096 image (or the size given) between pixel formats with the
+** PixelConverter row kernels, against the per-pixel path ImageData::Paste used before them:
+** each pixel read into a float colour and written back out through a pair of function
+** pointers. Not run by ctest.
+*/
+
+struct FloatColor
+{
+    float r, g, b, a;
+};
+
+using GetFunction = void (*)(const uint8_t* pixel, FloatColor& color);
+using SetFunction = void (*)(const FloatColor& color, uint8_t* pixel);
+
+template<PixelFormat F>
+static void getPixel(const uint8_t* pixel, FloatColor& color)
+{
+    const auto channels = PixelConverter::Load<F>(pixel, 0);
+    const float max     = PixelConverter::CHANNEL_MAX;
+
+    color = { channels.r / max, channels.g / max, channels.b / max, channels.a / max };
+}
+
+template<PixelFormat F>
+static void setPixel(const FloatColor& color, uint8_t* pixel)
+{
+    const auto channel = [](float value) {
+        return (uint32_t)std::lround(std::clamp(value, 0.0f, 1.0f) * PixelConverter::CHANNEL_MAX);
+    };
+
+    PixelConverter::Store<F>(pixel, 0,
+                             { channel(color.r), channel(color.g), channel(color.b),
+                               channel(color.a) });
+}
+
+struct Pair
+{
+    const char* name;
+
+    PixelFormat source;
+    PixelFormat destination;
+
+    GetFunction get;
+    SetFunction set;
+};
+
+template<PixelFormat S, PixelFormat D>
+static constexpr Pair pair(const char* name)
+{
+    return { name, S, D, &getPixel<S>, &setPixel<D> };
+}
+
+static double since(std::chrono::steady_clock::time_point begin)
+{
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+int main(int argc, char** argv)
+{
+    const int size = (argc > 1) ? std::atoi(argv[1]) : 4096;
+
+    // clang-format off
+    const Pair pairs[] = {
+        pair<PIXELFORMAT_RGBA8_UNORM,  PIXELFORMAT_RGBA16_UNORM>("rgba8 -> rgba16"),
+        pair<PIXELFORMAT_RGBA16_UNORM, PIXELFORMAT_RGBA8_UNORM>("rgba16 -> rgba8"),
+        pair<PIXELFORMAT_RGBA8_UNORM,  PIXELFORMAT_RGB565_UNORM>("rgba8 -> rgb565"),
+        pair<PIXELFORMAT_RGB565_UNORM, PIXELFORMAT_RGBA8_UNORM>("rgb565 -> rgba8"),
+        pair<PIXELFORMAT_RGBA8_UNORM,  PIXELFORMAT_RGBA4_UNORM>("rgba8 -> rgba4"),
+        pair<PIXELFORMAT_RGBA4_UNORM,  PIXELFORMAT_RGBA8_UNORM>("rgba4 -> rgba8"),
+        pair<PIXELFORMAT_LA8_UNORM,    PIXELFORMAT_RGBA8_UNORM>("la8 -> rgba8"),
+        pair<PIXELFORMAT_R8_UNORM,     PIXELFORMAT_RGBA8_UNORM>("r8 -> rgba8")
+    };
+    // clang-format on
+
+    std::mt19937 random(1);
+
+    for (const auto& current : pairs)
+    {
+        const size_t sourceSize      = GetPixelFormatBlockSize(current.source);
+        const size_t destinationSize = GetPixelFormatBlockSize(current.destination);
+
+        std::vector<uint8_t> source((size_t)size * size * sourceSize);
+        std::vector<uint8_t> converted((size_t)size * size * destinationSize);
+        std::vector<uint8_t> perPixel(converted.size());
+
+        for (auto& byte : source)
+            byte = (uint8_t)random();
+
+        auto begin = std::chrono::steady_clock::now();
+
+        PixelConverter::Convert(current.source, source.data(), size * sourceSize,
+                                current.destination, converted.data(), size * destinationSize,
+                                size, size);
+
+        const double kernel = since(begin);
+
+        /* through volatile pointers, as ImageData kept them in members the compiler can't see */
+        volatile GetFunction get = current.get;
+        volatile SetFunction set = current.set;
+
+        begin = std::chrono::steady_clock::now();
+
+        for (int y = 0; y < size; y++)
+        {
+            const uint8_t* sourceRow = source.data() + (size_t)y * size * sourceSize;
+            uint8_t* destinationRow  = perPixel.data() + (size_t)y * size * destinationSize;
+
+            for (int x = 0; x < size; x++)
+            {
+                FloatColor color {};
+
+                get(sourceRow + x * sourceSize, color);
+                set(color, destinationRow + x * destinationSize);
+            }
+        }
+
+        const double baseline = since(begin);
+
+        int difference = 0;
+
+        for (size_t index = 0; index < converted.size(); index++)
+            difference = std::max(difference, std::abs(converted[index] - perPixel[index]));
+
+        std::printf("%-16s %8.1f ms  per pixel %8.1f ms  (%4.1fx, bytes differ by %d)\n",
+                    current.name, kernel, baseline, baseline / kernel, difference);
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <utilities/swizzle.hpp>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+
+using namespace love;
+
+/* the per-pixel addressing Color::indexOfTile used before the swizzle engine */
+static constexpr unsigned coordsTable[0x40] = {
+    0,  1,  4,  5,  16, 17, 20, 21, 2,  3,  6,  7,  18, 19, 22, 23, 8,  9,  12, 13, 24, 25,
+    28, 29, 10, 11, 14, 15, 26, 27, 30, 31, 32, 33, 36, 37, 48, 49, 52, 53, 34, 35, 38, 39,
+    50, 51, 54, 55, 40, 41, 44, 45, 56, 57, 60, 61, 42, 43, 46, 47, 58, 59, 62, 63,
+};
+
+static unsigned referenceIndex(unsigned width, unsigned x, unsigned y)
+{
+    return ((width / 8) * (y / 8) + (x / 8)) * 64 + coordsTable[(y % 8) * 8 + (x % 8)];
+}
+
+static void testTileIndex()
+{
+    for (unsigned width = 8; width <= 1024; width *= 2)
+    {
+        for (unsigned y = 0; y < 64; y++)
+        {
+            for (unsigned x = 0; x < width; x++)
+            {
+                const unsigned expected = referenceIndex(width, x, y);
+                const unsigned actual   = Swizzle::TileIndex(width, x, y);
+
+                CHECK(expected == actual, "TileIndex(%u, %u, %u) = %u, expected %u", width, x,
+                      y, actual, expected);
+            }
+        }
+    }
+}
+
+/* linear -> tiled -> linear for rects of every alignment, including odd sizes */
+static void testRoundTrip(std::mt19937& random)
+{
+    for (int iteration = 0; iteration < 500; iteration++)
+    {
+        const unsigned width  = 8u << (random() % 7);
+        const unsigned height = 8u << (random() % 5);
+
+        Rect rect {};
+        rect.x = random() % width;
+        rect.y = random() % height;
+        rect.w = 1 + random() % (width - rect.x);
+        rect.h = 1 + random() % (height - rect.y);
+
+        const size_t pitch = rect.w + random() % 5;
+
+        std::vector<uint32_t> linear(pitch * rect.h);
+        for (auto& value : linear)
+            value = random();
+
+        std::vector<uint32_t> tiled(width * height, 0);
+        Swizzle::LinearToTiled(linear.data(), pitch, tiled.data(), width, rect);
+
+        /* every pixel lands where the per-pixel path would have put it */
+        for (int y = 0; y < rect.h; y++)
+        {
+            for (int x = 0; x < rect.w; x++)
+            {
+                const auto index = referenceIndex(width, rect.x + x, rect.y + y);
+                CHECK(tiled[index] == linear[y * pitch + x],
+                      "LinearToTiled %ux%u rect %d,%d %dx%d: pixel %d,%d misplaced", width,
+                      height, rect.x, rect.y, rect.w, rect.h, x, y);
+            }
+        }
+
+        std::vector<uint32_t> back(pitch * rect.h, 0);
+        Swizzle::TiledToLinear(tiled.data(), width, rect, back.data(), pitch);
+
+        for (int y = 0; y < rect.h; y++)
+        {
+            for (int x = 0; x < rect.w; x++)
+            {
+                CHECK(back[y * pitch + x] == linear[y * pitch + x],
+                      "round trip %ux%u rect %d,%d %dx%d: pixel %d,%d differs", width, height,
+                      rect.x, rect.y, rect.w, rect.h, x, y);
+            }
+        }
+    }
+}
+
+static void testTiledToTiled(std::mt19937& random)
+{
+    for (int iteration = 0; iteration < 200; iteration++)
+    {
+        const unsigned sourceWidth      = 8u << (random() % 6);
+        const unsigned destinationWidth = 8u << (random() % 6);
+        const unsigned height           = 64;
+
+        std::vector<uint16_t> source(sourceWidth * height);
+        for (auto& value : source)
+            value = (uint16_t)random();
+
+        Rect rect {};
+        rect.x = random() % sourceWidth;
+        rect.y = random() % height;
+        rect.w = 1 + random() % std::min(sourceWidth - rect.x, destinationWidth);
+        rect.h = 1 + random() % (height - rect.y);
+
+        const int x = random() % (destinationWidth - rect.w + 1);
+        const int y = random() % (height - rect.h + 1);
+
+        std::vector<uint16_t> destination(destinationWidth * height, 0);
+        Swizzle::TiledToTiled(source.data(), sourceWidth, rect, destination.data(),
+                              destinationWidth, x, y);
+
+        for (int row = 0; row < rect.h; row++)
+        {
+            for (int column = 0; column < rect.w; column++)
+            {
+                const auto from = referenceIndex(sourceWidth, rect.x + column, rect.y + row);
+                const auto to   = referenceIndex(destinationWidth, x + column, y + row);
+
+                CHECK(destination[to] == source[from], "TiledToTiled: pixel %d,%d differs",
+                      column, row);
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 random(0x10E);
+
+    testTileIndex();
+    testRoundTrip(random);
+    testTiledToTiled(random);
+
+    return finish();
+}